@@ -0,0 +1,97 @@
+#include "CSHAllocator.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void* CSH_internal_heap_alloc(void* in_context, size_t in_size)
+{
+    (void)in_context;
+    return malloc(in_size);
+}
+
+static void* CSH_internal_heap_realloc(void* in_context, void* in_ptr, size_t in_oldSize, size_t in_newSize)
+{
+    (void)in_context;
+    (void)in_oldSize;
+    return realloc(in_ptr, in_newSize);
+}
+
+static void CSH_internal_heap_free(void* in_context, void* in_ptr, size_t in_size)
+{
+    (void)in_context;
+    (void)in_size;
+    free(in_ptr);
+}
+
+const S_CSHAllocator CSH_ALLOCATOR_HEAP = {CSH_internal_heap_alloc, CSH_internal_heap_realloc, CSH_internal_heap_free, NULL};
+
+static const S_CSHAllocator* CSH_internal_defaultAllocator = &CSH_ALLOCATOR_HEAP;
+
+void CSH_allocator_set_default(const S_CSHAllocator* in_allocator)
+{
+    CSH_internal_defaultAllocator = (in_allocator != NULL) ? in_allocator : &CSH_ALLOCATOR_HEAP;
+}
+
+const S_CSHAllocator* CSH_allocator_get_default(void)
+{
+    return CSH_internal_defaultAllocator;
+}
+
+const S_CSHAllocator* CSH_allocator_resolve(const S_CSHAllocator* in_allocator)
+{
+    return (in_allocator != NULL) ? in_allocator : CSH_internal_defaultAllocator;
+}
+
+void* CSH_allocator_alloc(const S_CSHAllocator* in_allocator, size_t in_size)
+{
+    in_allocator = CSH_allocator_resolve(in_allocator);
+    return in_allocator->m_alloc(in_allocator->m_context, in_size);
+}
+
+void* CSH_allocator_calloc(const S_CSHAllocator* in_allocator, size_t in_num, size_t in_size)
+{
+    if (in_size != 0 && in_num > (SIZE_MAX / in_size))
+    {
+        return NULL;
+    }
+
+    void* tempPtr = CSH_allocator_alloc(in_allocator, (in_num * in_size));
+    if (tempPtr != NULL)
+    {
+        memset(tempPtr, 0, (in_num * in_size));
+    }
+
+    return tempPtr;
+}
+
+void* CSH_allocator_realloc(const S_CSHAllocator* in_allocator, void* in_ptr, size_t in_oldSize, size_t in_newSize)
+{
+    in_allocator = CSH_allocator_resolve(in_allocator);
+    if (in_ptr == NULL)
+    {
+        return in_allocator->m_alloc(in_allocator->m_context, in_newSize);
+    }
+    if (in_allocator->m_realloc != NULL)
+    {
+        return in_allocator->m_realloc(in_allocator->m_context, in_ptr, in_oldSize, in_newSize);
+    }
+
+    void* tempPtr = in_allocator->m_alloc(in_allocator->m_context, in_newSize);
+    if (tempPtr != NULL)
+    {
+        memcpy(tempPtr, in_ptr, (in_oldSize < in_newSize) ? in_oldSize : in_newSize);
+        in_allocator->m_free(in_allocator->m_context, in_ptr, in_oldSize);
+    }
+
+    return tempPtr;
+}
+
+void CSH_allocator_free(const S_CSHAllocator* in_allocator, void* in_ptr, size_t in_size)
+{
+    if (in_ptr == NULL)
+    {
+        return;
+    }
+
+    in_allocator = CSH_allocator_resolve(in_allocator);
+    in_allocator->m_free(in_allocator->m_context, in_ptr, in_size);
+}
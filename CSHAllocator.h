@@ -0,0 +1,50 @@
+#ifndef CSH_ALLOCATOR_H
+#define CSH_ALLOCATOR_H
+#include <stddef.h>
+#include <stdint.h>
+
+// [ typedef struct S_CSHAllocator ]
+// m_alloc: Allocates in_size bytes, returning NULL on failure. The memory doesn't need to be zeroed.
+// m_realloc: 
+//  Resizes in_ptr from in_oldSize bytes to in_newSize bytes, keeping its contents, returning NULL on failure (in_ptr is then left untouched).
+//  Can be NULL, in which case m_alloc, memcpy and m_free are used instead.
+// m_free: Frees in_ptr, in_size is the size in bytes it was allocated/reallocated with.
+// m_context: User data passed as in_context to each of the functions above.
+typedef struct
+{
+    void* (*m_alloc)(void* in_context, size_t in_size);
+    void* (*m_realloc)(void* in_context, void* in_ptr, size_t in_oldSize, size_t in_newSize);
+    void (*m_free)(void* in_context, void* in_ptr, size_t in_size);
+    void* m_context;
+} S_CSHAllocator;
+
+// [ extern const S_CSHAllocator CSH_ALLOCATOR_HEAP ]
+// Allocator using malloc, realloc and free, which is the default allocator until CSH_allocator_set_default is called.
+
+extern const S_CSHAllocator CSH_ALLOCATOR_HEAP;
+
+// [ void CSH_allocator_set_default(const S_CSHAllocator* in_allocator) ]
+// Sets the allocator used by anything which hasn't had an allocator attached to it, NULL resets it back to CSH_ALLOCATOR_HEAP.
+// Only the pointer is stored, so in_allocator must outlive everything allocated with it.
+// Strings and vectors remember the allocator they first allocated with, so changing the default doesn't affect memory which is already allocated.
+
+// [ const S_CSHAllocator* CSH_allocator_resolve(const S_CSHAllocator* in_allocator) ]
+// Returns in_allocator, or the default allocator if in_allocator is NULL.
+
+void CSH_allocator_set_default(const S_CSHAllocator* in_allocator);
+const S_CSHAllocator* CSH_allocator_get_default(void);
+const S_CSHAllocator* CSH_allocator_resolve(const S_CSHAllocator* in_allocator);
+
+// [ void* CSH_allocator_alloc(const S_CSHAllocator* in_allocator, size_t in_size),
+//   void* CSH_allocator_calloc(const S_CSHAllocator* in_allocator, size_t in_num, size_t in_size),
+//   void* CSH_allocator_realloc(const S_CSHAllocator* in_allocator, void* in_ptr, size_t in_oldSize, size_t in_newSize),
+//   void CSH_allocator_free(const S_CSHAllocator* in_allocator, void* in_ptr, size_t in_size) ]
+// Wrappers which call through in_allocator, falling back to the default allocator if in_allocator is NULL.
+// CSH_allocator_realloc with a NULL in_ptr behaves like CSH_allocator_alloc.
+
+void* CSH_allocator_alloc(const S_CSHAllocator* in_allocator, size_t in_size);
+void* CSH_allocator_calloc(const S_CSHAllocator* in_allocator, size_t in_num, size_t in_size);
+void* CSH_allocator_realloc(const S_CSHAllocator* in_allocator, void* in_ptr, size_t in_oldSize, size_t in_newSize);
+void CSH_allocator_free(const S_CSHAllocator* in_allocator, void* in_ptr, size_t in_size);
+
+#endif
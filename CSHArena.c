@@ -0,0 +1,291 @@
+#ifndef _WIN32
+#define _DEFAULT_SOURCE
+#endif
+#include "CSHArena.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#define CSH_ARENA_ALIGN_UP_MF(in_size) ((((in_size) + (CSH_ARENA_ALIGNMENT_M - 1)) / CSH_ARENA_ALIGNMENT_M) * CSH_ARENA_ALIGNMENT_M)
+
+static void* CSH_internal_arena_alloc(void* in_context, size_t in_size)
+{
+    return CSH_arena_alloc((S_CSHArena*)in_context, in_size);
+}
+
+static void* CSH_internal_arena_realloc(void* in_context, void* in_ptr, size_t in_oldSize, size_t in_newSize)
+{
+    return CSH_arena_realloc((S_CSHArena*)in_context, in_ptr, in_oldSize, in_newSize);
+}
+
+static void CSH_internal_arena_free(void* in_context, void* in_ptr, size_t in_size)
+{
+    CSH_arena_free((S_CSHArena*)in_context, in_ptr, in_size);
+}
+
+// Tries to map in_size bytes backed by huge pages, falling back to normal pages with a huge page hint, returns NULL on failure.
+static void* CSH_internal_arena_map_huge(size_t in_size)
+{
+#ifdef _WIN32
+    SIZE_T largePageSize = GetLargePageMinimum();
+    if (largePageSize != 0 && (in_size % largePageSize) == 0)
+    {
+        void* tempPtr = VirtualAlloc(NULL, in_size, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (tempPtr != NULL)
+        {
+            return tempPtr;
+        }
+    }
+
+    return VirtualAlloc(NULL, in_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+    void* tempPtr = MAP_FAILED;
+    #ifdef MAP_HUGETLB
+        tempPtr = mmap(NULL, in_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    #endif
+    if (tempPtr == MAP_FAILED)
+    {
+        tempPtr = mmap(NULL, in_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (tempPtr == MAP_FAILED)
+        {
+            return NULL;
+        }
+        #ifdef MADV_HUGEPAGE
+            madvise(tempPtr, in_size, MADV_HUGEPAGE);
+        #endif
+    }
+
+    return tempPtr;
+#endif
+}
+
+static void CSH_internal_arena_unmap(void* in_ptr, size_t in_size)
+{
+#ifdef _WIN32
+    (void)in_size;
+    VirtualFree(in_ptr, 0, MEM_RELEASE);
+#else
+    munmap(in_ptr, in_size);
+#endif
+}
+
+// Makes a block with at least in_size usable bytes the current block, reusing a block after the current one when one is big enough.
+static bool CSH_internal_arena_next_block(S_CSHArena* in_arena, size_t in_size)
+{
+    S_CSHArenaBlock* block = (in_arena->m_currentBlock != NULL) ? in_arena->m_currentBlock->m_next : in_arena->m_firstBlock;
+    for (; block != NULL; block = block->m_next)
+    {
+        if ((block->m_size - CSH_ARENA_BLOCK_HEADER_SIZE_M) >= in_size)
+        {
+            break;
+        }
+    }
+
+    if (block == NULL)
+    {
+        size_t blockSize = CSH_ARENA_BLOCK_HEADER_SIZE_M + in_size;
+        if (blockSize < in_arena->m_blockSize)
+        {
+            blockSize = in_arena->m_blockSize;
+        }
+
+        bool mapped = false;
+        if ((in_arena->m_flags & CSHAF_HUGE_PAGES) != 0)
+        {
+            blockSize = ((blockSize + (CSH_ARENA_HUGE_PAGE_SIZE_M - 1)) / CSH_ARENA_HUGE_PAGE_SIZE_M) * CSH_ARENA_HUGE_PAGE_SIZE_M;
+            block = (S_CSHArenaBlock*)CSH_internal_arena_map_huge(blockSize);
+            mapped = (block != NULL);
+        }
+        if (block == NULL)
+        {
+            block = (S_CSHArenaBlock*)CSH_allocator_alloc(&CSH_ALLOCATOR_HEAP, blockSize);
+        }
+        if (block == NULL)
+        {
+            return false;
+        }
+
+        block->m_size = blockSize;
+        block->m_mapped = mapped;
+        // Insert the new block straight after the current one, so blocks which were skipped are still reused after a reset.
+        if (in_arena->m_currentBlock != NULL)
+        {
+            block->m_next = in_arena->m_currentBlock->m_next;
+            in_arena->m_currentBlock->m_next = block;
+        }
+        else
+        {
+            block->m_next = in_arena->m_firstBlock;
+            in_arena->m_firstBlock = block;
+        }
+    }
+
+    in_arena->m_currentBlock = block;
+    in_arena->m_cursor = (uint8_t*)block + CSH_ARENA_BLOCK_HEADER_SIZE_M;
+    in_arena->m_end = (uint8_t*)block + block->m_size;
+    in_arena->m_lastAlloc = NULL;
+
+    return true;
+}
+
+int8_t CSH_arena_init(S_CSHArena* in_arena, size_t in_blockSize, uint32_t in_flags)
+{
+    if (in_arena == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    in_arena->m_firstBlock = NULL;
+    in_arena->m_currentBlock = NULL;
+    in_arena->m_cursor = NULL;
+    in_arena->m_end = NULL;
+    in_arena->m_lastAlloc = NULL;
+    in_arena->m_blockSize = (in_blockSize != 0) ? in_blockSize : CSH_ARENA_DEFAULT_BLOCK_SIZE_M;
+    in_arena->m_flags = in_flags;
+    in_arena->m_allocator.m_alloc = CSH_internal_arena_alloc;
+    in_arena->m_allocator.m_realloc = CSH_internal_arena_realloc;
+    in_arena->m_allocator.m_free = CSH_internal_arena_free;
+    in_arena->m_allocator.m_context = in_arena;
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_arena_reset(S_CSHArena* in_arena)
+{
+    if (in_arena == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    in_arena->m_currentBlock = in_arena->m_firstBlock;
+    in_arena->m_lastAlloc = NULL;
+    if (in_arena->m_firstBlock != NULL)
+    {
+        in_arena->m_cursor = (uint8_t*)in_arena->m_firstBlock + CSH_ARENA_BLOCK_HEADER_SIZE_M;
+        in_arena->m_end = (uint8_t*)in_arena->m_firstBlock + in_arena->m_firstBlock->m_size;
+    }
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_arena_release(S_CSHArena* in_arena)
+{
+    if (in_arena == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    S_CSHArenaBlock* block = in_arena->m_firstBlock;
+    while (block != NULL)
+    {
+        S_CSHArenaBlock* nextBlock = block->m_next;
+        if (block->m_mapped)
+        {
+            CSH_internal_arena_unmap(block, block->m_size);
+        }
+        else
+        {
+            CSH_allocator_free(&CSH_ALLOCATOR_HEAP, block, block->m_size);
+        }
+        block = nextBlock;
+    }
+
+    in_arena->m_firstBlock = NULL;
+    in_arena->m_currentBlock = NULL;
+    in_arena->m_cursor = NULL;
+    in_arena->m_end = NULL;
+    in_arena->m_lastAlloc = NULL;
+
+    return CSHSSC_NONE;
+}
+
+void* CSH_arena_alloc(S_CSHArena* in_arena, size_t in_size)
+{
+    if (in_arena == NULL)
+    {
+        return NULL;
+    }
+
+    size_t size = CSH_ARENA_ALIGN_UP_MF((in_size != 0) ? in_size : 1);
+    if (in_arena->m_currentBlock == NULL || (size_t)(in_arena->m_end - in_arena->m_cursor) < size)
+    {
+        if (!CSH_internal_arena_next_block(in_arena, size))
+        {
+            return NULL;
+        }
+    }
+
+    uint8_t* tempPtr = in_arena->m_cursor;
+    in_arena->m_cursor += size;
+    in_arena->m_lastAlloc = tempPtr;
+
+    return tempPtr;
+}
+
+void* CSH_arena_realloc(S_CSHArena* in_arena, void* in_ptr, size_t in_oldSize, size_t in_newSize)
+{
+    if (in_arena == NULL)
+    {
+        return NULL;
+    }
+    if (in_ptr == NULL)
+    {
+        return CSH_arena_alloc(in_arena, in_newSize);
+    }
+
+    // The most recent allocation can grow or shrink in place, as long as it stays within the current block.
+    if ((uint8_t*)in_ptr == in_arena->m_lastAlloc)
+    {
+        size_t size = CSH_ARENA_ALIGN_UP_MF((in_newSize != 0) ? in_newSize : 1);
+        if ((size_t)(in_arena->m_end - in_arena->m_lastAlloc) >= size)
+        {
+            in_arena->m_cursor = in_arena->m_lastAlloc + size;
+            return in_ptr;
+        }
+    }
+    else if (in_newSize <= in_oldSize)
+    {
+        return in_ptr;
+    }
+
+    void* tempPtr = CSH_arena_alloc(in_arena, in_newSize);
+    if (tempPtr != NULL)
+    {
+        memcpy(tempPtr, in_ptr, (in_oldSize < in_newSize) ? in_oldSize : in_newSize);
+    }
+
+    return tempPtr;
+}
+
+void CSH_arena_free(S_CSHArena* in_arena, void* in_ptr, size_t in_size)
+{
+    (void)in_size;
+    if (in_arena == NULL || in_ptr == NULL)
+    {
+        return;
+    }
+
+    if ((uint8_t*)in_ptr == in_arena->m_lastAlloc)
+    {
+        in_arena->m_cursor = in_arena->m_lastAlloc;
+        in_arena->m_lastAlloc = NULL;
+    }
+}
+
+S_CSHString CSH_arena_string_create_cstr(S_CSHArena* in_arena, CSHConstCharPtr_t in_str, size_t in_maxSize)
+{
+    if (in_arena == NULL || CSH_cstr_size(in_str, in_maxSize) == CSH_STRING_NPOS)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_STR);
+    }
+
+    S_CSHString tempStr = CSH_STRING_ALLOCATOR_M(CSH_ARENA_ALLOCATOR_MF(in_arena));
+    CSH_string_set_max_cstr_size(&tempStr, in_maxSize);
+    CSH_string_assign_cstr(&tempStr, in_str);
+
+    return tempStr;
+}
@@ -0,0 +1,90 @@
+#ifndef CSH_ARENA_H
+#define CSH_ARENA_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "CSHAllocator.h"
+#include "CSHString.h"
+
+// [ #define CSH_ARENA_DEFAULT_BLOCK_SIZE_M ]
+// The size in bytes of each block an arena allocates from, when 0 is passed to CSH_arena_init.
+
+// [ #define CSH_ARENA_HUGE_PAGE_SIZE_M ]
+// The size huge page backed blocks are rounded up to.
+
+#define CSH_ARENA_DEFAULT_BLOCK_SIZE_M (64 * 1024)
+#define CSH_ARENA_HUGE_PAGE_SIZE_M (2 * 1024 * 1024)
+#define CSH_ARENA_ALIGNMENT_M 16
+
+enum E_CSHArenaFlags
+{
+    CSHAF_NONE = 0,
+    CSHAF_HUGE_PAGES = 1 << 0
+};
+
+typedef struct S_CSHArenaBlock
+{
+    struct S_CSHArenaBlock* m_next;
+    size_t m_size;
+    bool m_mapped;
+} S_CSHArenaBlock;
+
+// [ #define CSH_ARENA_BLOCK_HEADER_SIZE_M ]
+// The bytes at the start of each block taken by its header, padded so the first allocation in a block is aligned to CSH_ARENA_ALIGNMENT_M.
+// A block of in_blockSize bytes has in_blockSize - CSH_ARENA_BLOCK_HEADER_SIZE_M usable bytes.
+#define CSH_ARENA_BLOCK_HEADER_SIZE_M (((sizeof(S_CSHArenaBlock) + (CSH_ARENA_ALIGNMENT_M - 1)) / CSH_ARENA_ALIGNMENT_M) * CSH_ARENA_ALIGNMENT_M)
+
+// [ typedef struct S_CSHArena ]
+// A bump allocator for memory which all dies at the same time, such as the strings created while handling a single request.
+// Allocating is a pointer bump, freeing individual allocations does nothing (unless it was the most recent allocation, which is rewound), 
+// and everything is released at once with CSH_arena_reset or CSH_arena_release.
+// m_firstBlock: The first block in the chain of blocks, which are kept for reuse by CSH_arena_reset.
+// m_currentBlock: The block allocations are currently being bumped from.
+// m_cursor: The next free byte in m_currentBlock.
+// m_end: One past the last usable byte in m_currentBlock.
+// m_lastAlloc: The most recent allocation, which can be grown or freed in place.
+// m_blockSize: The size in bytes of each new block, allocations larger than this get a block of their own.
+// m_flags: A combination of E_CSHArenaFlags.
+// m_allocator: The S_CSHAllocator interface to the arena, its m_context points back at the arena, so the arena must not be moved after CSH_arena_init.
+typedef struct
+{
+    S_CSHArenaBlock* m_firstBlock;
+    S_CSHArenaBlock* m_currentBlock;
+    uint8_t* m_cursor;
+    uint8_t* m_end;
+    uint8_t* m_lastAlloc;
+    size_t m_blockSize;
+    uint32_t m_flags;
+    S_CSHAllocator m_allocator;
+} S_CSHArena;
+
+// [ #define CSH_ARENA_ALLOCATOR_MF(in_arena) ]
+// Evaluates to the arena's S_CSHAllocator, for use with CSH_string_set_allocator, CSH_STRING_ALLOCATOR_M, CSH_allocator_set_default, etc.
+#define CSH_ARENA_ALLOCATOR_MF(in_arena) (&(in_arena)->m_allocator)
+
+// [ int8_t CSH_arena_init(S_CSHArena* in_arena, size_t in_blockSize, uint32_t in_flags) ]
+// in_blockSize = the size in bytes of each block, 0 uses CSH_ARENA_DEFAULT_BLOCK_SIZE_M.
+// in_flags = CSHAF_HUGE_PAGES backs blocks with huge pages where the OS supports it, falling back to normal pages otherwise.
+// No memory is allocated until the first allocation.
+
+// [ int8_t CSH_arena_reset(S_CSHArena* in_arena) ]
+// Marks all of the arena's memory as free in O(1), keeping its blocks for reuse. 
+// Every string allocated from the arena is invalidated, and must not be used (or freed) afterwards.
+
+// [ int8_t CSH_arena_release(S_CSHArena* in_arena) ]
+// Returns all of the arena's blocks to the OS, the arena can still be used afterwards.
+
+int8_t CSH_arena_init(S_CSHArena* in_arena, size_t in_blockSize, uint32_t in_flags);
+int8_t CSH_arena_reset(S_CSHArena* in_arena);
+int8_t CSH_arena_release(S_CSHArena* in_arena);
+
+void* CSH_arena_alloc(S_CSHArena* in_arena, size_t in_size);
+void* CSH_arena_realloc(S_CSHArena* in_arena, void* in_ptr, size_t in_oldSize, size_t in_newSize);
+void CSH_arena_free(S_CSHArena* in_arena, void* in_ptr, size_t in_size);
+
+// [ S_CSHString CSH_arena_string_create_cstr(S_CSHArena* in_arena, CSHConstCharPtr_t in_str, size_t in_maxSize) ]
+// Same as CSH_string_create_cstr, except the string (and anything derived from it with substr, create_concat, etc.) is allocated from in_arena.
+
+S_CSHString CSH_arena_string_create_cstr(S_CSHArena* in_arena, CSHConstCharPtr_t in_str, size_t in_maxSize);
+
+#endif
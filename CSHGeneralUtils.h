@@ -45,5 +45,6 @@ inline int CSH_internal_strcpy_s(char* in_dest, size_t in_destSize, const char*
 #define CSH_STRNCMP_MF(in_strOne, in_strTwo, in_num) strncmp(in_strOne, in_strTwo, in_num)
 #define CSH_FOPEN_MF(in_file, in_fileLoc, in_mode) fopen_s(in_file, in_fileLoc, in_mode)
 #define CSH_SPRINTF_MF(in_buffer, in_sizeOfBuffer, ...) sprintf_s(in_buffer, in_sizeOfBuffer, __VA_ARGS__)
+#define CSH_VSNPRINTF_MF(in_buffer, in_sizeOfBuffer, in_format, in_args) vsnprintf(in_buffer, in_sizeOfBuffer, in_format, in_args)
 
 #endif
\ No newline at end of file
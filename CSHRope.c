@@ -0,0 +1,759 @@
+#include "CSHRope.h"
+#include "CSHGeneralUtils.h"
+#include "CSHStringKernels.h"
+#include <string.h>
+
+#define CSH_ROPE_MIN_NODES_M 16
+#define CSH_ROPE_MIN_BUFFER_M 64
+
+static inline size_t CSH_internal_rope_total(const S_CSHRope* in_this, uint32_t in_node)
+{
+    return (in_node != 0) ? in_this->m_nodes[in_node].m_total : 0;
+}
+
+static inline void CSH_internal_rope_update(S_CSHRope* in_this, uint32_t in_node)
+{
+    S_CSHRopeNode* node = &in_this->m_nodes[in_node];
+    node->m_total = CSH_internal_rope_total(in_this, node->m_left) + node->m_length + CSH_internal_rope_total(in_this, node->m_right);
+}
+
+static inline uint32_t CSH_internal_rope_random(S_CSHRope* in_this)
+{
+    uint32_t x = in_this->m_seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    in_this->m_seed = x;
+    return x;
+}
+
+// Makes sure in_count more nodes can be created without m_nodes moving, so node pointers stay valid during a split.
+static int8_t CSH_internal_rope_reserve_nodes(S_CSHRope* in_this, uint32_t in_count)
+{
+    uint32_t freeCount = 0;
+    for (uint32_t node = in_this->m_freeList; node != 0 && freeCount < in_count; node = in_this->m_nodes[node].m_left)
+    {
+        freeCount++;
+    }
+    if ((in_this->m_nodeCount + (in_count - freeCount)) <= in_this->m_nodeCapacity)
+    {
+        return CSHSSC_NONE;
+    }
+
+    uint32_t newCapacity = (in_this->m_nodeCapacity > 0) ? (in_this->m_nodeCapacity * 2) : CSH_ROPE_MIN_NODES_M;
+    S_CSHRopeNode* newNodes = (S_CSHRopeNode*)CSH_allocator_realloc(in_this->m_allocator, in_this->m_nodes, 
+        in_this->m_nodeCapacity * sizeof(S_CSHRopeNode), newCapacity * sizeof(S_CSHRopeNode));
+    if (newNodes == NULL)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
+    in_this->m_nodes = newNodes;
+    in_this->m_nodeCapacity = newCapacity;
+
+    return CSHSSC_NONE;
+}
+
+// Creates a childless node for the piece, CSH_internal_rope_reserve_nodes must have been called first.
+static uint32_t CSH_internal_rope_new_node(S_CSHRope* in_this, size_t in_offset, size_t in_length)
+{
+    uint32_t node = in_this->m_freeList;
+    if (node != 0)
+    {
+        in_this->m_freeList = in_this->m_nodes[node].m_left;
+    }
+    else
+    {
+        node = in_this->m_nodeCount++;
+    }
+
+    S_CSHRopeNode* tempNode = &in_this->m_nodes[node];
+    tempNode->m_left = 0;
+    tempNode->m_right = 0;
+    tempNode->m_priority = CSH_internal_rope_random(in_this);
+    tempNode->m_offset = in_offset;
+    tempNode->m_length = in_length;
+    tempNode->m_total = in_length;
+
+    return node;
+}
+
+static void CSH_internal_rope_free_tree(S_CSHRope* in_this, uint32_t in_node)
+{
+    if (in_node == 0)
+    {
+        return;
+    }
+
+    CSH_internal_rope_free_tree(in_this, in_this->m_nodes[in_node].m_left);
+    CSH_internal_rope_free_tree(in_this, in_this->m_nodes[in_node].m_right);
+    in_this->m_nodes[in_node].m_left = in_this->m_freeList;
+    in_this->m_freeList = in_node;
+}
+
+static uint32_t CSH_internal_rope_merge(S_CSHRope* in_this, uint32_t in_left, uint32_t in_right)
+{
+    if (in_left == 0)
+    {
+        return in_right;
+    }
+    if (in_right == 0)
+    {
+        return in_left;
+    }
+
+    if (in_this->m_nodes[in_left].m_priority > in_this->m_nodes[in_right].m_priority)
+    {
+        in_this->m_nodes[in_left].m_right = CSH_internal_rope_merge(in_this, in_this->m_nodes[in_left].m_right, in_right);
+        CSH_internal_rope_update(in_this, in_left);
+        return in_left;
+    }
+
+    in_this->m_nodes[in_right].m_left = CSH_internal_rope_merge(in_this, in_left, in_this->m_nodes[in_right].m_left);
+    CSH_internal_rope_update(in_this, in_right);
+    return in_right;
+}
+
+// Splits the tree into the first in_pos characters (out_left) and the rest (out_right).
+// A piece straddling in_pos is cut in two, which needs one new node.
+static void CSH_internal_rope_split(S_CSHRope* in_this, uint32_t in_node, size_t in_pos, uint32_t* out_left, uint32_t* out_right)
+{
+    if (in_node == 0)
+    {
+        *out_left = 0;
+        *out_right = 0;
+        return;
+    }
+
+    S_CSHRopeNode* node = &in_this->m_nodes[in_node];
+    size_t leftTotal = CSH_internal_rope_total(in_this, node->m_left);
+    if (in_pos <= leftTotal)
+    {
+        uint32_t tempLeft = 0;
+        CSH_internal_rope_split(in_this, node->m_left, in_pos, out_left, &tempLeft);
+        in_this->m_nodes[in_node].m_left = tempLeft;
+        CSH_internal_rope_update(in_this, in_node);
+        *out_right = in_node;
+        return;
+    }
+    if (in_pos >= (leftTotal + node->m_length))
+    {
+        uint32_t tempRight = 0;
+        CSH_internal_rope_split(in_this, node->m_right, (in_pos - leftTotal - node->m_length), &tempRight, out_right);
+        in_this->m_nodes[in_node].m_right = tempRight;
+        CSH_internal_rope_update(in_this, in_node);
+        *out_left = in_node;
+        return;
+    }
+
+    size_t cut = in_pos - leftTotal;
+    uint32_t tail = CSH_internal_rope_new_node(in_this, (node->m_offset + cut), (node->m_length - cut));
+    node = &in_this->m_nodes[in_node];
+    uint32_t oldRight = node->m_right;
+    node->m_length = cut;
+    node->m_right = 0;
+    CSH_internal_rope_update(in_this, in_node);
+
+    *out_left = in_node;
+    *out_right = CSH_internal_rope_merge(in_this, tail, oldRight);
+}
+
+// Appends the characters to m_buffer, returning their offset, or CSH_STRING_NPOS on failure.
+static size_t CSH_internal_rope_append_buffer(S_CSHRope* in_this, CSHConstCharPtr_t in_str, size_t in_size)
+{
+    // Nothing is copied (m_buffer may still be NULL), the offset is just where the characters would have gone.
+    if (in_size == 0)
+    {
+        return in_this->m_bufferSize;
+    }
+    if ((in_this->m_bufferSize + in_size) > in_this->m_bufferCapacity)
+    {
+        // The source may be a piece of this rope (from CSH_rope_next_piece), which the realloc would move.
+        bool fromBuffer = (in_this->m_buffer != NULL && in_str >= in_this->m_buffer && in_str < (in_this->m_buffer + in_this->m_bufferSize));
+        size_t sourceOffset = fromBuffer ? (size_t)(in_str - in_this->m_buffer) : 0;
+
+        size_t newCapacity = (in_this->m_bufferCapacity > 0) ? in_this->m_bufferCapacity : CSH_ROPE_MIN_BUFFER_M;
+        while (newCapacity < (in_this->m_bufferSize + in_size))
+        {
+            newCapacity *= 2;
+        }
+
+        CSHCharPtr_t newBuffer = (CSHCharPtr_t)CSH_allocator_realloc(in_this->m_allocator, in_this->m_buffer, 
+            in_this->m_bufferCapacity * CSH_CHAR_SIZE, newCapacity * CSH_CHAR_SIZE);
+        if (newBuffer == NULL)
+        {
+            return CSH_STRING_NPOS;
+        }
+        in_this->m_buffer = newBuffer;
+        in_this->m_bufferCapacity = newCapacity;
+        if (fromBuffer)
+        {
+            in_str = in_this->m_buffer + sourceOffset;
+        }
+    }
+
+    size_t offset = in_this->m_bufferSize;
+    memcpy(in_this->m_buffer + offset, in_str, in_size * CSH_CHAR_SIZE);
+    in_this->m_bufferSize += in_size;
+
+    return offset;
+}
+
+int8_t CSH_rope_init(S_CSHRope* in_this, S_CSHStringView in_view, const S_CSHAllocator* in_allocator)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    memset(in_this, 0, sizeof(S_CSHRope));
+    in_this->m_allocator = CSH_allocator_resolve(in_allocator);
+    in_this->m_nodeCount = 1;
+    in_this->m_seed = 0x9E3779B9u;
+    in_this->m_flat = CSH_STRING_ALLOCATOR_M(in_this->m_allocator);
+    in_this->m_maxCstrSize = CSH_STRING_MAX_CSTR_CHAR_COUNT_M + 1;
+
+    if (in_view.m_strPtr != NULL && in_view.m_size > 0)
+    {
+        return CSH_rope_insert(in_this, 0, in_view);
+    }
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_rope_free(S_CSHRope* in_this)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    CSH_allocator_free(in_this->m_allocator, in_this->m_buffer, in_this->m_bufferCapacity * CSH_CHAR_SIZE);
+    CSH_allocator_free(in_this->m_allocator, in_this->m_nodes, in_this->m_nodeCapacity * sizeof(S_CSHRopeNode));
+    CSH_string_free(&in_this->m_flat);
+
+    in_this->m_buffer = NULL;
+    in_this->m_bufferSize = 0;
+    in_this->m_bufferCapacity = 0;
+    in_this->m_nodes = NULL;
+    in_this->m_nodeCount = 1;
+    in_this->m_nodeCapacity = 0;
+    in_this->m_freeList = 0;
+    in_this->m_root = 0;
+    in_this->m_flatValid = false;
+
+    return CSHSSC_NONE;
+}
+
+size_t CSH_rope_size(const S_CSHRope* in_this)
+{
+    if (in_this == NULL)
+    {
+        return 0;
+    }
+
+    return CSH_internal_rope_total(in_this, in_this->m_root);
+}
+
+int8_t CSH_rope_insert(S_CSHRope* in_this, size_t in_pos, S_CSHStringView in_view)
+{
+    if (in_this == NULL || in_view.m_strPtr == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+    if (in_pos > CSH_rope_size(in_this))
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+    if (in_view.m_size == 0)
+    {
+        return CSHSSC_NONE;
+    }
+
+    // One node for the inserted piece, and one for a piece split at in_pos.
+    if (CSH_internal_rope_reserve_nodes(in_this, 2) < 0)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
+    size_t offset = CSH_internal_rope_append_buffer(in_this, in_view.m_strPtr, in_view.m_size);
+    if (offset == CSH_STRING_NPOS)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
+
+    uint32_t left = 0;
+    uint32_t right = 0;
+    CSH_internal_rope_split(in_this, in_this->m_root, in_pos, &left, &right);
+    uint32_t node = CSH_internal_rope_new_node(in_this, offset, in_view.m_size);
+    in_this->m_root = CSH_internal_rope_merge(in_this, CSH_internal_rope_merge(in_this, left, node), right);
+    in_this->m_flatValid = false;
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_rope_insert_cstr(S_CSHRope* in_this, size_t in_pos, CSHConstCharPtr_t in_str)
+{
+    if (in_this == NULL || in_str == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    size_t result = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
+    if (result == in_this->m_maxCstrSize)
+    {
+        return CSHSSC_CSTR_DOESNT_FIT;
+    }
+
+    return CSH_rope_insert(in_this, in_pos, CSH_string_view_buffer(in_str, result));
+}
+
+int8_t CSH_rope_append(S_CSHRope* in_this, S_CSHStringView in_view)
+{
+    return CSH_rope_insert(in_this, CSH_rope_size(in_this), in_view);
+}
+
+int8_t CSH_rope_erase(S_CSHRope* in_this, size_t in_pos, size_t in_len)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    size_t size = CSH_rope_size(in_this);
+    if (in_pos >= size)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+    if (in_len > (size - in_pos))
+    {
+        in_len = size - in_pos;
+    }
+
+    // Each of the two splits can cut a piece in two.
+    if (CSH_internal_rope_reserve_nodes(in_this, 2) < 0)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
+
+    uint32_t left = 0;
+    uint32_t middle = 0;
+    uint32_t right = 0;
+    CSH_internal_rope_split(in_this, in_this->m_root, in_pos, &left, &right);
+    CSH_internal_rope_split(in_this, right, in_len, &middle, &right);
+    CSH_internal_rope_free_tree(in_this, middle);
+    in_this->m_root = CSH_internal_rope_merge(in_this, left, right);
+    in_this->m_flatValid = false;
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_rope_replace(S_CSHRope* in_this, size_t in_pos, size_t in_len, S_CSHStringView in_view)
+{
+    if (in_this == NULL || in_view.m_strPtr == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+    size_t size = CSH_rope_size(in_this);
+    if (in_pos > size)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    // Everything which can fail is done before the rope is changed, so a failed replace leaves the text as it was.
+    // The erase's two splits and the insert's split and new node need at most 4 nodes between them.
+    if (CSH_internal_rope_reserve_nodes(in_this, 4) < 0)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
+    // Copy the replacement in before the erase, in_view may be a piece which the erase removes.
+    size_t offset = 0;
+    if (in_view.m_size > 0)
+    {
+        offset = CSH_internal_rope_append_buffer(in_this, in_view.m_strPtr, in_view.m_size);
+        if (offset == CSH_STRING_NPOS)
+        {
+            return CSHSSC_ALLOC_FAILED;
+        }
+    }
+
+    // Replacing at the end erases nothing, the same as an append. The erase can't fail, its nodes are already reserved.
+    if (in_pos < size)
+    {
+        CSH_rope_erase(in_this, in_pos, in_len);
+    }
+    if (in_view.m_size == 0)
+    {
+        return CSHSSC_NONE;
+    }
+
+    uint32_t left = 0;
+    uint32_t right = 0;
+    CSH_internal_rope_split(in_this, in_this->m_root, in_pos, &left, &right);
+    uint32_t node = CSH_internal_rope_new_node(in_this, offset, in_view.m_size);
+    in_this->m_root = CSH_internal_rope_merge(in_this, CSH_internal_rope_merge(in_this, left, node), right);
+    in_this->m_flatValid = false;
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_rope_replace_cstr(S_CSHRope* in_this, size_t in_pos, size_t in_len, CSHConstCharPtr_t in_str)
+{
+    if (in_this == NULL || in_str == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    size_t result = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
+    if (result == in_this->m_maxCstrSize)
+    {
+        return CSHSSC_CSTR_DOESNT_FIT;
+    }
+
+    return CSH_rope_replace(in_this, in_pos, in_len, CSH_string_view_buffer(in_str, result));
+}
+
+CSHChar_t CSH_rope_char_at(const S_CSHRope* in_this, size_t in_pos)
+{
+    size_t pos = in_pos;
+    S_CSHStringView piece = CSH_rope_next_piece(in_this, &pos);
+    return (piece.m_strPtr != NULL) ? piece.m_strPtr[0] : '\0';
+}
+
+// Returns the whole piece containing in_pos (which must be in range), and the position of its first character in out_start.
+static S_CSHStringView CSH_internal_rope_piece_at(const S_CSHRope* in_this, size_t in_pos, size_t* out_start)
+{
+    size_t pos = in_pos;
+    uint32_t node = in_this->m_root;
+    while (node != 0)
+    {
+        const S_CSHRopeNode* tempNode = &in_this->m_nodes[node];
+        size_t leftTotal = CSH_internal_rope_total(in_this, tempNode->m_left);
+        if (pos < leftTotal)
+        {
+            node = tempNode->m_left;
+        }
+        else if (pos < (leftTotal + tempNode->m_length))
+        {
+            *out_start = in_pos - (pos - leftTotal);
+            return CSH_string_view_buffer(in_this->m_buffer + tempNode->m_offset, tempNode->m_length);
+        }
+        else
+        {
+            pos -= leftTotal + tempNode->m_length;
+            node = tempNode->m_right;
+        }
+    }
+
+    return CSH_STRING_VIEW_DEFAULT_M;
+}
+
+S_CSHStringView CSH_rope_next_piece(const S_CSHRope* in_this, size_t* io_pos)
+{
+    if (in_this == NULL || io_pos == NULL || *io_pos >= CSH_rope_size(in_this))
+    {
+        return CSH_STRING_VIEW_DEFAULT_M;
+    }
+
+    size_t start = 0;
+    S_CSHStringView piece = CSH_internal_rope_piece_at(in_this, *io_pos, &start);
+    size_t skip = *io_pos - start;
+    *io_pos += piece.m_size - skip;
+
+    return CSH_string_view_buffer(piece.m_strPtr + skip, piece.m_size - skip);
+}
+
+S_CSHStringView CSH_rope_flatten(S_CSHRope* in_this)
+{
+    if (in_this == NULL)
+    {
+        return CSH_STRING_VIEW_DEFAULT_M;
+    }
+    if (in_this->m_flatValid)
+    {
+        return CSH_string_view(&in_this->m_flat);
+    }
+
+    size_t size = CSH_rope_size(in_this);
+    // Reserved first so the extend allocates exactly, the pieces are then copied straight into the extension.
+    CSH_string_clear(&in_this->m_flat, false);
+    if (CSH_string_reserve(&in_this->m_flat, size) < 0)
+    {
+        return CSH_STRING_VIEW_DEFAULT_M;
+    }
+    CSHCharPtr_t flatData = CSH_string_extend(&in_this->m_flat, size);
+    if (flatData == NULL)
+    {
+        return CSH_STRING_VIEW_DEFAULT_M;
+    }
+
+    size_t pos = 0;
+    while (pos < size)
+    {
+        size_t start = pos;
+        S_CSHStringView piece = CSH_rope_next_piece(in_this, &pos);
+        memcpy(flatData + start, piece.m_strPtr, piece.m_size * CSH_CHAR_SIZE);
+    }
+    in_this->m_flatValid = true;
+
+    return CSH_string_view(&in_this->m_flat);
+}
+
+S_CSHString CSH_rope_to_string(S_CSHRope* in_this)
+{
+    S_CSHStringView flat = CSH_rope_flatten(in_this);
+    if (flat.m_strPtr == NULL)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_STR);
+    }
+
+    return CSH_string_create_view(flat);
+}
+
+int8_t CSH_rope_compact(S_CSHRope* in_this)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    size_t size = CSH_rope_size(in_this);
+    if (size == in_this->m_bufferSize && in_this->m_root != 0 && in_this->m_nodes[in_this->m_root].m_length == size)
+    {
+        return CSHSSC_NONE;
+    }
+    if (size > 0 && CSH_internal_rope_reserve_nodes(in_this, 1) < 0)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
+
+    size_t newCapacity = (size > CSH_ROPE_MIN_BUFFER_M) ? size : CSH_ROPE_MIN_BUFFER_M;
+    CSHCharPtr_t newBuffer = (CSHCharPtr_t)CSH_allocator_alloc(in_this->m_allocator, newCapacity * CSH_CHAR_SIZE);
+    if (newBuffer == NULL)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
+
+    size_t pos = 0;
+    while (pos < size)
+    {
+        size_t start = pos;
+        S_CSHStringView piece = CSH_rope_next_piece(in_this, &pos);
+        memcpy(newBuffer + start, piece.m_strPtr, piece.m_size * CSH_CHAR_SIZE);
+    }
+
+    CSH_allocator_free(in_this->m_allocator, in_this->m_buffer, in_this->m_bufferCapacity * CSH_CHAR_SIZE);
+    in_this->m_buffer = newBuffer;
+    in_this->m_bufferSize = size;
+    in_this->m_bufferCapacity = newCapacity;
+
+    CSH_internal_rope_free_tree(in_this, in_this->m_root);
+    in_this->m_root = (size > 0) ? CSH_internal_rope_new_node(in_this, 0, size) : 0;
+
+    return CSHSSC_NONE;
+}
+
+// find and rfind search piece by piece, so a large rope isn't copied for every search.
+// A match can straddle pieces, so the in_str.m_size - 1 characters nearest the current piece (from the pieces already searched) are carried 
+// in a window, and the window joined to the start (or end) of the current piece is searched for matches crossing the boundary.
+size_t CSH_rope_find(S_CSHRope* in_this, size_t in_pos, S_CSHStringView in_str)
+{
+    size_t size = CSH_rope_size(in_this);
+    if (in_this == NULL || in_str.m_strPtr == NULL || in_pos >= size)
+    {
+        return CSH_STRING_NPOS;
+    }
+    if (in_str.m_size == 0)
+    {
+        return in_pos;
+    }
+    if (in_str.m_size > (size - in_pos))
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    size_t carrySize = in_str.m_size - 1;
+    CSHCharPtr_t window = NULL;
+    if (carrySize > 0)
+    {
+        window = (CSHCharPtr_t)CSH_allocator_alloc(in_this->m_allocator, 2 * carrySize * CSH_CHAR_SIZE);
+        if (window == NULL)
+        {
+            return CSH_string_view_find(CSH_rope_flatten(in_this), in_pos, in_str);
+        }
+    }
+
+    // window holds the windowSize characters just before the current piece.
+    size_t windowSize = 0;
+    size_t result = CSH_STRING_NPOS;
+    size_t pos = in_pos;
+    while (pos < size)
+    {
+        size_t start = pos;
+        S_CSHStringView piece = CSH_rope_next_piece(in_this, &pos);
+        size_t headSize = (piece.m_size < carrySize) ? piece.m_size : carrySize;
+        if (carrySize > 0)
+        {
+            memcpy(window + windowSize, piece.m_strPtr, headSize * CSH_CHAR_SIZE);
+        }
+
+        // The first match in the joined window, if it starts in the carried characters, comes before anything in the piece.
+        if (windowSize > 0)
+        {
+            size_t found = CSH_kernel_find(window, (windowSize + headSize), in_str.m_strPtr, in_str.m_size);
+            if (found < windowSize)
+            {
+                result = start - windowSize + found;
+                break;
+            }
+        }
+        size_t found = CSH_kernel_find(piece.m_strPtr, piece.m_size, in_str.m_strPtr, in_str.m_size);
+        if (found != CSH_STRING_NPOS)
+        {
+            result = start + found;
+            break;
+        }
+
+        if (carrySize == 0)
+        {
+            continue;
+        }
+        if (piece.m_size >= carrySize)
+        {
+            memcpy(window, (piece.m_strPtr + piece.m_size - carrySize), carrySize * CSH_CHAR_SIZE);
+            windowSize = carrySize;
+        }
+        else
+        {
+            size_t joinedSize = windowSize + headSize;
+            windowSize = (joinedSize < carrySize) ? joinedSize : carrySize;
+            memmove(window, (window + joinedSize - windowSize), windowSize * CSH_CHAR_SIZE);
+        }
+    }
+
+    CSH_allocator_free(in_this->m_allocator, window, 2 * carrySize * CSH_CHAR_SIZE);
+    return result;
+}
+
+size_t CSH_rope_rfind(S_CSHRope* in_this, size_t in_pos, S_CSHStringView in_str)
+{
+    size_t size = CSH_rope_size(in_this);
+    if (in_this == NULL || in_str.m_strPtr == NULL || in_pos >= size)
+    {
+        return CSH_STRING_NPOS;
+    }
+    if (in_str.m_size == 0)
+    {
+        return size;
+    }
+    if (in_str.m_size > (size - in_pos))
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    size_t carrySize = in_str.m_size - 1;
+    CSHCharPtr_t window = NULL;
+    if (carrySize > 0)
+    {
+        window = (CSHCharPtr_t)CSH_allocator_alloc(in_this->m_allocator, 2 * carrySize * CSH_CHAR_SIZE);
+        if (window == NULL)
+        {
+            return CSH_string_view_rfind(CSH_rope_flatten(in_this), in_pos, in_str);
+        }
+    }
+
+    // window + carrySize holds the windowSize characters just after the current piece, so the piece's tail can be copied in front of them.
+    size_t windowSize = 0;
+    size_t result = CSH_STRING_NPOS;
+    size_t end = size;
+    while (end > in_pos)
+    {
+        size_t start = 0;
+        S_CSHStringView piece = CSH_internal_rope_piece_at(in_this, (end - 1), &start);
+        if (start < in_pos)
+        {
+            piece.m_strPtr += in_pos - start;
+            start = in_pos;
+        }
+        piece.m_size = end - start;
+        size_t tailSize = (piece.m_size < carrySize) ? piece.m_size : carrySize;
+        CSHCharPtr_t joined = window + carrySize - tailSize;
+        if (carrySize > 0)
+        {
+            memcpy(joined, (piece.m_strPtr + piece.m_size - tailSize), tailSize * CSH_CHAR_SIZE);
+        }
+
+        // A match crossing into the carried characters starts after anything which fits in the piece, so it's the last match if there is one.
+        if (windowSize > 0)
+        {
+            size_t found = CSH_kernel_rfind(joined, (tailSize + windowSize), in_str.m_strPtr, in_str.m_size);
+            if (found != CSH_STRING_NPOS && (found + in_str.m_size) > tailSize)
+            {
+                result = end - tailSize + found;
+                break;
+            }
+        }
+        size_t found = CSH_kernel_rfind(piece.m_strPtr, piece.m_size, in_str.m_strPtr, in_str.m_size);
+        if (found != CSH_STRING_NPOS)
+        {
+            result = start + found;
+            break;
+        }
+
+        end = start;
+        if (carrySize == 0)
+        {
+            continue;
+        }
+        if (piece.m_size >= carrySize)
+        {
+            memcpy((window + carrySize), piece.m_strPtr, carrySize * CSH_CHAR_SIZE);
+            windowSize = carrySize;
+        }
+        else
+        {
+            size_t joinedSize = tailSize + windowSize;
+            windowSize = (joinedSize < carrySize) ? joinedSize : carrySize;
+            memmove((window + carrySize), joined, windowSize * CSH_CHAR_SIZE);
+        }
+    }
+
+    CSH_allocator_free(in_this->m_allocator, window, 2 * carrySize * CSH_CHAR_SIZE);
+    return result;
+}
+
+int CSH_rope_cmp(const S_CSHRope* in_this, S_CSHStringView in_view)
+{
+    if (in_this == NULL || in_view.m_strPtr == NULL)
+    {
+        return (in_this != NULL) - (in_view.m_strPtr != NULL);
+    }
+
+    size_t size = CSH_rope_size(in_this);
+    size_t pos = 0;
+    while (pos < size && pos < in_view.m_size)
+    {
+        size_t start = pos;
+        S_CSHStringView piece = CSH_rope_next_piece(in_this, &pos);
+        size_t count = (piece.m_size < (in_view.m_size - start)) ? piece.m_size : (in_view.m_size - start);
+        int result = CSH_kernel_compare(piece.m_strPtr, in_view.m_strPtr + start, count);
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    return (size > in_view.m_size) - (size < in_view.m_size);
+}
+
+int8_t CSH_rope_compare(const S_CSHRope* in_this, S_CSHStringView in_view)
+{
+    if (in_this == NULL || in_view.m_strPtr == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+    if (CSH_rope_size(in_this) != in_view.m_size)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    return (CSH_rope_cmp(in_this, in_view) == 0) ? CSHSSC_NONE : CSHSSC_BAD_INPUT_ARG;
+}
@@ -0,0 +1,127 @@
+#ifndef CSH_ROPE_H
+#define CSH_ROPE_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "CSHAllocator.h"
+#include "CSHString.h"
+
+// A piece table string for edit heavy workloads (large documents with many inserts and erases).
+// The text is described by a sequence of pieces, each a range of an append only buffer, and the pieces are kept in a balanced tree (a treap) 
+// keyed by position, so insert, erase and replace are O(log n) in the number of pieces, no matter how large the text is.
+// When a contiguous buffer is needed (handing the text to a S_CSHString API), the rope is flattened lazily and the result is cached until the next edit.
+
+// [ typedef struct S_CSHRopeNode ]
+// m_left, m_right: Child node indices, 0 means none.
+// m_priority: Random heap priority, which keeps the tree balanced in expectation.
+// m_offset, m_length: The piece, as a range of the rope's m_buffer.
+// m_total: The number of characters in this node's subtree.
+typedef struct
+{
+    uint32_t m_left;
+    uint32_t m_right;
+    uint32_t m_priority;
+    size_t m_offset;
+    size_t m_length;
+    size_t m_total;
+} S_CSHRopeNode;
+
+// [ typedef struct S_CSHRope ]
+// m_buffer: Every character added to the rope, appended in order. Erased characters stay in the buffer, only the pieces change, 
+// until CSH_rope_compact copies the live text into a new buffer.
+// m_bufferSize, m_bufferCapacity: The used and allocated size of m_buffer in characters.
+// m_nodes: Node storage, m_nodes[0] is unused so 0 can mean no node.
+// m_nodeCount: The number of node slots handed out so far, including freed ones.
+// m_nodeCapacity: The number of nodes m_nodes has room for.
+// m_freeList: Freed nodes, linked through m_left.
+// m_root: The root of the tree, 0 for an empty rope.
+// m_seed: State of the random number generator used for priorities.
+// m_flat: The cached flattened text, only valid while m_flatValid is true.
+// m_maxCstrSize: The bound used for cstrs, the same as S_CSHString's m_maxCstrSize.
+// m_allocator: The allocator all of the rope's memory comes from.
+typedef struct
+{
+    CSHCharPtr_t m_buffer;
+    size_t m_bufferSize;
+    size_t m_bufferCapacity;
+    S_CSHRopeNode* m_nodes;
+    uint32_t m_nodeCount;
+    uint32_t m_nodeCapacity;
+    uint32_t m_freeList;
+    uint32_t m_root;
+    uint32_t m_seed;
+    S_CSHString m_flat;
+    bool m_flatValid;
+    size_t m_maxCstrSize;
+    const S_CSHAllocator* m_allocator;
+} S_CSHRope;
+
+// [ int8_t CSH_rope_init(S_CSHRope* in_this, S_CSHStringView in_view, const S_CSHAllocator* in_allocator) ]
+// Creates a rope holding a copy of in_view (CSH_STRING_VIEW_DEFAULT_M for an empty rope).
+// in_allocator = NULL uses the default allocator.
+
+// [ int8_t CSH_rope_free(S_CSHRope* in_this) ]
+
+int8_t CSH_rope_init(S_CSHRope* in_this, S_CSHStringView in_view, const S_CSHAllocator* in_allocator);
+int8_t CSH_rope_free(S_CSHRope* in_this);
+
+size_t CSH_rope_size(const S_CSHRope* in_this);
+
+// [ int8_t CSH_rope_insert(S_CSHRope* in_this, size_t in_pos, S_CSHStringView in_view) ]
+// Inserts in_view before the character at in_pos, in_pos == CSH_rope_size appends.
+
+// [ int8_t CSH_rope_erase(S_CSHRope* in_this, size_t in_pos, size_t in_len) ]
+// in_len is clamped to the end of the rope.
+
+// [ int8_t CSH_rope_replace(S_CSHRope* in_this, size_t in_pos, size_t in_len, S_CSHStringView in_view) ]
+// Replaces the in_len characters at in_pos with in_view, which can be a different size. 
+// in_len is clamped to the end of the rope, and in_pos == CSH_rope_size appends.
+
+int8_t CSH_rope_insert(S_CSHRope* in_this, size_t in_pos, S_CSHStringView in_view);
+int8_t CSH_rope_insert_cstr(S_CSHRope* in_this, size_t in_pos, CSHConstCharPtr_t in_str);
+int8_t CSH_rope_append(S_CSHRope* in_this, S_CSHStringView in_view);
+int8_t CSH_rope_erase(S_CSHRope* in_this, size_t in_pos, size_t in_len);
+int8_t CSH_rope_replace(S_CSHRope* in_this, size_t in_pos, size_t in_len, S_CSHStringView in_view);
+int8_t CSH_rope_replace_cstr(S_CSHRope* in_this, size_t in_pos, size_t in_len, CSHConstCharPtr_t in_str);
+
+// [ CSHChar_t CSH_rope_char_at(const S_CSHRope* in_this, size_t in_pos) ]
+// Returns '\0' if in_pos is out of range.
+
+// [ S_CSHStringView CSH_rope_next_piece(const S_CSHRope* in_this, size_t* io_pos) ]
+// Iterates the rope's text without flattening it. Start with *io_pos = 0, each call returns the characters from *io_pos to the end of the piece 
+// containing it, and advances *io_pos past them. An invalid view is returned once the end is reached.
+
+CSHChar_t CSH_rope_char_at(const S_CSHRope* in_this, size_t in_pos);
+S_CSHStringView CSH_rope_next_piece(const S_CSHRope* in_this, size_t* io_pos);
+
+// [ S_CSHStringView CSH_rope_flatten(S_CSHRope* in_this) ]
+// Returns a contiguous view of the whole text, which stays valid until the rope is next changed or freed.
+// The flattened copy is only rebuilt after an edit.
+
+// [ S_CSHString CSH_rope_to_string(S_CSHRope* in_this) ]
+// Returns an owning copy of the text.
+
+S_CSHStringView CSH_rope_flatten(S_CSHRope* in_this);
+S_CSHString CSH_rope_to_string(S_CSHRope* in_this);
+
+// [ int8_t CSH_rope_compact(S_CSHRope* in_this) ]
+// Reclaims the memory of erased and replaced text, which the append only m_buffer otherwise keeps for the rope's lifetime.
+// The live text is copied into a buffer of its own size and becomes a single piece. It's O(n) in the size of the text, 
+// so call it after a batch of edits when m_bufferSize has grown well past CSH_rope_size. Views from CSH_rope_next_piece are invalidated.
+
+int8_t CSH_rope_compact(S_CSHRope* in_this);
+
+// [ size_t CSH_rope_find(S_CSHRope* in_this, size_t in_pos, S_CSHStringView in_str), 
+//   size_t CSH_rope_rfind(S_CSHRope* in_this, size_t in_pos, S_CSHStringView in_str) ]
+// Same as CSH_string_view_find and CSH_string_view_rfind, searching piece by piece without flattening 
+// (matches which cross pieces are found too, using a window of in_str's size). The flattened text is only used if the window can't be allocated.
+
+// [ int8_t CSH_rope_compare(const S_CSHRope* in_this, S_CSHStringView in_view), int CSH_rope_cmp(const S_CSHRope* in_this, S_CSHStringView in_view) ]
+// Same as CSH_string_view_compare and CSH_string_view_cmp, comparing piece by piece without flattening.
+
+size_t CSH_rope_find(S_CSHRope* in_this, size_t in_pos, S_CSHStringView in_str);
+size_t CSH_rope_rfind(S_CSHRope* in_this, size_t in_pos, S_CSHStringView in_str);
+int8_t CSH_rope_compare(const S_CSHRope* in_this, S_CSHStringView in_view);
+int CSH_rope_cmp(const S_CSHRope* in_this, S_CSHStringView in_view);
+
+#endif
@@ -1,5 +1,9 @@
+#ifndef _WIN32
+#define _DEFAULT_SOURCE
+#endif
 #include "CSHString.h"
 #include "CSHGeneralUtils.h"
+#include "CSHStringKernels.h"
 #include <assert.h>
 
 const size_t CSH_STRING_NPOS = ~(0);
@@ -14,6 +18,232 @@ void* CSH_alloca(size_t in_size) { return _alloca(in_size); }
 void* CSH_alloca(size_t in_size) { return alloca(in_size); }
 #endif
 
+// Unmaps the characters of a string with m_status == CSHSSC_USE_MMAP (see CSH_string_map_file in CSHStringFile.h).
+#ifdef _WIN32
+#include <windows.h>
+static void CSH_internal_string_unmap(CSHCharPtr_t in_ptr, size_t in_size) { (void)in_size; UnmapViewOfFile(in_ptr); }
+#else
+#include <sys/mman.h>
+static void CSH_internal_string_unmap(CSHCharPtr_t in_ptr, size_t in_size) { munmap(in_ptr, in_size); }
+#endif
+
+// Returns the allocator of in_this, attaching the default allocator if it doesn't have one yet.
+static const S_CSHAllocator* CSH_internal_string_allocator(S_CSHString* in_this)
+{
+    if (in_this->m_allocator == NULL)
+    {
+        in_this->m_allocator = CSH_allocator_get_default();
+    }
+
+    return in_this->m_allocator;
+}
+
+static uint16_t CSH_internal_growthFactorPercent = CSH_STRING_GROWTH_FACTOR_PERCENT_DEFAULT_M;
+static size_t CSH_internal_growthMinStep = CSH_STRING_GROWTH_MIN_STEP_DEFAULT_M;
+
+// Sets the capacity of in_this to exactly in_capacity characters (including the null terminator).
+// Capacities which fit within CSH_STRING_SSO_CAPACITY_M are stored inline, where the capacity is always the full inline buffer.
+// Heap buffers are resized in place with realloc, buffers which are not owned by the heap (alloca, inline) are copied into a new heap buffer.
+// Any newly gained capacity is zeroed, so the contents are always null terminated the same way calloc did.
+static int8_t CSH_internal_string_set_capacity(S_CSHString* in_this, size_t in_capacity)
+{
+    CSHCharPtr_t oldPtr = CSH_STRING_DATA_MF(in_this);
+    size_t oldCapacity = (oldPtr != NULL) ? CSH_STRING_CAPACITY_MF(in_this) : 0;
+    size_t copySize = (oldCapacity < in_capacity) ? oldCapacity : in_capacity;
+    bool isHeap = CSH_STRING_IS_HEAP_MF(in_this);
+
+    if (CSH_STRING_SSO_ENABLED_M && in_capacity <= CSH_STRING_SSO_CAPACITY_M)
+    {
+        if (in_this->m_status != CSHSSC_USE_SSO)
+        {
+            // The inline buffer overwrites the heap fields, so the old buffer is only freed after its contents are copied in.
+            CSHCharPtr_t oldBlock = isHeap ? (in_this->m_strPtr - in_this->m_frontSlack) : NULL;
+            size_t oldBlockSize = isHeap ? (in_this->m_frontSlack + in_this->m_capacity) : 0;
+            if (copySize > 0)
+            {
+                memmove(in_this->m_ssoBuffer, oldPtr, copySize * CSH_CHAR_SIZE);
+            }
+            memset(in_this->m_ssoBuffer + copySize, 0, (CSH_STRING_SSO_CAPACITY_M - copySize) * CSH_CHAR_SIZE);
+
+            if (isHeap)
+            {
+                CSH_allocator_free(in_this->m_allocator, oldBlock, oldBlockSize * CSH_CHAR_SIZE);
+            }
+            in_this->m_status = CSHSSC_USE_SSO;
+        }
+
+        return CSHSSC_NONE;
+    }
+
+    CSHCharPtr_t newPtr = NULL;
+    const S_CSHAllocator* allocator = CSH_internal_string_allocator(in_this);
+    if (isHeap)
+    {
+        // Shrinking drops the front slack, so the contents are moved back to the start of the buffer first.
+        if (in_this->m_frontSlack > 0 && in_capacity <= oldCapacity)
+        {
+            memmove((in_this->m_strPtr - in_this->m_frontSlack), in_this->m_strPtr, copySize * CSH_CHAR_SIZE);
+            in_this->m_strPtr -= in_this->m_frontSlack;
+            in_this->m_capacity += in_this->m_frontSlack;
+            in_this->m_frontSlack = 0;
+            oldCapacity = in_this->m_capacity;
+        }
+
+        size_t frontSlack = in_this->m_frontSlack;
+        newPtr = (CSHCharPtr_t)CSH_allocator_realloc(allocator, (in_this->m_strPtr - frontSlack), (frontSlack + oldCapacity) * CSH_CHAR_SIZE, (frontSlack + in_capacity) * CSH_CHAR_SIZE);
+        if (newPtr != NULL)
+        {
+            newPtr += frontSlack;
+        }
+    }
+    else
+    {
+        newPtr = (CSHCharPtr_t)CSH_allocator_alloc(allocator, in_capacity * CSH_CHAR_SIZE);
+        if (newPtr != NULL && copySize > 0)
+        {
+            memcpy(newPtr, oldPtr, copySize * CSH_CHAR_SIZE);
+        }
+    }
+
+    #if CSH_STRING_ASSERT_ENABLED_M
+        assert(newPtr != NULL);
+    #endif
+
+    if (newPtr == NULL)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
+    if (!isHeap)
+    {
+        in_this->m_frontSlack = 0;
+    }
+    if (in_this->m_status == CSHSSC_USE_ALLOCA || in_this->m_status == CSHSSC_USE_SSO)
+    {
+        in_this->m_status = CSHSSC_NONE;
+    }
+    if (in_capacity > oldCapacity)
+    {
+        memset(newPtr + oldCapacity, 0, (in_capacity - oldCapacity) * CSH_CHAR_SIZE);
+    }
+
+    in_this->m_strPtr = newPtr;
+    in_this->m_capacity = in_capacity;
+
+    return CSHSSC_NONE;
+}
+
+// Returns how much in_size grows by under the growth policy of in_this, which is at least the minimum step.
+static size_t CSH_internal_string_growth_step(S_CSHString* in_this, size_t in_size)
+{
+    size_t factorPercent = (in_this->m_growthFactorPercent != 0) ? in_this->m_growthFactorPercent : CSH_internal_growthFactorPercent;
+    // Split into the quotient and remainder, so large sizes don't overflow when multiplied by the factor.
+    size_t step = ((in_size / 100) * (factorPercent - 100)) + (((in_size % 100) * (factorPercent - 100)) / 100);
+
+    return (step < CSH_internal_growthMinStep) ? CSH_internal_growthMinStep : step;
+}
+
+// Ensures in_this can hold at least in_nullSize characters (including the null terminator), growing the capacity geometrically.
+static int8_t CSH_internal_string_grow(S_CSHString* in_this, size_t in_nullSize)
+{
+    size_t capacity = CSH_STRING_CAPACITY_MF(in_this);
+    if (CSH_STRING_DATA_MF(in_this) != NULL && capacity >= in_nullSize)
+    {
+        return CSHSSC_ALREADY_RESERVED;
+    }
+
+    size_t newCapacity = capacity + CSH_internal_string_growth_step(in_this, capacity);
+    if (newCapacity < in_nullSize)
+    {
+        newCapacity = in_nullSize;
+    }
+
+    return CSH_internal_string_set_capacity(in_this, newCapacity);
+}
+
+// Moves the contents of in_this into a new heap buffer, with exactly in_frontSlack unused characters in front of them.
+static int8_t CSH_internal_string_set_front_slack(S_CSHString* in_this, size_t in_frontSlack)
+{
+    CSHCharPtr_t oldPtr = CSH_STRING_DATA_MF(in_this);
+    size_t oldCapacity = (oldPtr != NULL) ? CSH_STRING_CAPACITY_MF(in_this) : 0;
+    size_t capacity = (oldCapacity > in_this->m_size) ? oldCapacity : (in_this->m_size + 1);
+    bool isHeap = CSH_STRING_IS_HEAP_MF(in_this);
+
+    CSHCharPtr_t newPtr = (CSHCharPtr_t)CSH_allocator_alloc(CSH_internal_string_allocator(in_this), (in_frontSlack + capacity) * CSH_CHAR_SIZE);
+
+    #if CSH_STRING_ASSERT_ENABLED_M
+        assert(newPtr != NULL);
+    #endif
+
+    if (newPtr == NULL)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
+
+    memset(newPtr, 0, (in_frontSlack + capacity) * CSH_CHAR_SIZE);
+    if (oldCapacity > 0)
+    {
+        memcpy(newPtr + in_frontSlack, oldPtr, oldCapacity * CSH_CHAR_SIZE);
+    }
+    if (isHeap)
+    {
+        CSH_allocator_free(in_this->m_allocator, (in_this->m_strPtr - in_this->m_frontSlack), (in_this->m_frontSlack + in_this->m_capacity) * CSH_CHAR_SIZE);
+    }
+    if (in_this->m_status == CSHSSC_USE_ALLOCA || in_this->m_status == CSHSSC_USE_SSO)
+    {
+        in_this->m_status = CSHSSC_NONE;
+    }
+
+    in_this->m_strPtr = newPtr + in_frontSlack;
+    in_this->m_capacity = capacity;
+    in_this->m_frontSlack = in_frontSlack;
+
+    return CSHSSC_NONE;
+}
+
+// Prepends the in_size characters of in_str, taking the room from the front slack so the contents don't move.
+// When the slack runs out, the contents move once into a buffer with slack proportional to the size, so prepending is amortized O(1) per character.
+static int8_t CSH_internal_string_prepend(S_CSHString* in_this, CSHConstCharPtr_t in_str, size_t in_size)
+{
+    if (in_size == 0)
+    {
+        return CSHSSC_NONE;
+    }
+
+    if (!CSH_STRING_IS_HEAP_MF(in_this) || in_this->m_frontSlack < in_size)
+    {
+        // Small strings stay inline, where shifting the contents is cheaper than moving to the heap.
+        if (CSH_STRING_SSO_ENABLED_M && (in_this->m_size + in_size + 1) <= CSH_STRING_SSO_CAPACITY_M)
+        {
+            return CSH_string_splice(in_this, 0, 0, in_str, in_size);
+        }
+
+        // in_str may point into in_this, which moves to the new buffer.
+        CSHCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+        bool aliased = (thisData != NULL && in_str >= thisData && in_str < (thisData + in_this->m_size));
+        size_t strOffset = aliased ? (size_t)(in_str - thisData) : 0;
+
+        size_t newSize = in_this->m_size + in_size;
+        if (CSH_internal_string_set_front_slack(in_this, (in_size + CSH_internal_string_growth_step(in_this, newSize))) < 0)
+        {
+            return CSHSSC_ALLOC_FAILED;
+        }
+        if (aliased)
+        {
+            in_str = in_this->m_strPtr + strOffset;
+        }
+    }
+
+    in_this->m_strPtr -= in_size;
+    in_this->m_frontSlack -= in_size;
+    in_this->m_capacity += in_size;
+    memmove(in_this->m_strPtr, in_str, in_size * CSH_CHAR_SIZE);
+
+    in_this->m_size += in_size;
+    in_this->m_nullSize = in_this->m_size + 1;
+
+    return CSHSSC_NONE;
+}
+
 S_CSHString CSH_string_create_cstr(CSHConstCharPtr_t in_str, size_t in_maxSize)
 {
     size_t result = CSH_STRNLEN_MF(in_str, (in_maxSize + 1));
@@ -27,15 +257,13 @@ S_CSHString CSH_string_create_cstr(CSHConstCharPtr_t in_str, size_t in_maxSize)
     tempStr.m_status = CSHSSC_NONE; 
     tempStr.m_size = result;
     tempStr.m_nullSize = result + 1;
-    tempStr.m_capacity = tempStr.m_nullSize;
     tempStr.m_maxCstrSize = (in_maxSize + 1); // We do the inputted max cstr size + 1, to account for the null terminating character.
-    tempStr.m_strPtr = (CSHCharPtr_t)calloc(tempStr.m_capacity,CSH_CHAR_SIZE);
-
-    #if CSH_STRING_ASSERT_ENABLED_M
-        assert(tempStr.m_strPtr != NULL);
-    #endif
+    if (CSH_internal_string_set_capacity(&tempStr, tempStr.m_nullSize) < 0)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_ALLOC_FAILED);
+    }
     
-    CSH_STRCPY_MF(tempStr.m_strPtr, tempStr.m_capacity, in_str);
+    CSH_STRCPY_MF(CSH_STRING_DATA_MF(&tempStr), CSH_STRING_CAPACITY_MF(&tempStr), in_str);
     return tempStr;   
 }
 
@@ -46,26 +274,29 @@ S_CSHString CSH_string_create(S_CSHString* in_str)
         return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_STR);
     }
 
-    S_CSHString tempStr = CSH_STRING_DEFAULT_M;
-
-    if (in_str->m_capacity != 0)
+    S_CSHString tempStr = CSH_STRING_ALLOCATOR_M(in_str->m_allocator);
+    // The copy always owns its own memory, so ownership statuses of in_str aren't carried over.
+    if (CSH_STRING_IS_HEAP_MF(in_str) || CSH_STRING_DATA_MF(in_str) == NULL)
     {
-        tempStr.m_capacity = in_str->m_capacity;
-        tempStr.m_strPtr = (CSHCharPtr_t)calloc(tempStr.m_capacity, CSH_CHAR_SIZE);
-
-        #if CSH_STRING_ASSERT_ENABLED_M
-            assert(tempStr.m_strPtr != NULL);
-        #endif
+        tempStr.m_status = in_str->m_status;
     }
 
+    size_t capacity = CSH_STRING_CAPACITY_MF(in_str);
+    if (capacity != 0 && CSH_internal_string_set_capacity(&tempStr, capacity) < 0)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_ALLOC_FAILED);
+    }
+    // Copied by size rather than as a cstr, so null characters within the string (such as in a mapped file) are kept.
     if (in_str->m_nullSize != 0)
     {
-        CSH_STRCPY_MF(tempStr.m_strPtr, tempStr.m_capacity, in_str->m_strPtr);
+        CSHCharPtr_t tempData = CSH_STRING_DATA_MF(&tempStr);
+        memcpy(tempData, CSH_STRING_DATA_MF(in_str), in_str->m_size * CSH_CHAR_SIZE);
+        tempData[in_str->m_size] = '\0';
     }
-    tempStr.m_status = in_str->m_status;
     tempStr.m_size = in_str->m_size;
     tempStr.m_nullSize = in_str->m_nullSize;
     tempStr.m_maxCstrSize = in_str->m_maxCstrSize;
+    tempStr.m_growthFactorPercent = in_str->m_growthFactorPercent;
 
     return tempStr;
 }
@@ -76,14 +307,38 @@ int8_t CSH_string_free(S_CSHString* in_this)
     {
         return CSHSSC_BAD_INPUT_STR;
     }
-    if (in_this->m_strPtr != NULL && in_this->m_status != CSHSSC_USE_ALLOCA)
+
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    if (in_this->m_status == CSHSSC_USE_MMAP)
     {
+        CSH_internal_string_unmap(in_this->m_strPtr, in_this->m_capacity);
+        in_this->m_strPtr = NULL;
+        in_this->m_status = CSHSSC_NONE;
         in_this->m_size = 0;
         in_this->m_nullSize = 0;
         in_this->m_capacity = 0;
-
-        free(in_this->m_strPtr);
+        return CSHSSC_NONE;
+    }
+    if (in_this->m_status == CSHSSC_USE_SSO)
+    {
+        in_this->m_strPtr = NULL;
+        in_this->m_status = CSHSSC_NONE;
+        in_this->m_size = 0;
+        in_this->m_nullSize = 0;
+        in_this->m_capacity = 0;
+        in_this->m_frontSlack = 0;
+        return CSHSSC_NONE;
+    }
+    if (CSH_STRING_IS_HEAP_MF(in_this))
+    {
+        CSH_allocator_free(in_this->m_allocator, (in_this->m_strPtr - in_this->m_frontSlack), (in_this->m_frontSlack + in_this->m_capacity) * CSH_CHAR_SIZE);
         in_this->m_strPtr = NULL;
+        in_this->m_frontSlack = 0;
+
+        in_this->m_size = 0;
+        in_this->m_nullSize = 0;
+        in_this->m_capacity = 0;
     }
 
     return CSHSSC_NONE;
@@ -96,16 +351,19 @@ int8_t CSH_string_clear(S_CSHString* in_this, bool in_freeMemory)
         return CSHSSC_BAD_INPUT_STR;
     }
 
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    // A mapped file can't be emptied in place, so it's unmapped instead.
+    if (in_freeMemory || CSH_STRING_READ_ONLY_MF(in_this))
+    {
+        return CSH_string_free(in_this);
+    }
     if (in_this->m_size > 0)
     {
-        in_this->m_strPtr[0] = '\0';
+        CSH_STRING_DATA_MF(in_this)[0] = '\0';
         in_this->m_size = 0;
         in_this->m_nullSize = 1;
     }
-    if (in_freeMemory)
-    {
-        return CSH_string_free(in_this);
-    }
 
     return CSHSSC_NONE;
 }
@@ -121,6 +379,79 @@ int8_t CSH_string_set_max_cstr_size(S_CSHString* in_this, size_t in_maxSize)
     return CSHSSC_NONE;
 }
 
+int8_t CSH_string_set_default_growth(uint16_t in_factorPercent, size_t in_minStep)
+{
+    if (in_factorPercent < 100)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    CSH_internal_growthFactorPercent = in_factorPercent;
+    CSH_internal_growthMinStep = in_minStep;
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_string_set_growth_factor(S_CSHString* in_this, uint16_t in_factorPercent)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+    if (in_factorPercent != 0 && in_factorPercent < 100)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    in_this->m_growthFactorPercent = in_factorPercent;
+    return CSHSSC_NONE;
+}
+
+CSHCharPtr_t CSH_string_data(S_CSHString* in_this)
+{
+    if (in_this == NULL)
+    {
+        return NULL;
+    }
+
+    return CSH_STRING_DATA_MF(in_this);
+}
+
+int8_t CSH_string_set_allocator(S_CSHString* in_this, const S_CSHAllocator* in_allocator)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    in_allocator = CSH_allocator_resolve(in_allocator);
+    bool isHeap = CSH_STRING_IS_HEAP_MF(in_this);
+    if (!isHeap || in_this->m_allocator == in_allocator)
+    {
+        in_this->m_allocator = in_allocator;
+        return CSHSSC_NONE;
+    }
+
+    CSHCharPtr_t newPtr = (CSHCharPtr_t)CSH_allocator_alloc(in_allocator, in_this->m_capacity * CSH_CHAR_SIZE);
+
+    #if CSH_STRING_ASSERT_ENABLED_M
+        assert(newPtr != NULL);
+    #endif
+
+    if (newPtr == NULL)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
+
+    // Only the contents are copied, the front slack isn't carried over to the new allocator.
+    memcpy(newPtr, in_this->m_strPtr, in_this->m_capacity * CSH_CHAR_SIZE);
+    CSH_allocator_free(in_this->m_allocator, (in_this->m_strPtr - in_this->m_frontSlack), (in_this->m_frontSlack + in_this->m_capacity) * CSH_CHAR_SIZE);
+    in_this->m_strPtr = newPtr;
+    in_this->m_frontSlack = 0;
+    in_this->m_allocator = in_allocator;
+
+    return CSHSSC_NONE;
+}
+
 int8_t CSH_string_cstr_fit(S_CSHString* in_this, CSHConstCharPtr_t in_str)
 {
     if (in_this == NULL || in_str == NULL)
@@ -179,26 +510,32 @@ int8_t CSH_string_assign_cstr(S_CSHString* in_this, CSHConstCharPtr_t in_str)
     {
         return CSHSSC_BAD_INPUT_STR;
     }
+
+    if (CSH_STRING_READ_ONLY_MF(in_this))
+    {
+        return CSHSSC_READ_ONLY;
+    }
+
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
     if (CSH_string_cstr_fit(in_this, in_str) < 0)
     {
         return CSHSSC_CSTR_DOESNT_FIT;
     }
 
     size_t cstrLen = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
-    if (cstrLen < in_this->m_capacity)
+    // Resizing the string's own memory keeps its allocator and settings, rather than recreating it.
+    if (CSH_STRING_DATA_MF(in_this) == NULL || cstrLen >= CSH_STRING_CAPACITY_MF(in_this))
     {
-        CSH_STRCPY_MF(in_this->m_strPtr, in_this->m_capacity, in_str);
-        in_this->m_size = cstrLen;
-        in_this->m_nullSize = cstrLen + 1;
-
-        return CSHSSC_NONE;
+        if (CSH_internal_string_set_capacity(in_this, (cstrLen + 1)) < 0)
+        {
+            return CSHSSC_ALLOC_FAILED;
+        }
     }
 
-    S_CSHString tempStr = {NULL, in_this->m_status, 0, 0, 0, in_this->m_maxCstrSize};
-    CSH_string_free(in_this);
-    *in_this = CSH_string_create_cstr(in_str, (tempStr.m_maxCstrSize - 1));
-    in_this->m_status = tempStr.m_status;
-    in_this->m_maxCstrSize = in_this->m_maxCstrSize;
+    CSH_STRCPY_MF(CSH_STRING_DATA_MF(in_this), CSH_STRING_CAPACITY_MF(in_this), in_str);
+    in_this->m_size = cstrLen;
+    in_this->m_nullSize = cstrLen + 1;
 
     return CSHSSC_NONE;
 }
@@ -210,17 +547,33 @@ int8_t CSH_string_assign(S_CSHString* in_this, S_CSHString* in_str)
         return CSHSSC_BAD_INPUT_STR;
     }
 
-    if (in_this->m_size < in_this->m_capacity)
+    if (CSH_STRING_READ_ONLY_MF(in_this))
     {
-        CSH_STRCPY_MF(in_this->m_strPtr, in_this->m_capacity, in_str->m_strPtr);
-        in_this->m_size = in_str->m_size;
-        in_this->m_nullSize = in_str->m_nullSize;
+        return CSHSSC_READ_ONLY;
+    }
 
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    if (in_this == in_str)
+    {
         return CSHSSC_NONE;
     }
-    
-    CSH_string_free(in_this);
-    *in_this = CSH_string_create(in_str);
+    if (CSH_STRING_DATA_MF(in_this) == NULL || in_str->m_size >= CSH_STRING_CAPACITY_MF(in_this))
+    {
+        if (CSH_internal_string_set_capacity(in_this, (in_str->m_size + 1)) < 0)
+        {
+            return CSHSSC_ALLOC_FAILED;
+        }
+    }
+
+    CSHCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+    if (in_str->m_size > 0)
+    {
+        memcpy(thisData, CSH_STRING_DATA_MF(in_str), in_str->m_size * CSH_CHAR_SIZE);
+    }
+    thisData[in_str->m_size] = '\0';
+    in_this->m_size = in_str->m_size;
+    in_this->m_nullSize = in_this->m_size + 1;
 
     return CSHSSC_NONE;
 }
@@ -243,36 +596,30 @@ S_CSHString CSH_string_create_concat_cstr(CSHConstCharPtr_t in_strOne, CSHConstC
     tempStr.m_status = CSHSSC_NONE;
     tempStr.m_size = resultOne + resultTwo;
     tempStr.m_nullSize = tempStr.m_size + 1;
-    tempStr.m_capacity = tempStr.m_nullSize;
     // If the average of the two maximum sizes is greater than CSH_STRING_MAX_CSTR_CHAR_COUNT_M, then set maxCstrSize to that average, 
     // otherwise just set it to CSH_STRING_MAX_CSTR_CHAR_COUNT_M.
     tempStr.m_maxCstrSize = (((in_maxSizeOne + in_maxSizeTwo) / 2) > CSH_STRING_MAX_CSTR_CHAR_COUNT_M) ? (((in_maxSizeOne + in_maxSizeTwo) / 2) + 1) : (CSH_STRING_MAX_CSTR_CHAR_COUNT_M + 1);
-    tempStr.m_strPtr = (CSHCharPtr_t)calloc(tempStr.m_capacity, CSH_CHAR_SIZE);
-
-    #if CSH_STRING_ASSERT_ENABLED_M
-        assert(tempStr.m_strPtr != NULL);
-    #endif
-
-    for (size_t i = 0; i < resultOne; i++)
-    {
-        tempStr.m_strPtr[i] = in_strOne[i];
-    }
-    for (size_t i = 0; i < resultTwo; i++)
+    if (CSH_internal_string_set_capacity(&tempStr, tempStr.m_nullSize) < 0)
     {
-        tempStr.m_strPtr[i + resultOne] = in_strTwo[i];
+        return CSH_STRING_ERROR_M(CSHSSC_ALLOC_FAILED);
     }
 
+    CSHCharPtr_t tempData = CSH_STRING_DATA_MF(&tempStr);
+    memcpy(tempData, in_strOne, resultOne * CSH_CHAR_SIZE);
+    memcpy(tempData + resultOne, in_strTwo, resultTwo * CSH_CHAR_SIZE);
+    tempData[tempStr.m_size] = '\0';
+
     return tempStr; 
 }
 
 S_CSHString CSH_string_create_concat_left_cstr(CSHConstCharPtr_t in_strOne, S_CSHString* in_strTwo)
 {
-    return CSH_string_create_concat_cstr(in_strOne, in_strTwo->m_strPtr, (in_strTwo->m_maxCstrSize - 1), in_strTwo->m_size);
+    return CSH_string_create_concat_cstr(in_strOne, CSH_STRING_DATA_MF(in_strTwo), (in_strTwo->m_maxCstrSize - 1), in_strTwo->m_size);
 }
 
 S_CSHString CSH_string_create_concat_right_cstr(S_CSHString* in_strOne, CSHConstCharPtr_t in_strTwo)
 {
-    return CSH_string_create_concat_cstr(in_strOne->m_strPtr, in_strTwo, in_strOne->m_size, (in_strOne->m_maxCstrSize - 1));
+    return CSH_string_create_concat_cstr(CSH_STRING_DATA_MF(in_strOne), in_strTwo, in_strOne->m_size, (in_strOne->m_maxCstrSize - 1));
 }
 
 S_CSHString CSH_string_create_concat(S_CSHString* in_strOne, S_CSHString* in_strTwo)
@@ -282,26 +629,26 @@ S_CSHString CSH_string_create_concat(S_CSHString* in_strOne, S_CSHString* in_str
         return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_STR);
     }
 
-    S_CSHString tempStr = CSH_STRING_DEFAULT_M;
+    S_CSHString tempStr = CSH_STRING_ALLOCATOR_M(in_strOne->m_allocator);
     tempStr.m_status = CSHSSC_NONE;
     tempStr.m_size = in_strOne->m_size + in_strTwo->m_size;
     tempStr.m_nullSize = tempStr.m_size + 1;
-    tempStr.m_capacity = tempStr.m_nullSize;
     tempStr.m_maxCstrSize = ((tempStr.m_size / 2) > CSH_STRING_MAX_CSTR_CHAR_COUNT_M) ? ((tempStr.m_size / 2) + 1) : (CSH_STRING_MAX_CSTR_CHAR_COUNT_M + 1);
-    tempStr.m_strPtr = (CSHCharPtr_t)calloc(tempStr.m_size, CSH_CHAR_SIZE);
-
-    #if CSH_STRING_ASSERT_ENABLED_M
-        assert(tempStr.m_strPtr != NULL);
-    #endif
+    if (CSH_internal_string_set_capacity(&tempStr, tempStr.m_nullSize) < 0)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_ALLOC_FAILED);
+    }
 
-    for (size_t i = 0; i < in_strOne->m_size; i++)
+    CSHCharPtr_t tempData = CSH_STRING_DATA_MF(&tempStr);
+    if (in_strOne->m_size > 0)
     {
-        tempStr.m_strPtr[i] = in_strOne->m_strPtr[i];
+        memcpy(tempData, CSH_STRING_DATA_MF(in_strOne), in_strOne->m_size * CSH_CHAR_SIZE);
     }
-    for (size_t i = 0; i < in_strTwo->m_size; i++)
+    if (in_strTwo->m_size > 0)
     {
-        tempStr.m_strPtr[i + in_strOne->m_size] = in_strTwo->m_strPtr[i];
+        memcpy(tempData + in_strOne->m_size, CSH_STRING_DATA_MF(in_strTwo), in_strTwo->m_size * CSH_CHAR_SIZE);
     }
+    tempData[tempStr.m_size] = '\0';
 
     return tempStr;
 }
@@ -313,34 +660,20 @@ int8_t CSH_string_concat_left_cstr(CSHConstCharPtr_t in_str, S_CSHString* in_thi
         return CSHSSC_BAD_INPUT_STR;
     }
 
-    size_t result = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
-    if (result == in_this->m_maxCstrSize)
+    if (CSH_STRING_READ_ONLY_MF(in_this))
     {
-        return CSHSSC_CSTR_DOESNT_FIT;
+        return CSHSSC_READ_ONLY;
     }
 
-    in_this->m_size = in_this->m_size + result;
-    in_this->m_nullSize = in_this->m_size + 1;
-
-    if (in_this->m_capacity < in_this->m_nullSize)
-    {
-        CSH_string_reserve(in_this, in_this->m_nullSize);
-    }
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
 
-    for (intmax_t i = (in_this->m_size - 1); i >= 0; i--)
-    {
-        // Shift the current contents of the string to the right.
-        if (in_this->m_strPtr[i] != '\0')
-        {
-            in_this->m_strPtr[i + result] = in_this->m_strPtr[i];
-        }
-    }
-    for (size_t i = 0; i < result; i++)
+    size_t result = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
+    if (result == in_this->m_maxCstrSize)
     {
-        in_this->m_strPtr[i] = in_str[i];
+        return CSHSSC_CSTR_DOESNT_FIT;
     }
 
-    return CSHSSC_NONE;
+    return CSH_internal_string_prepend(in_this, in_str, result);
 }
 
 int8_t CSH_string_concat_right_cstr(S_CSHString* in_this, CSHConstCharPtr_t in_str)
@@ -350,80 +683,146 @@ int8_t CSH_string_concat_right_cstr(S_CSHString* in_this, CSHConstCharPtr_t in_s
         return CSHSSC_BAD_INPUT_STR;
     }
 
-    size_t result = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
-    if (result == in_this->m_maxCstrSize)
+    if (CSH_STRING_READ_ONLY_MF(in_this))
     {
-        return CSHSSC_CSTR_DOESNT_FIT;
+        return CSHSSC_READ_ONLY;
     }
 
-    size_t originalSize = in_this->m_size;
-    in_this->m_size = in_this->m_size + result;
-    in_this->m_nullSize = in_this->m_size + 1;
-    
-    if (in_this->m_capacity < in_this->m_nullSize)
-    {
-        CSH_string_reserve(in_this, in_this->m_nullSize);
-    }
-    for (size_t i = 0; i < result; i++)
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    size_t result = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
+    if (result == in_this->m_maxCstrSize)
     {
-        in_this->m_strPtr[i + originalSize] = in_str[i];
+        return CSHSSC_CSTR_DOESNT_FIT;
     }
 
-    return CSHSSC_NONE;
+    return CSH_string_splice(in_this, in_this->m_size, 0, in_str, result);
 }
 
-int8_t CSH_string_concat_left(S_CSHString* in_str, S_CSHString* in_this)
+CSHCharPtr_t CSH_string_extend(S_CSHString* in_this, size_t in_size)
 {
-    if (in_this == NULL || in_str == NULL)
+    if (in_this == NULL)
     {
-        return CSHSSC_BAD_INPUT_STR;
+        return NULL;
     }
 
-    in_this->m_size += in_str->m_size;
-    in_this->m_nullSize = in_this->m_size + 1;
-    
-    if (in_this->m_capacity < in_this->m_nullSize)
+    if (CSH_STRING_READ_ONLY_MF(in_this))
     {
-        CSH_string_reserve(in_this, in_this->m_nullSize);
+        return NULL;
     }
 
-    for (intmax_t i = (in_this->m_size - 1); i >= 0; i--)
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    if (CSH_internal_string_grow(in_this, (in_this->m_size + in_size + 1)) < 0)
     {
-        // Shift the current contents of the string to the right.
-        if (in_this->m_strPtr[i] != '\0')
+        return NULL;
+    }
+
+    CSHCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+    CSHCharPtr_t extension = thisData + in_this->m_size;
+    in_this->m_size += in_size;
+    in_this->m_nullSize = in_this->m_size + 1;
+    thisData[in_this->m_size] = '\0';
+
+    return extension;
+}
+
+int8_t CSH_string_append_vformat(S_CSHString* in_this, CSHConstCharPtr_t in_format, va_list in_args)
+{
+    if (in_this == NULL || in_format == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    if (CSH_STRING_READ_ONLY_MF(in_this))
+    {
+        return CSHSSC_READ_ONLY;
+    }
+
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    // The first pass writes into the spare capacity, and measures the output if it doesn't fit.
+    CSHCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+    size_t spareSize = (thisData != NULL) ? (CSH_STRING_CAPACITY_MF(in_this) - in_this->m_size) : 0;
+    va_list argsCopy;
+    va_copy(argsCopy, in_args);
+    int result = CSH_VSNPRINTF_MF(((thisData != NULL) ? (thisData + in_this->m_size) : NULL), spareSize, in_format, in_args);
+    int8_t status = (result < 0) ? CSHSSC_BAD_INPUT_ARG : CSHSSC_NONE;
+
+    if (status == CSHSSC_NONE && (size_t)result >= spareSize)
+    {
+        if (CSH_internal_string_grow(in_this, (in_this->m_size + (size_t)result + 1)) < 0)
+        {
+            status = CSHSSC_ALLOC_FAILED;
+        }
+        else
         {
-            in_this->m_strPtr[i + in_str->m_size] = in_this->m_strPtr[i];
+            thisData = CSH_STRING_DATA_MF(in_this);
+            result = CSH_VSNPRINTF_MF((thisData + in_this->m_size), ((size_t)result + 1), in_format, argsCopy);
+            status = (result < 0) ? CSHSSC_BAD_INPUT_ARG : CSHSSC_NONE;
         }
     }
-    for (size_t i = 0; i < in_str->m_size; i++)
+    va_end(argsCopy);
+
+    if (status < 0)
     {
-        in_this->m_strPtr[i] = in_str->m_strPtr[i];
+        // Drop any partial output.
+        thisData = CSH_STRING_DATA_MF(in_this);
+        if (thisData != NULL)
+        {
+            thisData[in_this->m_size] = '\0';
+        }
+        return status;
     }
 
+    in_this->m_size += (size_t)result;
+    in_this->m_nullSize = in_this->m_size + 1;
+
     return CSHSSC_NONE;
 }
 
-int8_t CSH_string_concat_right(S_CSHString* in_this, S_CSHString* in_str)
+int8_t CSH_string_append_format(S_CSHString* in_this, CSHConstCharPtr_t in_format, ...)
+{
+    va_list args;
+    va_start(args, in_format);
+    int8_t result = CSH_string_append_vformat(in_this, in_format, args);
+    va_end(args);
+
+    return result;
+}
+
+int8_t CSH_string_concat_left(S_CSHString* in_str, S_CSHString* in_this)
 {
     if (in_this == NULL || in_str == NULL)
     {
         return CSHSSC_BAD_INPUT_STR;
     }
 
-    size_t originalSize = in_this->m_size;
-    in_this->m_size += in_str->m_size;
-    in_this->m_nullSize = in_this->m_size + 1;
-    
-    if (in_this->m_capacity < in_this->m_nullSize)
+    if (CSH_STRING_READ_ONLY_MF(in_this))
     {
-        CSH_string_reserve(in_this, in_this->m_nullSize);
+        return CSHSSC_READ_ONLY;
     }
-    for (size_t i = 0; i < in_str->m_size; i++)
+
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    return CSH_internal_string_prepend(in_this, CSH_STRING_DATA_MF(in_str), in_str->m_size);
+}
+
+int8_t CSH_string_concat_right(S_CSHString* in_this, S_CSHString* in_str)
+{
+    if (in_this == NULL || in_str == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    if (CSH_STRING_READ_ONLY_MF(in_this))
     {
-        in_this->m_strPtr[i + originalSize] = in_str->m_strPtr[i];
+        return CSHSSC_READ_ONLY;
     }
 
-    return CSHSSC_NONE;
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    return CSH_string_splice(in_this, in_this->m_size, 0, CSH_STRING_DATA_MF(in_str), in_str->m_size);
 }
 
 int8_t CSH_string_add_char(S_CSHString* in_this, CSHChar_t in_char)
@@ -433,22 +832,34 @@ int8_t CSH_string_add_char(S_CSHString* in_this, CSHChar_t in_char)
         return CSHSSC_BAD_INPUT_STR;
     }
 
-    if ((in_this->m_size + 1) < in_this->m_capacity)
+    if (CSH_STRING_READ_ONLY_MF(in_this))
+    {
+        return CSHSSC_READ_ONLY;
+    }
+
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    CSHCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+    if ((in_this->m_size + 1) < CSH_STRING_CAPACITY_MF(in_this))
     {
-        in_this->m_strPtr[in_this->m_size] = in_char;
+        thisData[in_this->m_size] = in_char;
         in_this->m_size += 1;
         in_this->m_nullSize += 1;
-        in_this->m_strPtr[in_this->m_size] = '\0';
+        thisData[in_this->m_size] = '\0';
 
         return CSHSSC_NONE;
     }
 
-    CSH_string_reserve(in_this, (in_this->m_nullSize + 1));
+    if (CSH_internal_string_grow(in_this, (in_this->m_size + 2)) < 0)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
 
-    in_this->m_strPtr[in_this->m_size] = in_char;
+    thisData = CSH_STRING_DATA_MF(in_this);
+    thisData[in_this->m_size] = in_char;
     in_this->m_size += 1;
-    in_this->m_nullSize += 1;
-    in_this->m_strPtr[in_this->m_size] = '\0';
+    in_this->m_nullSize = in_this->m_size + 1;
+    thisData[in_this->m_size] = '\0';
 
     return CSHSSC_NONE;
 }
@@ -460,10 +871,18 @@ CSHChar_t CSH_string_pop_char(S_CSHString* in_this)
         return '\0';
     }
 
+    if (CSH_STRING_READ_ONLY_MF(in_this))
+    {
+        return '\0';
+    }
+
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    CSHCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
     if (in_this->m_size > 0)
     {
-        CSHChar_t tempChar = in_this->m_strPtr[(in_this->m_size - 1)];
-        in_this->m_strPtr[(in_this->m_size - 1)] = '\0';
+        CSHChar_t tempChar = thisData[(in_this->m_size - 1)];
+        thisData[(in_this->m_size - 1)] = '\0';
         in_this->m_size -= 1;
         in_this->m_nullSize -= 1;
 
@@ -479,92 +898,54 @@ int8_t CSH_string_reserve(S_CSHString* in_this, size_t in_size)
     {
         return CSHSSC_BAD_INPUT_STR;
     }
-    if (in_this->m_capacity >= (in_size + 1))
+    if (CSH_STRING_READ_ONLY_MF(in_this))
     {
-        return CSHSSC_ALREADY_RESERVED;
+        return CSHSSC_READ_ONLY;
     }
-
-    if (in_this->m_size == 0)
+    if (CSH_STRING_CAPACITY_MF(in_this) >= (in_size + 1))
     {
-        if (in_this->m_strPtr != NULL)
-        {
-            free(in_this->m_strPtr);
-            in_this->m_strPtr = NULL;
-        }
-        
-        in_this->m_capacity = (in_size + 1);
-        in_this->m_strPtr = (CSHCharPtr_t)calloc(in_this->m_capacity, CSH_CHAR_SIZE);
-
-        #if CSH_STRING_ASSERT_ENABLED_M
-            assert(in_this->m_strPtr != NULL);
-        #endif
-    }
-    else 
-    {
-        S_CSHString tempStr = *in_this;
-        tempStr.m_strPtr = NULL;
-        tempStr.m_status = CSHSSC_USE_ALLOCA;
-        CSH_STRING_CALLOC_MF(tempStr.m_strPtr, tempStr.m_nullSize, CSH_CHAR_SIZE, &tempStr.m_status, false);
-        
-        #if CSH_STRING_ASSERT_ENABLED_M
-            assert(tempStr.m_strPtr != NULL);
-        #endif
-        CSH_string_assign(&tempStr, in_this);
-
-        free(in_this->m_strPtr);
-        in_this->m_capacity = (in_size + 1);
-        in_this->m_strPtr = (CSHCharPtr_t)calloc(in_this->m_capacity, CSH_CHAR_SIZE);
-
-        #if CSH_STRING_ASSERT_ENABLED_M
-            assert(in_this->m_strPtr != NULL);
-        #endif
-
-        for (size_t i = 0; i < tempStr.m_size; i++)
-        {
-            in_this->m_strPtr[i] = tempStr.m_strPtr[i];
-        }
-        CSH_string_free(&tempStr);
+        return CSHSSC_ALREADY_RESERVED;
     }
 
-    return CSHSSC_NONE;
+    return CSH_internal_string_set_capacity(in_this, (in_size + 1));
 }
 
-int8_t CSH_string_shrink_to_fit(S_CSHString* in_this)
+int8_t CSH_string_reserve_front(S_CSHString* in_this, size_t in_size)
 {
     if (in_this == NULL)
     {
         return CSHSSC_BAD_INPUT_STR;
     }
-    if (in_this->m_nullSize == in_this->m_capacity)
+    if (CSH_STRING_READ_ONLY_MF(in_this))
     {
-        return CSHSSC_ALREADY_RESERVED;
+        return CSHSSC_READ_ONLY;
     }
 
-    S_CSHString tempStr = *in_this;
-    tempStr.m_strPtr = NULL;
-    tempStr.m_status = CSHSSC_USE_ALLOCA;
-    CSH_STRING_CALLOC_MF(tempStr.m_strPtr, tempStr.m_nullSize, CSH_CHAR_SIZE, &tempStr.m_status, false);
-    
-    #if CSH_STRING_ASSERT_ENABLED_M
-        assert(tempStr.m_strPtr != NULL);
-    #endif
-    CSH_string_assign(&tempStr, in_this);
-
-    free(in_this->m_strPtr);
-    in_this->m_strPtr = (CSHCharPtr_t)calloc(in_this->m_nullSize, CSH_CHAR_SIZE);
-    in_this->m_capacity = in_this->m_nullSize;
+    bool isHeap = CSH_STRING_IS_HEAP_MF(in_this);
+    if (isHeap && in_this->m_frontSlack >= in_size)
+    {
+        return CSHSSC_ALREADY_RESERVED;
+    }
 
-    #if CSH_STRING_ASSERT_ENABLED_M
-        assert(in_this->m_strPtr != NULL);
-    #endif
+    return CSH_internal_string_set_front_slack(in_this, in_size);
+}
 
-    for (size_t i = 0; i < in_this->m_size; i++)
+int8_t CSH_string_shrink_to_fit(S_CSHString* in_this)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+    if (CSH_STRING_READ_ONLY_MF(in_this))
+    {
+        return CSHSSC_READ_ONLY;
+    }
+    if ((in_this->m_nullSize == CSH_STRING_CAPACITY_MF(in_this) && (!CSH_STRING_IS_HEAP_MF(in_this) || in_this->m_frontSlack == 0)) || in_this->m_nullSize == 0)
     {
-        in_this->m_strPtr[i] = tempStr.m_strPtr[i];
+        return CSHSSC_ALREADY_RESERVED;
     }
-    CSH_string_free(&tempStr);
 
-    return CSHSSC_NONE;   
+    return CSH_internal_string_set_capacity(in_this, in_this->m_nullSize);
 }
 
 int8_t CSH_string_resize(S_CSHString* in_this, size_t in_size, CSHChar_t in_char)
@@ -573,14 +954,23 @@ int8_t CSH_string_resize(S_CSHString* in_this, size_t in_size, CSHChar_t in_char
     {
         return CSHSSC_BAD_INPUT_STR;
     }
+
+    if (CSH_STRING_READ_ONLY_MF(in_this))
+    {
+        return CSHSSC_READ_ONLY;
+    }
+
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
     if (in_this->m_size == in_size)
     {
         return CSHSSC_ALREADY_RESERVED;
     }
 
+    CSHCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
     if (in_this->m_size > in_size)
     {
-        in_this->m_strPtr[in_size] = '\0';
+        thisData[in_size] = '\0';
         in_this->m_size = in_size;
         in_this->m_nullSize = in_this->m_size + 1;
 
@@ -588,9 +978,10 @@ int8_t CSH_string_resize(S_CSHString* in_this, size_t in_size, CSHChar_t in_char
     }
 
     CSH_string_reserve(in_this, in_size + 1);
+    thisData = CSH_STRING_DATA_MF(in_this);
     for (size_t i = in_this->m_size; i < in_size; i++)
     {
-        in_this->m_strPtr[i] = in_char;    
+        thisData[i] = in_char;    
     }
     if (in_char != '\0')
     {
@@ -601,116 +992,92 @@ int8_t CSH_string_resize(S_CSHString* in_this, size_t in_size, CSHChar_t in_char
     return CSHSSC_NONE;
 }
 
-int8_t CSH_string_insert_cstr(S_CSHString* in_this, size_t in_pos, CSHConstCharPtr_t in_str)
+int8_t CSH_string_splice(S_CSHString* in_this, size_t in_pos, size_t in_len, CSHConstCharPtr_t in_str, size_t in_size)
 {
-    if (in_this == NULL || in_str == NULL)
+    if (in_this == NULL || (in_str == NULL && in_size > 0))
     {
         return CSHSSC_BAD_INPUT_STR;
     }
-    if (in_pos >= in_this->m_size)
-    {
-        return CSHSSC_BAD_INPUT_ARG;
-    }
 
-    size_t result = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
-    if (result == in_this->m_maxCstrSize)
+    if (CSH_STRING_READ_ONLY_MF(in_this))
     {
-        return CSHSSC_CSTR_DOESNT_FIT;
+        return CSHSSC_READ_ONLY;
     }
 
-    in_this->m_size += result;
-    in_this->m_nullSize = in_this->m_size + 1;
-
-    if (in_this->m_capacity < in_this->m_nullSize)
-    {
-        CSH_string_reserve(in_this, in_this->m_nullSize);
-    }
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
 
-    // (in_this->m_size - 1) to account for in_this->m_strPtr[i + 1], which ensures the character at in_pos is replaced with the first character of in_str.
-    for (size_t i = in_pos; i < (in_this->m_size - 1); i++)
+    if (in_pos > in_this->m_size)
     {
-        in_this->m_strPtr[i + result] = in_this->m_strPtr[i + 1];
+        return CSHSSC_BAD_INPUT_ARG;
     }
-    for (size_t i = 0; i < result; i++)
+    if (in_len > (in_this->m_size - in_pos))
     {
-        in_this->m_strPtr[in_pos + i] = in_str[i];
+        in_len = in_this->m_size - in_pos;
     }
 
-    return CSHSSC_NONE;  
-}
+    CSHCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+    // in_str may point into in_this, so remember where, in case growing moves the data.
+    bool aliased = (thisData != NULL && in_str >= thisData && in_str < (thisData + in_this->m_size));
+    size_t strOffset = aliased ? (size_t)(in_str - thisData) : 0;
+    size_t tailPos = in_pos + in_len;
+    size_t tailSize = in_this->m_size - tailPos;
+    size_t newSize = in_this->m_size - in_len + in_size;
 
-int8_t CSH_string_insert(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str)
-{
-    if (in_this == NULL || in_str == NULL)
-    {
-        return CSHSSC_BAD_INPUT_STR;
-    }
-    if (in_pos >= in_this->m_size)
+    if (CSH_internal_string_grow(in_this, newSize + 1) < 0)
     {
-        return CSHSSC_BAD_INPUT_ARG;
+        return CSHSSC_ALLOC_FAILED;
     }
-
-    in_this->m_size += in_str->m_size;
-    in_this->m_nullSize = in_str->m_size + 1;
-
-    if (in_this->m_capacity < in_this->m_nullSize)
+    thisData = CSH_STRING_DATA_MF(in_this);
+    if (aliased)
     {
-        CSH_string_reserve(in_this, in_this->m_nullSize);
+        in_str = thisData + strOffset;
     }
 
-    // (in_this->m_size - 1) to account for in_this->m_strPtr[i + 1], which ensures the character at in_pos is replaced with the first character of in_str.
-    for (size_t i = in_pos; i < (in_this->m_size - 1); i++)
+    if (in_size <= in_len)
     {
-        in_this->m_strPtr[i + in_str->m_size] = in_this->m_strPtr[i + 1];
+        // The copy only writes over the erased range, so it's done before the tail moves left.
+        if (in_size > 0)
+        {
+            memmove(thisData + in_pos, in_str, in_size * CSH_CHAR_SIZE);
+        }
+        memmove(thisData + in_pos + in_size, thisData + tailPos, tailSize * CSH_CHAR_SIZE);
     }
-    for (size_t i = 0; i < in_str->m_size; i++)
+    else
     {
-        in_this->m_strPtr[in_pos + i] = in_str->m_strPtr[i];
+        memmove(thisData + in_pos + in_size, thisData + tailPos, tailSize * CSH_CHAR_SIZE);
+        if (aliased && (strOffset + in_size) > tailPos)
+        {
+            // The part of in_str that was in the tail has moved right by (in_size - in_len).
+            size_t headSize = (strOffset < tailPos) ? (tailPos - strOffset) : 0;
+            memmove(thisData + in_pos, in_str, headSize * CSH_CHAR_SIZE);
+            memcpy(thisData + in_pos + headSize, in_str + headSize + (in_size - in_len), (in_size - headSize) * CSH_CHAR_SIZE);
+        }
+        else
+        {
+            memmove(thisData + in_pos, in_str, in_size * CSH_CHAR_SIZE);
+        }
     }
 
+    in_this->m_size = newSize;
+    in_this->m_nullSize = newSize + 1;
+    thisData[newSize] = '\0';
+
     return CSHSSC_NONE;
 }
 
-int8_t CSH_string_erase(S_CSHString* in_this, size_t in_pos, size_t in_len)
+int8_t CSH_string_insert_cstr(S_CSHString* in_this, size_t in_pos, CSHConstCharPtr_t in_str)
 {
-    if (in_this == NULL)
-    {
-        return CSHSSC_BAD_INPUT_STR;
-    }
-    if (in_pos >= in_this->m_size)
-    {
-        return CSHSSC_BAD_INPUT_ARG;
-    }
-    if (in_len == 0)
-    {
-        return CSHSSC_NONE;
-    }
-
-    if ((in_pos + in_len) > in_this->m_size)
-    {
-        in_len = (in_this->m_size - in_pos);
-    }
-
-    size_t endSubStrPos = (in_pos + in_len);
-    S_CSHString tempStr = CSH_STRING_DEFAULT_M;
-    CSH_string_reserve(&tempStr, in_this->m_size - endSubStrPos);
-
-    for (size_t i = endSubStrPos, counter = 0; i < in_this->m_size; i++, counter++)
-    {
-        CSH_string_add_char(&tempStr, in_this->m_strPtr[i]);
-    }
-    for (size_t i = in_pos, counter = 0; counter < tempStr.m_size; i++, counter++)
-    {
-        in_this->m_strPtr[i] = tempStr.m_strPtr[counter];
-    }
+    return CSH_string_replace_cstr(in_this, in_pos, 0, in_str);
+}
 
-    in_this->m_size -= in_len;
-    in_this->m_nullSize = in_this->m_size + 1;
-    in_this->m_strPtr[in_this->m_size] = '\0';
-    
-    CSH_string_free(&tempStr);
+int8_t CSH_string_insert(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str)
+{
+    return CSH_string_replace(in_this, in_pos, 0, in_str);
+}
 
-    return CSHSSC_NONE;
+int8_t CSH_string_erase(S_CSHString* in_this, size_t in_pos, size_t in_len)
+{
+    return CSH_string_splice(in_this, in_pos, in_len, NULL, 0);
 }
 
 int8_t CSH_string_swap(S_CSHString* in_strOne, S_CSHString* in_strTwo)
@@ -733,39 +1100,14 @@ int8_t CSH_string_replace_cstr(S_CSHString* in_this, size_t in_pos, size_t in_le
     {
         return CSHSSC_BAD_INPUT_STR;
     }
-    if (in_pos >= in_this->m_size)
-    {
-        return CSHSSC_BAD_INPUT_ARG;
-    }
-    if (in_len == 0)
-    {
-        return CSHSSC_NONE;
-    }
 
     size_t result = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
-    if (result < in_len)
-    {
-        in_len = result;
-    }
-    if (in_len >= in_this->m_maxCstrSize)
+    if (result == in_this->m_maxCstrSize)
     {
         return CSHSSC_CSTR_DOESNT_FIT;
     }
 
-    intmax_t replaceSize = (in_this->m_size - (in_pos + in_len));
-    if (replaceSize > 0)
-    {
-        in_this->m_size += replaceSize;
-        in_this->m_nullSize = in_this->m_size + 1;
-        CSH_string_reserve(in_this, in_this->m_nullSize);
-    }
-
-    for (size_t i = in_pos, counter = 0; counter < in_len; i++, counter++)
-    {
-        in_this->m_strPtr[i] = in_str[counter];
-    }
-
-    return CSHSSC_NONE;
+    return CSH_string_splice(in_this, in_pos, in_len, in_str, result);
 }
 
 int8_t CSH_string_replace(S_CSHString* in_this, size_t in_pos, size_t in_len, S_CSHString* in_str)
@@ -774,34 +1116,8 @@ int8_t CSH_string_replace(S_CSHString* in_this, size_t in_pos, size_t in_len, S_
     {
         return CSHSSC_BAD_INPUT_STR;
     }
-    if (in_pos >= in_this->m_size)
-    {
-        return CSHSSC_BAD_INPUT_ARG;
-    }
-    if (in_len == 0)
-    {
-        return CSHSSC_NONE;
-    }
-
-    if (in_this->m_size < in_len)
-    {
-        in_len = in_this->m_size;
-    }
-
-    intmax_t replaceSize = (in_this->m_size - (in_pos + in_len));
-    if (replaceSize > 0)
-    {
-        in_this->m_size += replaceSize;
-        in_this->m_nullSize = in_this->m_size + 1;
-        CSH_string_reserve(in_this, in_this->m_nullSize);
-    }
-
-    for (size_t i = in_pos, counter = 0; counter < in_len; i++, counter++)
-    {
-        in_this->m_strPtr[i] = in_str->m_strPtr[counter];
-    }
 
-    return CSHSSC_NONE;   
+    return CSH_string_splice(in_this, in_pos, in_len, CSH_STRING_DATA_MF(in_str), in_str->m_size);
 }
 
 int8_t CSH_string_copy_arr(S_CSHString* in_this, CSHCharPtr_t in_charArr, size_t in_maxNullSize, size_t in_pos, size_t in_len)
@@ -828,9 +1144,10 @@ int8_t CSH_string_copy_arr(S_CSHString* in_this, CSHCharPtr_t in_charArr, size_t
         return CSHSSC_CSTR_DOESNT_FIT;
     }
 
+    CSHCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
     for (size_t i = in_pos, counter = 0; counter < in_len; i++, counter++)
     {
-        in_charArr[counter] = in_this->m_strPtr[i]; 
+        in_charArr[counter] = thisData[i]; 
     }
     in_charArr[in_len] = '\0';
 
@@ -847,18 +1164,17 @@ size_t CSH_string_find_cstr(S_CSHString* in_this, size_t in_pos, CSHConstCharPtr
     {
         return CSH_STRING_NPOS;
     }
-    if (CSH_string_cstr_fit(in_this, in_str) < 0)
-    {
-        return CSH_STRING_NPOS;
-    }
 
-    CSHCharPtr_t tempCharPtr = strstr((in_this->m_strPtr + in_pos), in_str);
-    if (tempCharPtr == NULL)
+    // Bounding the length here doubles as the CSH_string_cstr_fit check.
+    size_t strSize = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
+    if (strSize == in_this->m_maxCstrSize)
     {
         return CSH_STRING_NPOS;
     }
 
-    return (in_pos + (tempCharPtr - (in_this->m_strPtr + in_pos)));
+    CSHConstCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+    size_t result = CSH_kernel_find((thisData + in_pos), (in_this->m_size - in_pos), in_str, strSize);
+    return (result != CSH_STRING_NPOS) ? (in_pos + result) : CSH_STRING_NPOS;
 }
 
 size_t CSH_cstr_find(CSHConstCharPtr_t in_strOne, size_t in_maxSize, size_t in_pos, CSHConstCharPtr_t in_strTwo)
@@ -867,18 +1183,22 @@ size_t CSH_cstr_find(CSHConstCharPtr_t in_strOne, size_t in_maxSize, size_t in_p
     {
         return CSH_STRING_NPOS;
     }
-    if (in_pos >= CSH_STRNLEN_MF(in_strOne, (in_maxSize + 1)))
+    size_t strOneSize = CSH_STRNLEN_MF(in_strOne, in_maxSize);
+    if (in_pos >= strOneSize)
     {
         return CSH_STRING_NPOS;
     }
 
-    CSHCharPtr_t tempCharPtr = strstr((in_strOne + in_pos), in_strTwo);
-    if (tempCharPtr == NULL)
+    // A needle longer than the remaining haystack can't match, so its length never needs to be counted past that.
+    size_t remaining = strOneSize - in_pos;
+    size_t strTwoSize = CSH_STRNLEN_MF(in_strTwo, (remaining + 1));
+    if (strTwoSize > remaining)
     {
         return CSH_STRING_NPOS;
     }
 
-    return (in_pos + (tempCharPtr - (in_strOne + in_pos)));
+    size_t result = CSH_kernel_find((in_strOne + in_pos), remaining, in_strTwo, strTwoSize);
+    return (result != CSH_STRING_NPOS) ? (in_pos + result) : CSH_STRING_NPOS;
 }
 
 size_t CSH_string_find(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str)
@@ -892,13 +1212,10 @@ size_t CSH_string_find(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str)
         return CSH_STRING_NPOS;
     }
 
-    CSHCharPtr_t tempCharPtr = strstr((in_this->m_strPtr + in_pos), in_str->m_strPtr);
-    if (tempCharPtr == NULL)
-    {
-        return CSH_STRING_NPOS;
-    }
-
-    return (in_pos + (tempCharPtr - (in_this->m_strPtr + in_pos)));
+    CSHConstCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+    CSHConstCharPtr_t strData = CSH_STRING_DATA_MF(in_str);
+    size_t result = CSH_kernel_find((thisData + in_pos), (in_this->m_size - in_pos), strData, in_str->m_size);
+    return (result != CSH_STRING_NPOS) ? (in_pos + result) : CSH_STRING_NPOS;
 }
 
 size_t CSH_string_rfind_cstr(S_CSHString* in_this, size_t in_pos, CSHConstCharPtr_t in_str)
@@ -911,31 +1228,16 @@ size_t CSH_string_rfind_cstr(S_CSHString* in_this, size_t in_pos, CSHConstCharPt
     {
         return CSH_STRING_NPOS;
     }
-    if (CSH_string_cstr_fit(in_this, in_str) < 0)
-    {
-        return CSH_STRING_NPOS;
-    }
 
-    CSHCharPtr_t tempCharPtr = strstr((in_this->m_strPtr + in_pos), in_str);
-    if (tempCharPtr == NULL)
+    size_t strSize = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
+    if (strSize == in_this->m_maxCstrSize)
     {
         return CSH_STRING_NPOS;
     }
 
-    CSHCharPtr_t lastCharPtr = tempCharPtr;
-    while (true)
-    {
-        tempCharPtr = strstr(lastCharPtr, in_str);
-        if (tempCharPtr != NULL)
-        {
-            lastCharPtr = tempCharPtr;
-            continue;
-        }
-
-        break;
-    }
-
-    return (in_pos + (lastCharPtr - (in_this->m_strPtr + in_pos)));
+    CSHConstCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+    size_t result = CSH_kernel_rfind((thisData + in_pos), (in_this->m_size - in_pos), in_str, strSize);
+    return (result != CSH_STRING_NPOS) ? (in_pos + result) : CSH_STRING_NPOS;
 }
 
 size_t CSH_cstr_rfind(CSHConstCharPtr_t in_strOne, size_t in_maxSize, size_t in_pos, CSHConstCharPtr_t in_strTwo)
@@ -944,31 +1246,22 @@ size_t CSH_cstr_rfind(CSHConstCharPtr_t in_strOne, size_t in_maxSize, size_t in_
     {
         return CSH_STRING_NPOS;
     }
-    if (in_pos >= CSH_STRNLEN_MF(in_strOne, (in_maxSize + 1)))
-    {
-        return CSH_STRING_NPOS;
-    }
 
-    CSHCharPtr_t tempCharPtr = strstr((in_strOne + in_pos), in_strTwo);
-    if (tempCharPtr == NULL)
+    size_t strOneSize = CSH_STRNLEN_MF(in_strOne, in_maxSize);
+    if (in_pos >= strOneSize)
     {
         return CSH_STRING_NPOS;
     }
 
-    CSHCharPtr_t lastCharPtr = tempCharPtr;
-    while (true)
+    size_t remaining = strOneSize - in_pos;
+    size_t strTwoSize = CSH_STRNLEN_MF(in_strTwo, (remaining + 1));
+    if (strTwoSize > remaining)
     {
-        tempCharPtr = strstr(lastCharPtr, in_strTwo);
-        if (tempCharPtr != NULL)
-        {
-            lastCharPtr = tempCharPtr;
-            continue;
-        }
-
-        break;
+        return CSH_STRING_NPOS;
     }
 
-    return (in_pos + (lastCharPtr - (in_strOne + in_pos)));
+    size_t result = CSH_kernel_rfind((in_strOne + in_pos), remaining, in_strTwo, strTwoSize);
+    return (result != CSH_STRING_NPOS) ? (in_pos + result) : CSH_STRING_NPOS;
 }
 
 size_t CSH_string_rfind(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str)
@@ -982,26 +1275,10 @@ size_t CSH_string_rfind(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str
         return CSH_STRING_NPOS;
     }
 
-    CSHCharPtr_t tempCharPtr = strstr((in_this->m_strPtr + in_pos), in_str->m_strPtr);
-    if (tempCharPtr == NULL)
-    {
-        return CSH_STRING_NPOS;
-    }
-
-    CSHCharPtr_t lastCharPtr = tempCharPtr;
-    while (true)
-    {
-        tempCharPtr = strstr(lastCharPtr, in_str->m_strPtr);
-        if (tempCharPtr != NULL)
-        {
-            lastCharPtr = tempCharPtr;
-            continue;
-        }
-
-        break;
-    }
-
-    return (in_pos + (lastCharPtr - (in_this->m_strPtr + in_pos)));
+    CSHConstCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+    CSHConstCharPtr_t strData = CSH_STRING_DATA_MF(in_str);
+    size_t result = CSH_kernel_rfind((thisData + in_pos), (in_this->m_size - in_pos), strData, in_str->m_size);
+    return (result != CSH_STRING_NPOS) ? (in_pos + result) : CSH_STRING_NPOS;
 }
 
 S_CSHString CSH_string_substr(S_CSHString* in_this, size_t in_pos, size_t in_len)
@@ -1019,15 +1296,21 @@ S_CSHString CSH_string_substr(S_CSHString* in_this, size_t in_pos, size_t in_len
         return CSH_STRING_DEFAULT_M;
     }
 
-    S_CSHString tempStr = CSH_STRING_DEFAULT_M;
-    CSH_string_reserve(&tempStr, (in_len + 1));
+    if ((in_pos + in_len) > in_this->m_size)
+    {
+        in_len = (in_this->m_size - in_pos);
+    }
+
+    S_CSHString tempStr = CSH_STRING_ALLOCATOR_M(in_this->m_allocator);
+    CSH_string_reserve(&tempStr, in_len);
     tempStr.m_size = in_len;
     tempStr.m_nullSize = (in_len + 1);
-    tempStr.m_capacity = tempStr.m_nullSize;
 
+    CSHCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+    CSHCharPtr_t tempData = CSH_STRING_DATA_MF(&tempStr);
     for (size_t i = in_pos, counter = 0; counter < tempStr.m_size; i++, counter++)
     {
-        tempStr.m_strPtr[counter] = in_this->m_strPtr[i];
+        tempData[counter] = thisData[i];
     }
 
     return tempStr;
@@ -1050,15 +1333,7 @@ int8_t CSH_string_compare_cstr(S_CSHString* in_strOne, CSHConstCharPtr_t in_strT
         return CSHSSC_BAD_INPUT_ARG;
     }
 
-    for (size_t i = 0; i < result; i++)
-    {
-        if (in_strOne->m_strPtr[i] != in_strTwo[i])
-        {
-            return CSHSSC_BAD_INPUT_ARG;
-        }
-    }
-
-    return CSHSSC_NONE;
+    return (CSH_kernel_compare(CSH_STRING_DATA_MF(in_strOne), in_strTwo, result) == 0) ? CSHSSC_NONE : CSHSSC_BAD_INPUT_ARG;
 }
 
 int8_t CSH_cstr_compare(CSHConstCharPtr_t in_strOne, size_t in_maxSize, CSHConstCharPtr_t in_strTwo)
@@ -1068,13 +1343,7 @@ int8_t CSH_cstr_compare(CSHConstCharPtr_t in_strOne, size_t in_maxSize, CSHConst
         return CSHSSC_BAD_INPUT_STR;
     }
 
-    int result = CSH_STRNCMP_MF(in_strOne, in_strTwo, in_maxSize);
-    if (result != 0)
-    {
-        return CSHSSC_BAD_INPUT_ARG;
-    }
-
-    return CSHSSC_NONE;
+    return (CSH_cstr_cmp(in_strOne, in_maxSize, in_strTwo) == 0) ? CSHSSC_NONE : CSHSSC_BAD_INPUT_ARG;
 }
 
 int8_t CSH_string_compare(S_CSHString* in_strOne, S_CSHString* in_strTwo)
@@ -1088,15 +1357,43 @@ int8_t CSH_string_compare(S_CSHString* in_strOne, S_CSHString* in_strTwo)
         return CSHSSC_BAD_INPUT_ARG;
     }
 
-    for (size_t i = 0; i < in_strOne->m_size; i++)
-    {
-        if (in_strOne->m_strPtr[i] != in_strTwo->m_strPtr[i])
-        {
-            return CSHSSC_BAD_INPUT_ARG;
-        }
+    return (CSH_kernel_compare(CSH_STRING_DATA_MF(in_strOne), CSH_STRING_DATA_MF(in_strTwo), in_strOne->m_size) == 0) ? CSHSSC_NONE : CSHSSC_BAD_INPUT_ARG;
+}
+
+int CSH_string_cmp(S_CSHString* in_strOne, S_CSHString* in_strTwo)
+{
+    return CSH_string_view_cmp(CSH_string_view(in_strOne), CSH_string_view(in_strTwo));
+}
+
+int CSH_string_cmp_cstr(S_CSHString* in_strOne, CSHConstCharPtr_t in_strTwo)
+{
+    if (in_strOne == NULL || in_strTwo == NULL)
+    {
+        return (in_strOne != NULL) - (in_strTwo != NULL);
     }
 
-    return CSHSSC_NONE;
+    size_t result = CSH_STRNLEN_MF(in_strTwo, in_strOne->m_maxCstrSize);
+    if (result == in_strOne->m_maxCstrSize)
+    {
+        // The cstr doesn't fit, so only its first result characters are known. Unless those already differ, it orders as the greater.
+        size_t count = (in_strOne->m_size < result) ? in_strOne->m_size : result;
+        int prefixResult = CSH_kernel_compare(CSH_STRING_DATA_MF(in_strOne), in_strTwo, count);
+        return (prefixResult != 0) ? prefixResult : -1;
+    }
+
+    return CSH_string_view_cmp(CSH_string_view(in_strOne), CSH_string_view_buffer(in_strTwo, result));
+}
+
+int CSH_cstr_cmp(CSHConstCharPtr_t in_strOne, size_t in_maxSize, CSHConstCharPtr_t in_strTwo)
+{
+    if (in_strOne == NULL || in_strTwo == NULL)
+    {
+        return (in_strOne != NULL) - (in_strTwo != NULL);
+    }
+
+    // Like strncmp, only the first in_maxSize characters of each are compared.
+    return CSH_string_view_cmp(CSH_string_view_buffer(in_strOne, CSH_STRNLEN_MF(in_strOne, in_maxSize)), 
+        CSH_string_view_buffer(in_strTwo, CSH_STRNLEN_MF(in_strTwo, in_maxSize)));
 }
 
 int8_t CSH_string_to_lower(S_CSHString* in_this)
@@ -1105,19 +1402,21 @@ int8_t CSH_string_to_lower(S_CSHString* in_this)
     {
         return CSHSSC_BAD_INPUT_STR;
     }
-    if (in_this->m_size == 0)
+
+    if (CSH_STRING_READ_ONLY_MF(in_this))
     {
-        return CSHSSC_NONE;
+        return CSHSSC_READ_ONLY;
     }
 
-    for (size_t i = 0; i < in_this->m_size; i++)
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    if (in_this->m_size == 0)
     {
-        if ((int)in_this->m_strPtr[i] >= 65 && (int)in_this->m_strPtr[i] <= 90)
-        {
-            in_this->m_strPtr[i] = (CSHChar_t)((int)in_this->m_strPtr[i] + 32);
-        }
+        return CSHSSC_NONE;
     }
 
+    CSH_kernel_to_lower(CSH_STRING_DATA_MF(in_this), in_this->m_size);
+
     return CSHSSC_NONE;
 }
 
@@ -1127,18 +1426,499 @@ int8_t CSH_string_to_upper(S_CSHString* in_this)
     {
         return CSHSSC_BAD_INPUT_STR;
     }
+
+    if (CSH_STRING_READ_ONLY_MF(in_this))
+    {
+        return CSHSSC_READ_ONLY;
+    }
+
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
     if (in_this->m_size == 0)
     {
         return CSHSSC_NONE;
     }
 
-    for (size_t i = 0; i < in_this->m_size; i++)
+    CSH_kernel_to_upper(CSH_STRING_DATA_MF(in_this), in_this->m_size);
+
+    return CSHSSC_NONE;
+}
+
+S_CSHStringView CSH_string_view(S_CSHString* in_this)
+{
+    if (in_this == NULL || in_this->m_status < CSHSSC_NONE)
+    {
+        return CSH_STRING_VIEW_DEFAULT_M;
+    }
+
+    // A string which has never allocated still gets a valid (empty) view.
+    CSHConstCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+    return (S_CSHStringView){((thisData != NULL) ? thisData : ""), in_this->m_size};
+}
+
+S_CSHStringView CSH_string_view_cstr(CSHConstCharPtr_t in_str, size_t in_maxSize)
+{
+    size_t result = CSH_cstr_size(in_str, in_maxSize);
+    if (result == CSH_STRING_NPOS)
+    {
+        return CSH_STRING_VIEW_DEFAULT_M;
+    }
+
+    return (S_CSHStringView){in_str, result};
+}
+
+S_CSHStringView CSH_string_view_buffer(CSHConstCharPtr_t in_ptr, size_t in_size)
+{
+    if (in_ptr == NULL)
+    {
+        return CSH_STRING_VIEW_DEFAULT_M;
+    }
+
+    return (S_CSHStringView){in_ptr, in_size};
+}
+
+S_CSHStringView CSH_string_view_substr(S_CSHStringView in_view, size_t in_pos, size_t in_len)
+{
+    if (in_view.m_strPtr == NULL || in_pos > in_view.m_size)
+    {
+        return CSH_STRING_VIEW_DEFAULT_M;
+    }
+
+    if (in_len > (in_view.m_size - in_pos))
+    {
+        in_len = (in_view.m_size - in_pos);
+    }
+
+    return (S_CSHStringView){(in_view.m_strPtr + in_pos), in_len};
+}
+
+S_CSHStringView CSH_string_substr_view(S_CSHString* in_this, size_t in_pos, size_t in_len)
+{
+    return CSH_string_view_substr(CSH_string_view(in_this), in_pos, in_len);
+}
+
+size_t CSH_string_view_find(S_CSHStringView in_view, size_t in_pos, S_CSHStringView in_str)
+{
+    if (in_view.m_strPtr == NULL || in_str.m_strPtr == NULL)
+    {
+        return CSH_STRING_NPOS;
+    }
+    if (in_pos >= in_view.m_size)
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    size_t result = CSH_kernel_find((in_view.m_strPtr + in_pos), (in_view.m_size - in_pos), in_str.m_strPtr, in_str.m_size);
+    return (result != CSH_STRING_NPOS) ? (in_pos + result) : CSH_STRING_NPOS;
+}
+
+size_t CSH_string_view_rfind(S_CSHStringView in_view, size_t in_pos, S_CSHStringView in_str)
+{
+    if (in_view.m_strPtr == NULL || in_str.m_strPtr == NULL)
+    {
+        return CSH_STRING_NPOS;
+    }
+    if (in_pos >= in_view.m_size)
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    size_t result = CSH_kernel_rfind((in_view.m_strPtr + in_pos), (in_view.m_size - in_pos), in_str.m_strPtr, in_str.m_size);
+    return (result != CSH_STRING_NPOS) ? (in_pos + result) : CSH_STRING_NPOS;
+}
+
+int8_t CSH_string_view_compare(S_CSHStringView in_viewOne, S_CSHStringView in_viewTwo)
+{
+    if (in_viewOne.m_strPtr == NULL || in_viewTwo.m_strPtr == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+    if (in_viewOne.m_size != in_viewTwo.m_size)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    return (CSH_kernel_compare(in_viewOne.m_strPtr, in_viewTwo.m_strPtr, in_viewOne.m_size) == 0) ? CSHSSC_NONE : CSHSSC_BAD_INPUT_ARG;
+}
+
+S_CSHString CSH_string_create_view(S_CSHStringView in_view)
+{
+    if (in_view.m_strPtr == NULL)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_STR);
+    }
+
+    S_CSHString tempStr = CSH_STRING_DEFAULT_M;
+    tempStr.m_size = in_view.m_size;
+    tempStr.m_nullSize = in_view.m_size + 1;
+    if (CSH_internal_string_set_capacity(&tempStr, tempStr.m_nullSize) < 0)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_ALLOC_FAILED);
+    }
+
+    CSHCharPtr_t tempData = CSH_STRING_DATA_MF(&tempStr);
+    memcpy(tempData, in_view.m_strPtr, in_view.m_size * CSH_CHAR_SIZE);
+    tempData[in_view.m_size] = '\0';
+
+    return tempStr;
+}
+
+int CSH_string_view_cmp(S_CSHStringView in_viewOne, S_CSHStringView in_viewTwo)
+{
+    if (in_viewOne.m_strPtr == NULL || in_viewTwo.m_strPtr == NULL)
+    {
+        return (in_viewOne.m_strPtr != NULL) - (in_viewTwo.m_strPtr != NULL);
+    }
+
+    size_t minSize = (in_viewOne.m_size < in_viewTwo.m_size) ? in_viewOne.m_size : in_viewTwo.m_size;
+    int result = CSH_kernel_compare(in_viewOne.m_strPtr, in_viewTwo.m_strPtr, minSize);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    return (in_viewOne.m_size > in_viewTwo.m_size) - (in_viewOne.m_size < in_viewTwo.m_size);
+}
+
+int8_t CSH_string_view_compare_icase(S_CSHStringView in_viewOne, S_CSHStringView in_viewTwo)
+{
+    if (in_viewOne.m_strPtr == NULL || in_viewTwo.m_strPtr == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+    if (in_viewOne.m_size != in_viewTwo.m_size)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    return CSH_kernel_equal_icase(in_viewOne.m_strPtr, in_viewTwo.m_strPtr, in_viewOne.m_size) ? CSHSSC_NONE : CSHSSC_BAD_INPUT_ARG;
+}
+
+size_t CSH_string_view_find_icase(S_CSHStringView in_view, size_t in_pos, S_CSHStringView in_str)
+{
+    if (in_view.m_strPtr == NULL || in_str.m_strPtr == NULL)
+    {
+        return CSH_STRING_NPOS;
+    }
+    if (in_pos >= in_view.m_size)
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    size_t result = CSH_kernel_find_icase((in_view.m_strPtr + in_pos), (in_view.m_size - in_pos), in_str.m_strPtr, in_str.m_size);
+    return (result != CSH_STRING_NPOS) ? (in_pos + result) : CSH_STRING_NPOS;
+}
+
+uint64_t CSH_string_view_hash_icase(S_CSHStringView in_view)
+{
+    if (in_view.m_strPtr == NULL)
+    {
+        return 0;
+    }
+
+    return CSH_kernel_hash_icase(in_view.m_strPtr, in_view.m_size, 0);
+}
+
+int8_t CSH_string_compare_icase(S_CSHString* in_strOne, S_CSHString* in_strTwo)
+{
+    if (in_strOne == NULL || in_strTwo == NULL)
     {
-        if ((int)in_this->m_strPtr[i] >= 97 && (int)in_this->m_strPtr[i] <= 122)
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    return CSH_string_view_compare_icase(CSH_string_view(in_strOne), CSH_string_view(in_strTwo));
+}
+
+int8_t CSH_string_compare_icase_cstr(S_CSHString* in_strOne, CSHConstCharPtr_t in_strTwo)
+{
+    if (in_strOne == NULL || in_strTwo == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    size_t result = CSH_STRNLEN_MF(in_strTwo, in_strOne->m_maxCstrSize);
+    if (result == in_strOne->m_maxCstrSize)
+    {
+        return CSHSSC_CSTR_DOESNT_FIT;
+    }
+
+    return CSH_string_view_compare_icase(CSH_string_view(in_strOne), CSH_string_view_buffer(in_strTwo, result));
+}
+
+size_t CSH_string_find_icase(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str)
+{
+    if (in_this == NULL || in_str == NULL)
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    return CSH_string_view_find_icase(CSH_string_view(in_this), in_pos, CSH_string_view(in_str));
+}
+
+size_t CSH_string_find_icase_cstr(S_CSHString* in_this, size_t in_pos, CSHConstCharPtr_t in_str)
+{
+    if (in_this == NULL || in_str == NULL)
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    size_t strSize = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
+    if (strSize == in_this->m_maxCstrSize)
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    return CSH_string_view_find_icase(CSH_string_view(in_this), in_pos, CSH_string_view_buffer(in_str, strSize));
+}
+
+uint64_t CSH_string_hash_icase(S_CSHString* in_this)
+{
+    if (in_this == NULL)
+    {
+        return 0;
+    }
+
+    return CSH_string_view_hash_icase(CSH_string_view(in_this));
+}
+
+uint64_t CSH_string_view_hash(S_CSHStringView in_view)
+{
+    if (in_view.m_strPtr == NULL)
+    {
+        return 0;
+    }
+
+    return CSH_kernel_hash(in_view.m_strPtr, in_view.m_size, 0);
+}
+
+uint64_t CSH_string_hash(S_CSHString* in_this)
+{
+    if (in_this == NULL)
+    {
+        return 0;
+    }
+    if (in_this->m_hashValid)
+    {
+        return in_this->m_hash;
+    }
+
+    return CSH_string_view_hash(CSH_string_view(in_this));
+}
+
+uint64_t CSH_string_hash_cached(S_CSHString* in_this)
+{
+    if (in_this == NULL)
+    {
+        return 0;
+    }
+    if (!in_this->m_hashValid)
+    {
+        in_this->m_hash = CSH_string_view_hash(CSH_string_view(in_this));
+        in_this->m_hashValid = true;
+    }
+
+    return in_this->m_hash;
+}
+
+// Returns piece in_index of an array passed to CSH_internal_string_join, there is one of these for each kind of array.
+typedef S_CSHStringView (*CSHInternalJoinPiece_t)(const void* in_pieces, size_t in_index, size_t in_maxSize);
+
+static S_CSHStringView CSH_internal_join_piece_view(const void* in_pieces, size_t in_index, size_t in_maxSize)
+{
+    (void)in_maxSize;
+    return ((const S_CSHStringView*)in_pieces)[in_index];
+}
+
+static S_CSHStringView CSH_internal_join_piece_string(const void* in_pieces, size_t in_index, size_t in_maxSize)
+{
+    (void)in_maxSize;
+    const S_CSHString* str = &((const S_CSHString*)in_pieces)[in_index];
+    if (str->m_status < CSHSSC_NONE)
+    {
+        return CSH_STRING_VIEW_DEFAULT_M;
+    }
+
+    CSHConstCharPtr_t strData = CSH_STRING_DATA_MF(str);
+    return (S_CSHStringView){((strData != NULL) ? strData : ""), str->m_size};
+}
+
+static S_CSHStringView CSH_internal_join_piece_cstr(const void* in_pieces, size_t in_index, size_t in_maxSize)
+{
+    return CSH_string_view_cstr(((const CSHConstCharPtr_t*)in_pieces)[in_index], in_maxSize);
+}
+
+// A piece measured by CSH_internal_string_join. m_strPtr is NULL for a piece within in_this itself, which is found again by m_thisOffset 
+// once in_this has grown, since growing can move (and free) its old buffer.
+typedef struct
+{
+    CSHConstCharPtr_t m_strPtr;
+    size_t m_size;
+    size_t m_thisOffset;
+} S_CSHInternalJoinPiece;
+
+// Pieces measured into a stack array. Joining more pieces than this only allocates an array for all of them when they're cstrs
+// (so each is only measured once), or when a piece past the stack array views in_this, otherwise the later pieces are fetched again to be copied.
+#define CSH_JOIN_STACK_PIECES_M 16
+
+static S_CSHInternalJoinPiece CSH_internal_join_measure(CSHConstCharPtr_t in_thisData, size_t in_thisSize, S_CSHStringView in_view)
+{
+    bool aliased = (in_thisData != NULL && in_view.m_strPtr >= in_thisData && in_view.m_strPtr < (in_thisData + in_thisSize));
+    S_CSHInternalJoinPiece piece = {in_view.m_strPtr, in_view.m_size, 0};
+    if (aliased)
+    {
+        piece.m_strPtr = NULL;
+        piece.m_thisOffset = (size_t)(in_view.m_strPtr - in_thisData);
+    }
+    return piece;
+}
+
+// Appends the pieces to in_this, measuring them all first so the string grows at most once.
+// The measured pieces are kept, so each cstr is only measured once, and pieces (or the separator) viewing in_this itself are copied correctly.
+// Views and strings past the stack array which don't view in_this are fetched again rather than kept, so reusing a string never allocates.
+static int8_t CSH_internal_string_join(S_CSHString* in_this, const void* in_pieces, size_t in_count, CSHInternalJoinPiece_t in_piece, size_t in_maxSize, S_CSHStringView in_separator)
+{
+    if (in_this == NULL || (in_pieces == NULL && in_count > 0))
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    if (CSH_STRING_READ_ONLY_MF(in_this))
+    {
+        return CSHSSC_READ_ONLY;
+    }
+
+    CSH_STRING_INVALIDATE_HASH_MF(in_this);
+
+    S_CSHInternalJoinPiece stackPieces[CSH_JOIN_STACK_PIECES_M];
+    S_CSHInternalJoinPiece* pieces = stackPieces;
+    size_t keptCount = (in_count < CSH_JOIN_STACK_PIECES_M) ? in_count : CSH_JOIN_STACK_PIECES_M;
+    if (in_count > CSH_JOIN_STACK_PIECES_M && in_piece == CSH_internal_join_piece_cstr)
+    {
+        pieces = (S_CSHInternalJoinPiece*)CSH_allocator_alloc(CSH_internal_string_allocator(in_this), in_count * sizeof(S_CSHInternalJoinPiece));
+        if (pieces == NULL)
         {
-            in_this->m_strPtr[i] = (CSHChar_t)((int)in_this->m_strPtr[i] - 32);
+            return CSHSSC_ALLOC_FAILED;
         }
+        keptCount = in_count;
     }
 
-    return CSHSSC_NONE;
+    CSHConstCharPtr_t oldData = CSH_STRING_DATA_MF(in_this);
+    S_CSHStringView separatorView = (in_separator.m_strPtr != NULL) ? in_separator : CSH_string_view_buffer("", 0);
+    S_CSHInternalJoinPiece separator = CSH_internal_join_measure(oldData, in_this->m_size, separatorView);
+    size_t totalSize = in_this->m_size + ((in_count > 0) ? ((in_count - 1) * separator.m_size) : 0);
+    int8_t result = CSHSSC_NONE;
+    bool aliasedUnkept = false;
+    for (size_t i = 0; i < in_count; i++)
+    {
+        S_CSHStringView piece = in_piece(in_pieces, i, in_maxSize);
+        if (piece.m_strPtr == NULL)
+        {
+            result = CSHSSC_BAD_INPUT_STR;
+            break;
+        }
+        S_CSHInternalJoinPiece measured = CSH_internal_join_measure(oldData, in_this->m_size, piece);
+        if (i < keptCount)
+        {
+            pieces[i] = measured;
+        }
+        else
+        {
+            aliasedUnkept = aliasedUnkept || (measured.m_strPtr == NULL);
+        }
+        totalSize += piece.m_size;
+    }
+
+    // An unkept piece views in_this, which growing can move, so every piece is kept to find it again afterwards.
+    if (result == CSHSSC_NONE && aliasedUnkept)
+    {
+        pieces = (S_CSHInternalJoinPiece*)CSH_allocator_alloc(CSH_internal_string_allocator(in_this), in_count * sizeof(S_CSHInternalJoinPiece));
+        if (pieces == NULL)
+        {
+            pieces = stackPieces;
+            result = CSHSSC_ALLOC_FAILED;
+        }
+        else
+        {
+            memcpy(pieces, stackPieces, keptCount * sizeof(S_CSHInternalJoinPiece));
+            for (size_t i = keptCount; i < in_count; i++)
+            {
+                pieces[i] = CSH_internal_join_measure(oldData, in_this->m_size, in_piece(in_pieces, i, in_maxSize));
+            }
+            keptCount = in_count;
+        }
+    }
+
+    if (result == CSHSSC_NONE && CSH_internal_string_grow(in_this, (totalSize + 1)) < 0)
+    {
+        result = CSHSSC_ALLOC_FAILED;
+    }
+
+    if (result == CSHSSC_NONE)
+    {
+        CSHCharPtr_t thisData = CSH_STRING_DATA_MF(in_this);
+        CSHConstCharPtr_t separatorPtr = (separator.m_strPtr != NULL) ? separator.m_strPtr : (thisData + separator.m_thisOffset);
+        size_t pos = in_this->m_size;
+        for (size_t i = 0; i < in_count; i++)
+        {
+            if (i > 0 && separator.m_size > 0)
+            {
+                memcpy(thisData + pos, separatorPtr, separator.m_size * CSH_CHAR_SIZE);
+                pos += separator.m_size;
+            }
+
+            // Aliased pieces are within the old contents, which the appended pieces never overwrite.
+            S_CSHInternalJoinPiece piece = (i < keptCount) ? pieces[i] : CSH_internal_join_measure(NULL, 0, in_piece(in_pieces, i, in_maxSize));
+            if (piece.m_size > 0)
+            {
+                CSHConstCharPtr_t piecePtr = (piece.m_strPtr != NULL) ? piece.m_strPtr : (thisData + piece.m_thisOffset);
+                memcpy(thisData + pos, piecePtr, piece.m_size * CSH_CHAR_SIZE);
+                pos += piece.m_size;
+            }
+        }
+
+        thisData[totalSize] = '\0';
+        in_this->m_size = totalSize;
+        in_this->m_nullSize = totalSize + 1;
+    }
+
+    if (pieces != stackPieces)
+    {
+        CSH_allocator_free(CSH_internal_string_allocator(in_this), pieces, in_count * sizeof(S_CSHInternalJoinPiece));
+    }
+
+    return result;
+}
+
+// Joins into a new string, which is freed again on failure.
+static S_CSHString CSH_internal_string_create_join(const void* in_pieces, size_t in_count, CSHInternalJoinPiece_t in_piece, size_t in_maxSize, S_CSHStringView in_separator)
+{
+    S_CSHString tempStr = CSH_STRING_DEFAULT_M;
+    int8_t result = CSH_internal_string_join(&tempStr, in_pieces, in_count, in_piece, in_maxSize, in_separator);
+    if (result < 0)
+    {
+        CSH_string_free(&tempStr);
+        return CSH_STRING_ERROR_M(result);
+    }
+
+    return tempStr;
+}
+
+S_CSHString CSH_string_join(const S_CSHStringView* in_pieces, size_t in_count, S_CSHStringView in_separator)
+{
+    return CSH_internal_string_create_join(in_pieces, in_count, CSH_internal_join_piece_view, 0, in_separator);
+}
+
+S_CSHString CSH_string_join_strings(const S_CSHString* in_strs, size_t in_count, S_CSHStringView in_separator)
+{
+    return CSH_internal_string_create_join(in_strs, in_count, CSH_internal_join_piece_string, 0, in_separator);
+}
+
+S_CSHString CSH_string_join_cstrs(const CSHConstCharPtr_t* in_strs, size_t in_count, size_t in_maxSize, S_CSHStringView in_separator)
+{
+    return CSH_internal_string_create_join(in_strs, in_count, CSH_internal_join_piece_cstr, in_maxSize, in_separator);
+}
+
+int8_t CSH_string_append_join(S_CSHString* in_this, const S_CSHStringView* in_pieces, size_t in_count, S_CSHStringView in_separator)
+{
+    return CSH_internal_string_join(in_this, in_pieces, in_count, CSH_internal_join_piece_view, 0, in_separator);
 }
\ No newline at end of file
@@ -3,7 +3,9 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdarg.h>
 #include <malloc.h>
+#include "CSHAllocator.h"
 
 typedef char CSHChar_t;
 typedef char* CSHCharPtr_t;
@@ -21,84 +23,123 @@ extern const size_t CSH_STRING_MAX_STACK_CHAR_COUNT; // = ((2048 / CSH_CHAR_SIZE
 
 // TODO: Add support for alloca to all CSH function which can support it.
 #define CSH_STRING_ALLOCA_ENABLED_M 1
+#define CSH_STRING_SSO_ENABLED_M 1
+// Can be defined as 0 before this header (or on the command line) to return CSHSSC_ALLOC_FAILED instead of asserting when an allocation fails.
+#ifndef CSH_STRING_ASSERT_ENABLED_M
 #define CSH_STRING_ASSERT_ENABLED_M 1
+#endif
 #define CSH_STRING_MAX_CSTR_CHAR_COUNT_M 2047
-#define CSH_STRING_DEFAULT_M (S_CSHString){NULL, 0, 0, 0, 0, (CSH_STRING_MAX_CSTR_CHAR_COUNT_M + 1)}
-#define CSH_STRING_ERROR_M(in_errorCode) (S_CSHString){NULL, in_errorCode, 0, 0, 0, (CSH_STRING_MAX_CSTR_CHAR_COUNT_M + 1)}
+#define CSH_STRING_GROWTH_FACTOR_PERCENT_DEFAULT_M 150
+#define CSH_STRING_GROWTH_MIN_STEP_DEFAULT_M 16
+
+// [ #define CSH_STRING_SSO_CAPACITY_M ]
+// The number of characters, including the null terminator, a string can store inside of the S_CSHString itself (small string optimisation).
+// Strings which fit are stored inline with m_status set to CSHSSC_USE_SSO and no heap allocation, they move to the heap once they outgrow it.
+// The inline buffer shares its storage with the heap fields (m_strPtr, m_capacity and m_frontSlack), which are also 24 bytes on 64-bit targets.
+#define CSH_STRING_SSO_CAPACITY_M 24
+#define CSH_STRING_DEFAULT_M (S_CSHString){{{NULL, 0, 0}}, 0, 0, (CSH_STRING_MAX_CSTR_CHAR_COUNT_M + 1), NULL, 0, 0, 0, false}
+#define CSH_STRING_ALLOCATOR_M(in_allocator) (S_CSHString){{{NULL, 0, 0}}, 0, 0, (CSH_STRING_MAX_CSTR_CHAR_COUNT_M + 1), in_allocator, 0, 0, 0, false}
+#define CSH_STRING_ERROR_M(in_errorCode) (S_CSHString){{{NULL, 0, 0}}, 0, 0, (CSH_STRING_MAX_CSTR_CHAR_COUNT_M + 1), NULL, 0, 0, in_errorCode, false}
 
 // Need a generalised alloca function, as its definition can change between OS's.
 void* CSH_alloca(size_t in_size);
 
-// Uses either calloc or alloca, depending on the value passed to in_status and whether CSH_ALLOCA_ENABLED = 0 or 1.
-// in_allocaDefault decides whether m_status needs to be explicitly set to CSHSSC_USE_ALLOCA to use alloca.
-// in_allocaDefault = true, means that it does not need to be set to CSHSSC_USE_ALLOCA, false means it does.
-// in_status is passed by reference, with it being set to CSHSSC_USE_ALLOCA if CSH_alloca was used or CSHSSC_NONE if calloc was used.
-// This is a macro function, to ensure CSH_alloca is called on the correct stack frame. 
-#define CSH_STRING_CALLOC_MF(in_ptr, in_num, in_size, in_status, in_allocaDefault) \
-{ \
-    if (in_ptr == NULL) \
-    { \
-        if ((in_num <= (CSH_STRING_MAX_STACK_CHAR_COUNT + 1)) && CSH_STRING_ALLOCA_ENABLED_M && \
-        ((in_allocaDefault && *in_status != CSHSSC_DONT_USE_ALLOCA) || (!in_allocaDefault && *in_status == CSHSSC_USE_ALLOCA))) \
-        { \
-            size_t sizeInBytes = in_num * in_size; \
-            in_ptr = (CSHCharPtr_t)CSH_alloca(sizeInBytes); \
-            \
-            if (in_ptr != NULL) \
-            { \
-                *in_status = CSHSSC_USE_ALLOCA; \
-                for (size_t i = 0; i < sizeInBytes; i++) \
-                { \
-                    *(uint8_t*)(in_ptr + i) = 0; \
-                } \
-            } \
-        } \
-        else \
-        { \
-            if (*in_status == CSHSSC_USE_ALLOCA) \
-            { \
-                *in_status = CSHSSC_NONE; \
-            } \
-            in_ptr = (CSHCharPtr_t)calloc(in_num, in_size); \
-        } \
-    } \
-}
-
 enum E_CSHStringStatusCodes
 {
-    CSHSSC_CSTR_DOESNT_FIT = -3,
+    CSHSSC_IO_FAILED = -6,
+    CSHSSC_READ_ONLY,
+    CSHSSC_ALLOC_FAILED,
+    CSHSSC_CSTR_DOESNT_FIT,
     CSHSSC_BAD_INPUT_ARG,
     CSHSSC_BAD_INPUT_STR,
     CSHSSC_NONE,
     CSHSSC_ALREADY_RESERVED,
     CSHSSC_USE_ALLOCA,
-    CSHSSC_DONT_USE_ALLOCA
+    CSHSSC_DONT_USE_ALLOCA,
+    CSHSSC_USE_SSO,
+    CSHSSC_USE_MMAP
 };
 
 // [ typedef struct S_CSHString ]
+// m_strPtr, m_capacity and m_frontSlack share their storage with m_ssoBuffer, so they're only valid while m_status != CSHSSC_USE_SSO.
+// Use CSH_string_data or CSH_STRING_DATA_MF to access the characters, and CSH_STRING_CAPACITY_MF for the capacity.
 // m_strPtr: Pointer to the string in memory.
-// m_status: The current status of the string.
+// m_capacity: The amount of characters the string can store in its current allocated memory.
+// m_frontSlack: 
+//  The number of unused characters of the heap buffer before m_strPtr, which prepends use instead of moving the contents.
+//  The heap buffer starts at (m_strPtr - m_frontSlack) and is (m_frontSlack + m_capacity) characters long, this is always 0 for alloca and mapped strings.
+// m_ssoBuffer: The inline storage used instead of a heap buffer when m_status == CSHSSC_USE_SSO.
 // m_size: The size of the string not including the null terminator.
 // m_nullSize: The size of the string including the null terminator.
-// m_capacity: The amount of characters the string can store in its current allocated memory.
 // m_maxCstrSize: 
 //  The maximum size a cstr can be, when a CSH string function is called that uses one.
 //  1 is added to this, to account for the null terminating character needed for strnlen.
+// m_allocator: 
+//  The allocator the string's heap memory comes from, NULL means the default allocator. 
+//  This is set to the default allocator the first time the string allocates, so the same allocator is used to free it.
+// m_hash: 
+//  The hash cached by CSH_string_hash_cached, only meaningful while m_hashValid is true.
+//  It's kept in every string so strings used as map keys are only hashed again after they change, at the cost of 8 bytes.
+// m_growthFactorPercent: 
+//  The factor the capacity is multiplied by when an append runs out of room, as a percentage (150 = 1.5x).
+//  0 means the global default set by CSH_string_set_default_growth is used.
+// m_status: 
+//  The current status of the string.
+//  CSHSSC_USE_MMAP means m_strPtr is a read-only mapping of a file (see CSH_string_map_file), which CSH_string_free unmaps.
+// m_hashValid: Cleared by every function which changes the string's characters (see CSH_STRING_INVALIDATE_HASH_MF).
+// The small fields are last so they share one word of padding, which keeps the struct at 72 bytes on 64-bit targets.
 typedef struct 
 {
-    CSHCharPtr_t m_strPtr;
-    int8_t m_status; 
+    union
+    {
+        struct
+        {
+            CSHCharPtr_t m_strPtr;
+            size_t m_capacity;
+            size_t m_frontSlack;
+        };
+        CSHChar_t m_ssoBuffer[CSH_STRING_SSO_CAPACITY_M];
+    };
     size_t m_size;
     size_t m_nullSize;
-    size_t m_capacity;
     size_t m_maxCstrSize;
+    const S_CSHAllocator* m_allocator;
+    uint64_t m_hash;
+    uint16_t m_growthFactorPercent;
+    int8_t m_status; 
+    bool m_hashValid;
 } S_CSHString;
 
+// [ #define CSH_STRING_DATA_MF(in_this) ]
+// Evaluates to a pointer to the characters of in_this, whether they are stored inline or on the heap.
+#define CSH_STRING_DATA_MF(in_this) (((in_this)->m_status == CSHSSC_USE_SSO) ? (in_this)->m_ssoBuffer : (in_this)->m_strPtr)
+
+// [ #define CSH_STRING_CAPACITY_MF(in_this) ]
+// Evaluates to the number of characters in_this can store (including the null terminator), whether they are stored inline or on the heap.
+#define CSH_STRING_CAPACITY_MF(in_this) (((in_this)->m_status == CSHSSC_USE_SSO) ? (size_t)CSH_STRING_SSO_CAPACITY_M : (in_this)->m_capacity)
+
+// [ #define CSH_STRING_IS_HEAP_MF(in_this) ]
+// Whether in_this owns a heap buffer, rather than storing its characters inline, on the stack (alloca) or in a mapped file.
+// Only heap buffers are freed, reallocated or have front slack.
+#define CSH_STRING_IS_HEAP_MF(in_this) ((in_this)->m_status != CSHSSC_USE_SSO && (in_this)->m_status != CSHSSC_USE_ALLOCA && \
+    (in_this)->m_status != CSHSSC_USE_MMAP && (in_this)->m_strPtr != NULL)
+
+// [ #define CSH_STRING_INVALIDATE_HASH_MF(in_this) ]
+// Drops the cached hash of in_this. The CSH string functions do this themselves, 
+// it only needs calling after writing to the characters directly through CSH_string_data or CSH_STRING_DATA_MF.
+#define CSH_STRING_INVALIDATE_HASH_MF(in_this) ((in_this)->m_hashValid = false)
+
+// [ #define CSH_STRING_READ_ONLY_MF(in_this) ]
+// Whether the characters of in_this can't be changed, because they're a mapped file (see CSH_string_map_file).
+// Every function which would change them returns CSHSSC_READ_ONLY instead (NULL for CSH_string_extend, '\0' for CSH_string_pop_char), 
+// and writing through CSH_string_data crashes. CSH_string_create makes a writable copy, copying m_size characters (null characters included).
+#define CSH_STRING_READ_ONLY_MF(in_this) ((in_this)->m_status == CSHSSC_USE_MMAP)
+
 // [ S_CSHString CSH_string_create_cstr(CSHConstCharPtr_t in_str, size_t in_maxSize) ]
 // in_maxSize, is the maximum number of characters not including the null terminating character.
 
 // [ int8_t CSH_string_clear(S_CSHString* in_this, bool in_freeMemory) ]
-// Setting in_freeMemory to true, will both clear the string and the memory it occupies.
+// Setting in_freeMemory to true, will both clear the string and the memory it occupies. A mapped file (CSH_string_map_file) is always unmapped.
 
 // [ int8_t CSH_string_set_max_cstr_size(S_CSHString* in_this, size_t in_maxSize) ]
 // Sets the maximum size in characters, not including the null terminating character, a cstr can be in an operation which contains one.
@@ -109,6 +150,25 @@ int8_t CSH_string_free(S_CSHString* in_this);
 int8_t CSH_string_clear(S_CSHString* in_this, bool in_freeMemory);
 int8_t CSH_string_set_max_cstr_size(S_CSHString* in_this, size_t in_maxSize);
 
+// [ int8_t CSH_string_set_default_growth(uint16_t in_factorPercent, size_t in_minStep) ]
+// Sets the global growth policy used when an append (add_char, concat, insert, etc.) needs more capacity.
+// The new capacity is the larger of (capacity * in_factorPercent / 100) and (capacity + in_minStep), 
+// so appending n characters one at a time costs amortized O(n) instead of O(n^2).
+// in_factorPercent must be at least 100, 100 with an in_minStep of 0 grows by exactly what is needed.
+
+// [ int8_t CSH_string_set_growth_factor(S_CSHString* in_this, uint16_t in_factorPercent) ]
+// Overrides the global growth factor for a single string, 0 reverts it back to the global default.
+
+int8_t CSH_string_set_default_growth(uint16_t in_factorPercent, size_t in_minStep);
+int8_t CSH_string_set_growth_factor(S_CSHString* in_this, uint16_t in_factorPercent);
+
+// [ int8_t CSH_string_set_allocator(S_CSHString* in_this, const S_CSHAllocator* in_allocator) ]
+// Attaches in_allocator to the string, NULL attaches the default allocator.
+// If the string already has heap memory, its contents are moved into memory from in_allocator and the old memory is freed.
+// Strings created from another string (CSH_string_create, CSH_string_create_concat, CSH_string_substr) use that string's allocator.
+
+int8_t CSH_string_set_allocator(S_CSHString* in_this, const S_CSHAllocator* in_allocator);
+
 // [ int8_t CSH_string_cstr_fit(S_CSHString* in_this, CSHConstCharPtr_t in_str) ]
 // Determines whether a cstr's size is within the maximum limit dictated by m_maxCstrSize.
 
@@ -121,6 +181,12 @@ int8_t CSH_string_set_max_cstr_size(S_CSHString* in_this, size_t in_maxSize);
 // [ size_t CSH_string_null_size_bytes(S_CSHString* in_this) ]
 // Does include the null terminating character.
 
+// [ CSHCharPtr_t CSH_string_data(S_CSHString* in_this) ]
+// Returns a pointer to the null terminated characters of the string, or NULL if it has no memory.
+// The pointer is invalidated by any operation which changes the capacity, or by copying/moving the S_CSHString itself while it is stored inline.
+
+CSHCharPtr_t CSH_string_data(S_CSHString* in_this);
+
 int8_t CSH_string_cstr_fit(S_CSHString* in_this, CSHConstCharPtr_t in_str);
 size_t CSH_cstr_size(CSHConstCharPtr_t in_str, size_t in_maxSize);
 size_t CSH_string_size_bytes(S_CSHString* in_this);
@@ -137,16 +203,41 @@ S_CSHString CSH_string_create_concat_cstr(CSHConstCharPtr_t in_strOne, CSHConstC
 S_CSHString CSH_string_create_concat_left_cstr(CSHConstCharPtr_t in_strOne, S_CSHString* in_strTwo);
 S_CSHString CSH_string_create_concat_right_cstr(S_CSHString* in_strOne, CSHConstCharPtr_t in_strTwo);
 
+// [ int8_t CSH_string_concat_left(S_CSHString* in_this, S_CSHString* in_str),
+//   int8_t CSH_string_concat_left_cstr(CSHConstCharPtr_t in_str, S_CSHString* in_this) ]
+// Prepending uses the front slack of the string when there is enough (see CSH_string_reserve_front), otherwise the contents are moved once
+// into a buffer with new front slack proportional to the size of the string, so repeated prepends take amortized constant time per character.
+
 int8_t CSH_string_concat_left(S_CSHString* in_this, S_CSHString* in_str);
 int8_t CSH_string_concat_right(S_CSHString* in_str, S_CSHString* in_this);
 int8_t CSH_string_concat_left_cstr(CSHConstCharPtr_t in_str, S_CSHString* in_this);
 int8_t CSH_string_concat_right_cstr(S_CSHString* in_this, CSHConstCharPtr_t in_str);
 
+// [ int8_t CSH_string_append_format(S_CSHString* in_this, CSHConstCharPtr_t in_format, ...),
+//   int8_t CSH_string_append_vformat(S_CSHString* in_this, CSHConstCharPtr_t in_format, va_list in_args) ]
+// Appends the printf style formatted output to the end of the string, writing it straight into the spare capacity.
+// The string only grows (once) when the measured output doesn't fit, in which case it is formatted a second time.
+// The arguments must not point into in_this. Returns CSHSSC_BAD_INPUT_ARG if the format fails, or CSHSSC_ALLOC_FAILED, leaving the string unchanged.
+
+// [ CSHCharPtr_t CSH_string_extend(S_CSHString* in_this, size_t in_size) ]
+// Grows the string by in_size characters (with the growth policy), returning a pointer to the first of them for the caller to fill in.
+// The new characters are followed by the null terminator, but are otherwise unset. Returns NULL if the string can't grow.
+
+CSHCharPtr_t CSH_string_extend(S_CSHString* in_this, size_t in_size);
+
+int8_t CSH_string_append_format(S_CSHString* in_this, CSHConstCharPtr_t in_format, ...);
+int8_t CSH_string_append_vformat(S_CSHString* in_this, CSHConstCharPtr_t in_format, va_list in_args);
+
 // [ int8_t CSH_string_reserve(S_CSHString* in_this, size_t in_size) ]
 // in_size = number of characters to reserve memory for, not including the null terminator.
+// Reserves exactly in_size, the growth policy is not applied, the existing contents are kept in place with realloc when possible.
+
+// [ int8_t CSH_string_reserve_front(S_CSHString* in_this, size_t in_size) ]
+// in_size = number of characters to reserve in front of the string, for prepends (concat_left) to use without moving the contents.
+// This always moves the string to the heap, returning CSHSSC_ALREADY_RESERVED if it already has at least in_size front slack.
 
 // [ int8_t CSH_string_shrink_to_fit(S_CSHString* in_this) ]
-// Reduces the capacity of the string (memory), so it just fits the strings contents.
+// Reduces the capacity of the string (memory), so it just fits the strings contents, this also drops any front slack.
 
 // [ int8_t CSH_string_resize(S_CSHString* in_this, size_t in_size, CSHChar_t in_char) ]
 // Resize the string so it is in_size characters long, not including the null terminator.
@@ -157,9 +248,22 @@ int8_t CSH_string_add_char(S_CSHString* in_this, CSHChar_t in_char);
 CSHChar_t CSH_string_pop_char(S_CSHString* in_this);
 
 int8_t CSH_string_reserve(S_CSHString* in_this, size_t in_size);
+int8_t CSH_string_reserve_front(S_CSHString* in_this, size_t in_size);
 int8_t CSH_string_resize(S_CSHString* in_this, size_t in_size, CSHChar_t in_char);
 int8_t CSH_string_shrink_to_fit(S_CSHString* in_this);
 
+// [ int8_t CSH_string_splice(S_CSHString* in_this, size_t in_pos, size_t in_len, CSHConstCharPtr_t in_str, size_t in_size) ]
+// Replaces the in_len characters starting at in_pos with the in_size characters of in_str, in place.
+// in_len is clamped to the end of the string, and in_pos may equal the size of the string (appending).
+// The tail is moved with one memmove and the string grows at most once, in_str may point into in_this.
+// insert, erase and replace are all built on this.
+
+// [ int8_t CSH_string_insert(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str),
+//   int8_t CSH_string_insert_cstr(S_CSHString* in_this, size_t in_pos, CSHConstCharPtr_t in_str) ]
+// Inserts in_str before the character at in_pos, in_pos may equal the size of the string (appending).
+
+int8_t CSH_string_splice(S_CSHString* in_this, size_t in_pos, size_t in_len, CSHConstCharPtr_t in_str, size_t in_size);
+
 int8_t CSH_string_insert(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str);
 int8_t CSH_string_insert_cstr(S_CSHString* in_this, size_t in_pos, CSHConstCharPtr_t in_str);
 
@@ -169,6 +273,7 @@ int8_t CSH_string_insert_cstr(S_CSHString* in_this, size_t in_pos, CSHConstCharP
 //   int8_t CSH_string_copy_arr(S_CSHString* in_this, CSHCharPtr_t in_charArr, size_t in_maxNullSize, size_t in_pos, size_t in_len),
 //   S_CSHString CSH_string_substr(S_CSHString* in_this, size_t in_pos, size_t in_len) ]
 // in_len, is the length in characters, not including the null terminating character.
+// replace swaps the in_len characters at in_pos (clamped to the end of the string) for the whole of in_str, so the size can change.
 
 int8_t CSH_string_erase(S_CSHString* in_this, size_t in_pos, size_t in_len);
 int8_t CSH_string_swap(S_CSHString* in_strOne, S_CSHString* in_strTwo);
@@ -179,8 +284,15 @@ int8_t CSH_string_replace_cstr(S_CSHString* in_this, size_t in_pos, size_t in_le
 // [ int8_t CSH_string_copy_arr(S_CSHString* in_this, CSHCharPtr_t in_charArr, size_t in_maxNullSize, size_t in_pos, size_t in_len) ]
 // in_maxNullSize = the maximum number of characters the inputted char array can support, including the null terminating character.
 
+// [ size_t CSH_string_find(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str) ]
+// Find the first occurance of in_str in a string, starting at in_pos.
+// The search uses the stored sizes (see CSHStringKernels.h), so embedded null characters are searched through rather than ending the search.
+// To search for the same needle many times use S_CSHStringSearcher (CSHStringSearcher.h), for many needles at once use S_CSHMatcher (CSHStringMatcher.h).
+// CSH_cstr_find and CSH_cstr_rfind only search the first in_maxSize characters of in_strOne.
+
 // [ size_t CSH_string_rfind_cstr(S_CSHString* in_this, size_t in_pos, CSHConstCharPtr_t in_str) ]
-// Find the last occurance of in_str in a string.
+// Find the last occurance of in_str in a string, at or after in_pos.
+// The search walks backward from the end of the string, so the match nearest the end is found first.
 
 int8_t CSH_string_copy_arr(S_CSHString* in_this, CSHCharPtr_t in_charArr, size_t in_maxNullSize, size_t in_pos, size_t in_len);
 
@@ -198,7 +310,123 @@ int8_t CSH_string_compare(S_CSHString* in_strOne, S_CSHString* in_strTwo);
 int8_t CSH_string_compare_cstr(S_CSHString* in_strOne, CSHConstCharPtr_t in_strTwo);
 int8_t CSH_cstr_compare(CSHConstCharPtr_t in_strOne, size_t in_maxSize, CSHConstCharPtr_t in_strTwo);
 
+// [ int CSH_string_cmp(S_CSHString* in_strOne, S_CSHString* in_strTwo) ]
+// Three way lexicographic comparison for sorting and binary searching, returns <0, 0 or >0 like memcmp (characters compare as unsigned).
+// A string which is a prefix of the other orders first. NULL (or invalid) strings order before every valid string.
+// The stored sizes are used, so nothing is rescanned, and the CSH_string_compare equality checks bail on a size mismatch without touching the characters.
+
+// CSH_string_cmp_cstr orders a cstr which doesn't fit within in_strOne's m_maxCstrSize after in_strOne, unless the characters which fit already differ 
+// (where CSH_string_compare_cstr would return CSHSSC_CSTR_DOESNT_FIT).
+
+int CSH_string_cmp(S_CSHString* in_strOne, S_CSHString* in_strTwo);
+int CSH_string_cmp_cstr(S_CSHString* in_strOne, CSHConstCharPtr_t in_strTwo);
+int CSH_cstr_cmp(CSHConstCharPtr_t in_strOne, size_t in_maxSize, CSHConstCharPtr_t in_strTwo);
+
+// [ int8_t CSH_string_to_lower(S_CSHString* in_this), int8_t CSH_string_to_upper(S_CSHString* in_this) ]
+// Only ASCII letters are mapped, any other characters are left as they are.
+
 int8_t CSH_string_to_lower(S_CSHString* in_this);
 int8_t CSH_string_to_upper(S_CSHString* in_this);
 
+// [ uint64_t CSH_string_hash(S_CSHString* in_this), uint64_t CSH_string_hash_cached(S_CSHString* in_this) ]
+// Hashes the characters of the string with CSH_kernel_hash (seed 0), for use as a hash table key.
+// CSH_string_hash_cached also stores the result in the string, so hashing it again is O(1) until the string is next changed.
+// CSH_string_hash uses the cached hash when there is one, but never stores it.
+
+uint64_t CSH_string_hash(S_CSHString* in_this);
+uint64_t CSH_string_hash_cached(S_CSHString* in_this);
+
+// [ int8_t CSH_string_compare_icase(S_CSHString* in_strOne, S_CSHString* in_strTwo),
+//   size_t CSH_string_find_icase(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str),
+//   uint64_t CSH_string_hash_icase(S_CSHString* in_this) ]
+// Case insensitive versions of compare and find, ignoring the case of ASCII letters.
+// Case is folded on the fly, so no lowered copies are made.
+// Strings which compare equal ignoring case produce the same CSH_string_hash_icase.
+
+int8_t CSH_string_compare_icase(S_CSHString* in_strOne, S_CSHString* in_strTwo);
+int8_t CSH_string_compare_icase_cstr(S_CSHString* in_strOne, CSHConstCharPtr_t in_strTwo);
+size_t CSH_string_find_icase(S_CSHString* in_this, size_t in_pos, S_CSHString* in_str);
+size_t CSH_string_find_icase_cstr(S_CSHString* in_this, size_t in_pos, CSHConstCharPtr_t in_str);
+uint64_t CSH_string_hash_icase(S_CSHString* in_this);
+
+// [ typedef struct S_CSHStringView ]
+// A non-owning, read-only window onto characters stored elsewhere (a S_CSHString, cstr, or any buffer), which is never null terminated.
+// Views never allocate, so they are passed by value, and are only valid while the memory they point to is.
+// A view of a S_CSHString is invalidated by anything which changes the string's capacity, or by moving the string while it's stored inline (SSO).
+// m_strPtr: Pointer to the first character, NULL for an invalid view.
+// m_size: The number of characters in the view.
+typedef struct
+{
+    CSHConstCharPtr_t m_strPtr;
+    size_t m_size;
+} S_CSHStringView;
+
+#define CSH_STRING_VIEW_DEFAULT_M (S_CSHStringView){NULL, 0}
+
+// [ S_CSHStringView CSH_string_view_cstr(CSHConstCharPtr_t in_str, size_t in_maxSize) ]
+// in_maxSize = the maximum size of the cstr in characters, not including the null terminator, an invalid view is returned if it's longer.
+
+// [ S_CSHStringView CSH_string_view_buffer(CSHConstCharPtr_t in_ptr, size_t in_size) ]
+// Views in_size characters starting at in_ptr, which don't need to be null terminated and can contain null characters.
+
+// [ S_CSHStringView CSH_string_substr_view(S_CSHString* in_this, size_t in_pos, size_t in_len),
+//   S_CSHStringView CSH_string_view_substr(S_CSHStringView in_view, size_t in_pos, size_t in_len) ]
+// Zero copy versions of CSH_string_substr, in_len is clamped to the end of the string.
+// An invalid view is returned if in_pos is out of range.
+
+// [ size_t CSH_string_view_find(S_CSHStringView in_view, size_t in_pos, S_CSHStringView in_str),
+//   size_t CSH_string_view_rfind(S_CSHStringView in_view, size_t in_pos, S_CSHStringView in_str) ]
+// Same as CSH_string_find and CSH_string_rfind, using the stored sizes rather than null terminators.
+
+// [ int8_t CSH_string_view_compare(S_CSHStringView in_viewOne, S_CSHStringView in_viewTwo) ]
+// Returns CSHSSC_NONE if the views contain the same characters, otherwise CSHSSC_BAD_INPUT_ARG.
+// CSH_string_view_cmp is the three way version, same as CSH_string_cmp.
+// CSH_string_view_hash gives the same result as CSH_string_hash for the same characters.
+
+// [ int8_t CSH_string_view_compare_icase(S_CSHStringView in_viewOne, S_CSHStringView in_viewTwo),
+//   size_t CSH_string_view_find_icase(S_CSHStringView in_view, size_t in_pos, S_CSHStringView in_str),
+//   uint64_t CSH_string_view_hash_icase(S_CSHStringView in_view) ]
+// Same as CSH_string_compare_icase, CSH_string_find_icase and CSH_string_hash_icase.
+
+// [ S_CSHString CSH_string_create_view(S_CSHStringView in_view) ]
+// Copies the contents of the view into a new owning string.
+
+S_CSHStringView CSH_string_view(S_CSHString* in_this);
+S_CSHStringView CSH_string_view_cstr(CSHConstCharPtr_t in_str, size_t in_maxSize);
+S_CSHStringView CSH_string_view_buffer(CSHConstCharPtr_t in_ptr, size_t in_size);
+
+S_CSHStringView CSH_string_substr_view(S_CSHString* in_this, size_t in_pos, size_t in_len);
+S_CSHStringView CSH_string_view_substr(S_CSHStringView in_view, size_t in_pos, size_t in_len);
+
+size_t CSH_string_view_find(S_CSHStringView in_view, size_t in_pos, S_CSHStringView in_str);
+size_t CSH_string_view_rfind(S_CSHStringView in_view, size_t in_pos, S_CSHStringView in_str);
+int8_t CSH_string_view_compare(S_CSHStringView in_viewOne, S_CSHStringView in_viewTwo);
+int CSH_string_view_cmp(S_CSHStringView in_viewOne, S_CSHStringView in_viewTwo);
+uint64_t CSH_string_view_hash(S_CSHStringView in_view);
+
+int8_t CSH_string_view_compare_icase(S_CSHStringView in_viewOne, S_CSHStringView in_viewTwo);
+size_t CSH_string_view_find_icase(S_CSHStringView in_view, size_t in_pos, S_CSHStringView in_str);
+uint64_t CSH_string_view_hash_icase(S_CSHStringView in_view);
+
+S_CSHString CSH_string_create_view(S_CSHStringView in_view);
+
+// [ S_CSHString CSH_string_join(const S_CSHStringView* in_pieces, size_t in_count, S_CSHStringView in_separator),
+//   S_CSHString CSH_string_join_strings(const S_CSHString* in_strs, size_t in_count, S_CSHStringView in_separator),
+//   S_CSHString CSH_string_join_cstrs(const CSHConstCharPtr_t* in_strs, size_t in_count, size_t in_maxSize, S_CSHStringView in_separator) ]
+// Concatenates in_count pieces with in_separator between each pair, pass CSH_STRING_VIEW_DEFAULT_M for no separator.
+// The exact total size is worked out first, so the result is allocated once and each piece copied once, 
+// instead of the N - 1 intermediate strings made by chaining CSH_string_create_concat.
+// For a GenericVector, pass its m_data and m_size. in_maxSize bounds each cstr the same way as CSH_string_create_cstr.
+// For a mix of strings, views and cstrs, see S_CSHStringBuilder.
+
+// [ int8_t CSH_string_append_join(S_CSHString* in_this, const S_CSHStringView* in_pieces, size_t in_count, S_CSHStringView in_separator) ]
+// Same as CSH_string_join, appending to in_this, which grows at most once. 
+// Clearing and reusing the same string (e.g. once per CSV line) avoids allocating at all once it's large enough.
+// The pieces and the separator may view in_this itself, they're copied from the contents it had before the append.
+
+S_CSHString CSH_string_join(const S_CSHStringView* in_pieces, size_t in_count, S_CSHStringView in_separator);
+S_CSHString CSH_string_join_strings(const S_CSHString* in_strs, size_t in_count, S_CSHStringView in_separator);
+S_CSHString CSH_string_join_cstrs(const CSHConstCharPtr_t* in_strs, size_t in_count, size_t in_maxSize, S_CSHStringView in_separator);
+int8_t CSH_string_append_join(S_CSHString* in_this, const S_CSHStringView* in_pieces, size_t in_count, S_CSHStringView in_separator);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "CSHStringBuilder.h"
+#include "CSHGeneralUtils.h"
+#include <string.h>
+
+#define CSH_BUILDER_MIN_PIECES_M 16
+
+static int8_t CSH_internal_builder_set_capacity(S_CSHStringBuilder* in_this, size_t in_capacity)
+{
+    S_CSHStringView* newPieces = (S_CSHStringView*)CSH_allocator_realloc(in_this->m_allocator, in_this->m_pieces, 
+        in_this->m_capacity * sizeof(S_CSHStringView), in_capacity * sizeof(S_CSHStringView));
+    if (newPieces == NULL)
+    {
+        return CSHSSC_ALLOC_FAILED;
+    }
+
+    in_this->m_pieces = newPieces;
+    in_this->m_capacity = in_capacity;
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_builder_init(S_CSHStringBuilder* in_this, size_t in_pieceCount, const S_CSHAllocator* in_allocator)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    in_this->m_pieces = NULL;
+    in_this->m_count = 0;
+    in_this->m_capacity = 0;
+    in_this->m_size = 0;
+    in_this->m_maxCstrSize = CSH_STRING_MAX_CSTR_CHAR_COUNT_M + 1;
+    in_this->m_allocator = CSH_allocator_resolve(in_allocator);
+
+    if (in_pieceCount > 0)
+    {
+        return CSH_internal_builder_set_capacity(in_this, in_pieceCount);
+    }
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_builder_free(S_CSHStringBuilder* in_this)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    CSH_allocator_free(in_this->m_allocator, in_this->m_pieces, in_this->m_capacity * sizeof(S_CSHStringView));
+    in_this->m_pieces = NULL;
+    in_this->m_count = 0;
+    in_this->m_capacity = 0;
+    in_this->m_size = 0;
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_builder_clear(S_CSHStringBuilder* in_this)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    in_this->m_count = 0;
+    in_this->m_size = 0;
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_builder_add(S_CSHStringBuilder* in_this, S_CSHStringView in_view)
+{
+    if (in_this == NULL || in_view.m_strPtr == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    if (in_this->m_count == in_this->m_capacity)
+    {
+        size_t newCapacity = (in_this->m_capacity > 0) ? (in_this->m_capacity * 2) : CSH_BUILDER_MIN_PIECES_M;
+        if (CSH_internal_builder_set_capacity(in_this, newCapacity) < 0)
+        {
+            return CSHSSC_ALLOC_FAILED;
+        }
+    }
+
+    in_this->m_pieces[in_this->m_count++] = in_view;
+    in_this->m_size += in_view.m_size;
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_builder_add_string(S_CSHStringBuilder* in_this, S_CSHString* in_str)
+{
+    return CSH_builder_add(in_this, CSH_string_view(in_str));
+}
+
+int8_t CSH_builder_add_cstr(S_CSHStringBuilder* in_this, CSHConstCharPtr_t in_str)
+{
+    if (in_this == NULL || in_str == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    size_t result = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
+    if (result == in_this->m_maxCstrSize)
+    {
+        return CSHSSC_CSTR_DOESNT_FIT;
+    }
+
+    return CSH_builder_add(in_this, CSH_string_view_buffer(in_str, result));
+}
+
+size_t CSH_builder_size(const S_CSHStringBuilder* in_this, S_CSHStringView in_separator)
+{
+    if (in_this == NULL)
+    {
+        return 0;
+    }
+
+    size_t separatorSize = (in_separator.m_strPtr != NULL) ? in_separator.m_size : 0;
+    return in_this->m_size + ((in_this->m_count > 0) ? ((in_this->m_count - 1) * separatorSize) : 0);
+}
+
+S_CSHString CSH_builder_build(const S_CSHStringBuilder* in_this, S_CSHStringView in_separator)
+{
+    if (in_this == NULL)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_ARG);
+    }
+
+    return CSH_string_join(in_this->m_pieces, in_this->m_count, in_separator);
+}
+
+int8_t CSH_builder_append_to(const S_CSHStringBuilder* in_this, S_CSHString* io_str, S_CSHStringView in_separator)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    return CSH_string_append_join(io_str, in_this->m_pieces, in_this->m_count, in_separator);
+}
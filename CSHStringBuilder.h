@@ -0,0 +1,59 @@
+#ifndef CSH_STRING_BUILDER_H
+#define CSH_STRING_BUILDER_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "CSHAllocator.h"
+#include "CSHString.h"
+
+// [ typedef struct S_CSHStringBuilder ]
+// Collects views of the pieces of a string (from S_CSHStrings, views and cstrs), then joins them with a single allocation.
+// Only the views are stored, so the pieces must stay valid and unchanged until the string is built.
+// m_pieces: The views of the pieces added so far, in order.
+// m_count: The number of pieces added.
+// m_capacity: The number of views m_pieces has room for.
+// m_size: The total size of the pieces in characters, not including separators.
+// m_maxCstrSize: The maximum size of a cstr passed to CSH_builder_add_cstr, plus 1, the same as S_CSHString's m_maxCstrSize.
+// m_allocator: The allocator m_pieces comes from.
+typedef struct
+{
+    S_CSHStringView* m_pieces;
+    size_t m_count;
+    size_t m_capacity;
+    size_t m_size;
+    size_t m_maxCstrSize;
+    const S_CSHAllocator* m_allocator;
+} S_CSHStringBuilder;
+
+// [ int8_t CSH_builder_init(S_CSHStringBuilder* in_this, size_t in_pieceCount, const S_CSHAllocator* in_allocator) ]
+// Creates an empty builder with room for in_pieceCount pieces, using in_allocator (NULL uses the default allocator).
+
+// [ int8_t CSH_builder_free(S_CSHStringBuilder* in_this),
+//   int8_t CSH_builder_clear(S_CSHStringBuilder* in_this) ]
+// Clearing removes all the pieces but keeps the memory, so one builder can be reused for every line of a file.
+
+int8_t CSH_builder_init(S_CSHStringBuilder* in_this, size_t in_pieceCount, const S_CSHAllocator* in_allocator);
+int8_t CSH_builder_free(S_CSHStringBuilder* in_this);
+int8_t CSH_builder_clear(S_CSHStringBuilder* in_this);
+
+// [ int8_t CSH_builder_add(S_CSHStringBuilder* in_this, S_CSHStringView in_view),
+//   int8_t CSH_builder_add_string(S_CSHStringBuilder* in_this, S_CSHString* in_str),
+//   int8_t CSH_builder_add_cstr(S_CSHStringBuilder* in_this, CSHConstCharPtr_t in_str) ]
+// Adds a piece to the end. The cstr is measured once here, bounded by m_maxCstrSize, returning CSHSSC_CSTR_DOESNT_FIT if it's too long.
+
+int8_t CSH_builder_add(S_CSHStringBuilder* in_this, S_CSHStringView in_view);
+int8_t CSH_builder_add_string(S_CSHStringBuilder* in_this, S_CSHString* in_str);
+int8_t CSH_builder_add_cstr(S_CSHStringBuilder* in_this, CSHConstCharPtr_t in_str);
+
+// [ size_t CSH_builder_size(const S_CSHStringBuilder* in_this, S_CSHStringView in_separator) ]
+// Returns the size in characters of the string the builder would build, with in_separator between each pair of pieces.
+
+// [ S_CSHString CSH_builder_build(const S_CSHStringBuilder* in_this, S_CSHStringView in_separator),
+//   int8_t CSH_builder_append_to(const S_CSHStringBuilder* in_this, S_CSHString* io_str, S_CSHStringView in_separator) ]
+// Same as CSH_string_join and CSH_string_append_join with the builder's pieces, pass CSH_STRING_VIEW_DEFAULT_M for no separator.
+
+size_t CSH_builder_size(const S_CSHStringBuilder* in_this, S_CSHStringView in_separator);
+S_CSHString CSH_builder_build(const S_CSHStringBuilder* in_this, S_CSHStringView in_separator);
+int8_t CSH_builder_append_to(const S_CSHStringBuilder* in_this, S_CSHString* io_str, S_CSHStringView in_separator);
+
+#endif
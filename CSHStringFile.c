@@ -0,0 +1,249 @@
+#ifndef _WIN32
+#define _DEFAULT_SOURCE
+#endif
+#include "CSHStringFile.h"
+#include "CSHStringKernels.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+// Reads all in_size bytes of in_file into an ordinary heap string.
+static S_CSHString CSH_internal_file_read(HANDLE in_file, size_t in_size)
+{
+    S_CSHString tempStr = CSH_STRING_DEFAULT_M;
+    CSHCharPtr_t output = CSH_string_extend(&tempStr, in_size);
+    if (output == NULL)
+    {
+        CSH_string_free(&tempStr);
+        return CSH_STRING_ERROR_M(CSHSSC_ALLOC_FAILED);
+    }
+
+    size_t done = 0;
+    while (done < in_size)
+    {
+        DWORD chunk = ((in_size - done) > 0x40000000) ? 0x40000000 : (DWORD)(in_size - done);
+        DWORD read = 0;
+        if (!ReadFile(in_file, output + done, chunk, &read, NULL) || read == 0)
+        {
+            CSH_string_free(&tempStr);
+            return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_ARG);
+        }
+        done += read;
+    }
+
+    return tempStr;
+}
+#endif
+
+S_CSHString CSH_string_map_file(CSHConstCharPtr_t in_path, uint32_t in_flags)
+{
+    if (in_path == NULL)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_STR);
+    }
+
+    CSHCharPtr_t mapping = NULL;
+    size_t size = 0;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(in_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 
+        (in_flags & CSHFMF_SEQUENTIAL) ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_ARG);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || (unsigned long long)fileSize.QuadPart >= (unsigned long long)SIZE_MAX)
+    {
+        CloseHandle(file);
+        return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_ARG);
+    }
+    size = (size_t)fileSize.QuadPart;
+    if (size == 0)
+    {
+        CloseHandle(file);
+        return CSH_STRING_DEFAULT_M;
+    }
+
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    if ((size % systemInfo.dwPageSize) == 0)
+    {
+        S_CSHString tempStr = CSH_internal_file_read(file, size);
+        CloseHandle(file);
+        return tempStr;
+    }
+
+    // The view keeps the file mapping open, so both handles can be closed straight away.
+    HANDLE fileMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (fileMapping != NULL)
+    {
+        mapping = (CSHCharPtr_t)MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(fileMapping);
+    }
+    CloseHandle(file);
+    if (mapping == NULL)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_ALLOC_FAILED);
+    }
+#else
+    int fileDescriptor = open(in_path, O_RDONLY);
+    if (fileDescriptor < 0)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_ARG);
+    }
+
+    struct stat fileInfo;
+    if (fstat(fileDescriptor, &fileInfo) != 0 || !S_ISREG(fileInfo.st_mode) || (unsigned long long)fileInfo.st_size >= (unsigned long long)SIZE_MAX)
+    {
+        close(fileDescriptor);
+        return CSH_STRING_ERROR_M(CSHSSC_BAD_INPUT_ARG);
+    }
+    size = (size_t)fileInfo.st_size;
+    if (size == 0)
+    {
+        close(fileDescriptor);
+        return CSH_STRING_DEFAULT_M;
+    }
+
+    // The rest of the file's last page reads as zeros, which terminates the string. 
+    // When the file fills its last page exactly, a zero page is reserved first and the file is mapped over all but the end of it.
+    void* tempPtr = MAP_FAILED;
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    if ((size % pageSize) == 0)
+    {
+        void* reserved = mmap(NULL, size + 1, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved != MAP_FAILED)
+        {
+            tempPtr = mmap(reserved, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fileDescriptor, 0);
+            if (tempPtr == MAP_FAILED)
+            {
+                munmap(reserved, size + 1);
+            }
+        }
+    }
+    else
+    {
+        tempPtr = mmap(NULL, size + 1, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    }
+    close(fileDescriptor);
+    if (tempPtr == MAP_FAILED)
+    {
+        return CSH_STRING_ERROR_M(CSHSSC_ALLOC_FAILED);
+    }
+    mapping = (CSHCharPtr_t)tempPtr;
+
+    #ifdef MADV_SEQUENTIAL
+        if (in_flags & CSHFMF_SEQUENTIAL)
+        {
+            madvise(tempPtr, size, MADV_SEQUENTIAL);
+        }
+    #endif
+    #ifdef MADV_HUGEPAGE
+        if (in_flags & CSHFMF_HUGE_PAGES)
+        {
+            madvise(tempPtr, size, MADV_HUGEPAGE);
+        }
+    #endif
+    #ifdef MADV_WILLNEED
+        if (in_flags & CSHFMF_WILL_NEED)
+        {
+            madvise(tempPtr, size, MADV_WILLNEED);
+        }
+    #endif
+#endif
+
+    S_CSHString tempStr = CSH_STRING_DEFAULT_M;
+    tempStr.m_strPtr = mapping;
+    tempStr.m_status = CSHSSC_USE_MMAP;
+    tempStr.m_size = size;
+    tempStr.m_nullSize = size + 1;
+    tempStr.m_capacity = size + 1;
+
+    return tempStr;
+}
+
+int8_t CSH_string_unmap_file(S_CSHString* in_this)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+    if (in_this->m_status != CSHSSC_USE_MMAP)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    // The unmapping itself lives in CSHString.c, so CSH_string_free works without this file.
+    return CSH_string_free(in_this);
+}
+
+int8_t CSH_lines_init(S_CSHLineIterator* in_this, S_CSHStringView in_view)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+    if (in_view.m_strPtr == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    in_this->m_view = in_view;
+    in_this->m_pos = 0;
+    in_this->m_blockPos = 0;
+    in_this->m_mask = CSH_kernel_match_byte64(in_view.m_strPtr, in_view.m_size, '\n');
+    in_this->m_done = (in_view.m_size == 0);
+
+    return CSHSSC_NONE;
+}
+
+bool CSH_lines_next(S_CSHLineIterator* in_this, S_CSHStringView* out_line)
+{
+    if (in_this == NULL || out_line == NULL || in_this->m_done)
+    {
+        return false;
+    }
+
+    size_t size = in_this->m_view.m_size;
+    while (in_this->m_mask == 0 && (in_this->m_blockPos + 64) < size)
+    {
+        in_this->m_blockPos += 64;
+        in_this->m_mask = CSH_kernel_match_byte64(in_this->m_view.m_strPtr + in_this->m_blockPos, size - in_this->m_blockPos, '\n');
+    }
+
+    size_t end = size;
+    if (in_this->m_mask != 0)
+    {
+        end = in_this->m_blockPos + CSH_kernel_ctz64(in_this->m_mask);
+        in_this->m_mask &= (in_this->m_mask - 1);
+    }
+    else
+    {
+        in_this->m_done = true;
+        if (in_this->m_pos == size)
+        {
+            return false;
+        }
+    }
+
+    CSHConstCharPtr_t start = in_this->m_view.m_strPtr + in_this->m_pos;
+    size_t lineSize = end - in_this->m_pos;
+    if (lineSize > 0 && start[lineSize - 1] == '\r')
+    {
+        lineSize--;
+    }
+
+    *out_line = CSH_string_view_buffer(start, lineSize);
+    in_this->m_pos = end + 1;
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef CSH_STRING_FILE_H
+#define CSH_STRING_FILE_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "CSHString.h"
+
+enum E_CSHFileMapFlags
+{
+    CSHFMF_NONE = 0,
+    // The file will be read front to back (MADV_SEQUENTIAL, FILE_FLAG_SEQUENTIAL_SCAN), so the OS reads further ahead and drops pages behind the reader sooner.
+    CSHFMF_SEQUENTIAL = 1 << 0,
+    // Asks for the mapping to be backed by huge pages where the kernel supports it for files (MADV_HUGEPAGE), for fewer TLB misses over a large file.
+    CSHFMF_HUGE_PAGES = 1 << 1,
+    // Starts reading the whole file in straight away (MADV_WILLNEED), rather than as each page is first touched.
+    CSHFMF_WILL_NEED = 1 << 2
+};
+
+// [ S_CSHString CSH_string_map_file(CSHConstCharPtr_t in_path, uint32_t in_flags) ]
+// Maps the file at in_path into memory as a read-only string (m_status == CSHSSC_USE_MMAP), without copying it.
+// The OS reads pages in as they're touched and can drop them again under memory pressure, so a multi-GB file costs no heap memory.
+// in_flags is a combination of E_CSHFileMapFlags, hints which are ignored where the platform doesn't support them.
+// The string is null terminated (past its end, with a zero page where the file fills its last page), and can contain null characters.
+// Every function which would change it returns CSHSSC_READ_ONLY (see CSH_STRING_READ_ONLY_MF), 
+// CSH_string_create makes a writable heap copy (including any null characters in the file).
+// Free it with CSH_string_free, which unmaps it. The file must not be truncated while it's mapped.
+// An empty file gives an ordinary empty string, and on Windows, a file which exactly fills its last page is read into an ordinary heap string,
+// since there's no room left in the mapping for the terminator.
+// Returns a string with m_status set to CSHSSC_BAD_INPUT_STR for a NULL path, CSHSSC_BAD_INPUT_ARG if the file couldn't be opened
+// (or isn't a regular file), or CSHSSC_ALLOC_FAILED if it couldn't be mapped.
+
+// [ int8_t CSH_string_unmap_file(S_CSHString* in_this) ]
+// Unmaps a string returned by CSH_string_map_file, leaving it empty. The same as CSH_string_free, which unmaps mapped strings itself.
+// Returns CSHSSC_BAD_INPUT_ARG if in_this isn't a mapped file.
+
+S_CSHString CSH_string_map_file(CSHConstCharPtr_t in_path, uint32_t in_flags);
+int8_t CSH_string_unmap_file(S_CSHString* in_this);
+
+// [ typedef struct S_CSHLineIterator ]
+// Iterates over the lines of a view (such as a mapped file) as views into it, without copying.
+// Newlines are found 64 bytes at a time (CSH_kernel_match_byte64), then each line is one bit scan of the cached mask, 
+// so short lines don't pay for a memchr call each.
+// m_view: The view being iterated.
+// m_pos: Where the next line starts.
+// m_blockPos: The start of the 64 byte block m_mask covers.
+// m_mask: Bit i is set for each newline at m_blockPos + i which hasn't been returned yet.
+// m_done: Whether the last line has been returned.
+typedef struct
+{
+    S_CSHStringView m_view;
+    size_t m_pos;
+    size_t m_blockPos;
+    uint64_t m_mask;
+    bool m_done;
+} S_CSHLineIterator;
+
+// [ int8_t CSH_lines_init(S_CSHLineIterator* in_this, S_CSHStringView in_view) ]
+// Starts iterating over the lines of in_view, use CSH_string_view for a S_CSHString.
+// Returns CSHSSC_BAD_INPUT_STR for an invalid view.
+
+// [ bool CSH_lines_next(S_CSHLineIterator* in_this, S_CSHStringView* out_line) ]
+// Finds the next line, without its "\n" or "\r\n", returning false once there are no more.
+// A newline at the end of the view doesn't start another line, so "a\nb\n" and "a\nb" both give "a" and "b", and an empty view gives none.
+//
+// S_CSHString file = CSH_string_map_file("app.log", CSHFMF_SEQUENTIAL);
+// S_CSHLineIterator lines;
+// CSH_lines_init(&lines, CSH_string_view(&file));
+// S_CSHStringView line;
+// while (CSH_lines_next(&lines, &line))
+// {
+// }
+// CSH_string_free(&file);
+
+int8_t CSH_lines_init(S_CSHLineIterator* in_this, S_CSHStringView in_view);
+bool CSH_lines_next(S_CSHLineIterator* in_this, S_CSHStringView* out_line);
+
+#endif
@@ -0,0 +1,188 @@
+#include "CSHStringIntern.h"
+#include "CSHGeneralUtils.h"
+#include "CSHStringKernels.h"
+#include <string.h>
+
+#define CSH_INTERN_MIN_ENTRIES_M 64
+
+// The entry map's functions are inline in CSHStringIntern.h, these declarations emit their external definitions here, 
+// for calls the compiler doesn't inline.
+extern inline const S_CSHAllocator* map_allocator_CSHInternHash_handle(S_MapData_CSHInternHash_handle* in_map);
+extern inline void map_set_ctrl_CSHInternHash_handle(S_MapData_CSHInternHash_handle* in_map, size_t in_index, uint8_t in_ctrl);
+extern inline size_t map_find_free_CSHInternHash_handle(const S_MapData_CSHInternHash_handle* in_map, uint64_t in_hash);
+extern inline bool map_rehash_CSHInternHash_handle(S_MapData_CSHInternHash_handle* in_map, size_t in_capacity);
+extern inline bool map_reserve_CSHInternHash_handle(S_MapData_CSHInternHash_handle* in_map, size_t in_size);
+extern inline S_MapEntry_CSHInternHash_handle* map_find_CSHInternHash_handle(const S_MapData_CSHInternHash_handle* in_map, S_CSHInternLookup in_key);
+extern inline S_MapEntry_CSHInternHash_handle* map_insert_CSHInternHash_handle(S_MapData_CSHInternHash_handle* in_map, 
+    uint64_t in_key, CSHInternHandle_t in_value);
+extern inline bool map_erase_CSHInternHash_handle(S_MapData_CSHInternHash_handle* in_map, S_CSHInternLookup in_key);
+extern inline void map_clear_CSHInternHash_handle(S_MapData_CSHInternHash_handle* in_map);
+extern inline S_MapEntry_CSHInternHash_handle* map_next_CSHInternHash_handle(const S_MapData_CSHInternHash_handle* in_map, size_t* io_index);
+
+// Copies in_size characters (plus a null terminator) into the pool's chunks, returns NULL on failure.
+static CSHCharPtr_t CSH_internal_intern_store(S_CSHInternPool* in_pool, CSHConstCharPtr_t in_str, size_t in_size)
+{
+    size_t nullSize = in_size + 1;
+    if ((size_t)(in_pool->m_end - in_pool->m_cursor) < nullSize)
+    {
+        // Strings bigger than a chunk get a chunk of their own, leaving the current chunk to be filled by later strings.
+        if (nullSize > CSH_INTERN_CHUNK_SIZE_M)
+        {
+            CSHCharPtr_t tempPtr = (CSHCharPtr_t)CSH_arena_alloc(&in_pool->m_arena, nullSize * CSH_CHAR_SIZE);
+            if (tempPtr != NULL)
+            {
+                memcpy(tempPtr, in_str, in_size * CSH_CHAR_SIZE);
+                tempPtr[in_size] = '\0';
+            }
+            return tempPtr;
+        }
+
+        CSHCharPtr_t chunk = (CSHCharPtr_t)CSH_arena_alloc(&in_pool->m_arena, CSH_INTERN_CHUNK_SIZE_M * CSH_CHAR_SIZE);
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+        in_pool->m_cursor = chunk;
+        in_pool->m_end = chunk + CSH_INTERN_CHUNK_SIZE_M;
+    }
+
+    CSHCharPtr_t result = in_pool->m_cursor;
+    memcpy(result, in_str, in_size * CSH_CHAR_SIZE);
+    result[in_size] = '\0';
+    in_pool->m_cursor += nullSize;
+
+    return result;
+}
+
+int8_t CSH_intern_init(S_CSHInternPool* in_pool, const S_CSHAllocator* in_allocator)
+{
+    if (in_pool == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    memset(in_pool, 0, sizeof(S_CSHInternPool));
+    in_pool->m_maxCstrSize = CSH_STRING_MAX_CSTR_CHAR_COUNT_M + 1;
+    in_pool->m_allocator = CSH_allocator_resolve(in_allocator);
+    in_pool->m_table = G_MAP_DATA_ALLOCATOR_M(CSHInternHash_handle, in_pool->m_allocator);
+
+    // Each block holds exactly one chunk after its header, so a chunk never leaves the rest of a block unused.
+    return CSH_arena_init(&in_pool->m_arena, (CSH_ARENA_BLOCK_HEADER_SIZE_M + (CSH_INTERN_CHUNK_SIZE_M * CSH_CHAR_SIZE)), CSHAF_NONE);
+}
+
+int8_t CSH_intern_release(S_CSHInternPool* in_pool)
+{
+    if (in_pool == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    CSH_arena_release(&in_pool->m_arena);
+    CSH_allocator_free(in_pool->m_allocator, in_pool->m_entries, in_pool->m_entryCapacity * sizeof(S_CSHInternEntry));
+    map_clear_CSHInternHash_handle(&in_pool->m_table);
+
+    in_pool->m_cursor = NULL;
+    in_pool->m_end = NULL;
+    in_pool->m_entries = NULL;
+    in_pool->m_count = 0;
+    in_pool->m_entryCapacity = 0;
+
+    return CSHSSC_NONE;
+}
+
+CSHInternHandle_t CSH_intern_view(S_CSHInternPool* in_pool, S_CSHStringView in_view)
+{
+    if (in_pool == NULL || in_view.m_strPtr == NULL)
+    {
+        return CSH_INTERN_INVALID_HANDLE_M;
+    }
+    if (in_pool->m_count >= (UINT32_MAX - 1))
+    {
+        return CSH_INTERN_INVALID_HANDLE_M;
+    }
+
+    S_CSHInternLookup lookup = {in_pool->m_entries, in_view.m_strPtr, in_view.m_size, CSH_kernel_hash(in_view.m_strPtr, in_view.m_size, 0)};
+    const S_MapEntry_CSHInternHash_handle* found = map_find_CSHInternHash_handle(&in_pool->m_table, lookup);
+    if (found != NULL)
+    {
+        return found->m_value;
+    }
+
+    if (in_pool->m_count == in_pool->m_entryCapacity)
+    {
+        size_t newCapacity = (in_pool->m_entryCapacity > 0) ? (in_pool->m_entryCapacity * 2) : CSH_INTERN_MIN_ENTRIES_M;
+        S_CSHInternEntry* newEntries = (S_CSHInternEntry*)CSH_allocator_realloc(in_pool->m_allocator, in_pool->m_entries, 
+            in_pool->m_entryCapacity * sizeof(S_CSHInternEntry), newCapacity * sizeof(S_CSHInternEntry));
+        if (newEntries == NULL)
+        {
+            return CSH_INTERN_INVALID_HANDLE_M;
+        }
+        in_pool->m_entries = newEntries;
+        in_pool->m_entryCapacity = newCapacity;
+    }
+
+    CSHCharPtr_t stored = CSH_internal_intern_store(in_pool, in_view.m_strPtr, in_view.m_size);
+    if (stored == NULL)
+    {
+        return CSH_INTERN_INVALID_HANDLE_M;
+    }
+
+    CSHInternHandle_t handle = (CSHInternHandle_t)(in_pool->m_count + 1);
+    if (map_insert_CSHInternHash_handle(&in_pool->m_table, lookup.m_hash, handle) == NULL)
+    {
+        return CSH_INTERN_INVALID_HANDLE_M;
+    }
+    in_pool->m_entries[in_pool->m_count] = (S_CSHInternEntry){stored, in_view.m_size};
+    in_pool->m_count += 1;
+
+    return handle;
+}
+
+CSHInternHandle_t CSH_intern_cstr(S_CSHInternPool* in_pool, CSHConstCharPtr_t in_str)
+{
+    if (in_pool == NULL || in_str == NULL)
+    {
+        return CSH_INTERN_INVALID_HANDLE_M;
+    }
+
+    size_t result = CSH_STRNLEN_MF(in_str, in_pool->m_maxCstrSize);
+    if (result == in_pool->m_maxCstrSize)
+    {
+        return CSH_INTERN_INVALID_HANDLE_M;
+    }
+
+    return CSH_intern_view(in_pool, CSH_string_view_buffer(in_str, result));
+}
+
+CSHInternHandle_t CSH_intern_string(S_CSHInternPool* in_pool, S_CSHString* in_str)
+{
+    if (in_str == NULL)
+    {
+        return CSH_INTERN_INVALID_HANDLE_M;
+    }
+
+    return CSH_intern_view(in_pool, CSH_string_view(in_str));
+}
+
+CSHInternHandle_t CSH_intern_find(const S_CSHInternPool* in_pool, S_CSHStringView in_view)
+{
+    if (in_pool == NULL || in_view.m_strPtr == NULL || in_pool->m_count == 0)
+    {
+        return CSH_INTERN_INVALID_HANDLE_M;
+    }
+
+    S_CSHInternLookup lookup = {in_pool->m_entries, in_view.m_strPtr, in_view.m_size, CSH_kernel_hash(in_view.m_strPtr, in_view.m_size, 0)};
+    const S_MapEntry_CSHInternHash_handle* found = map_find_CSHInternHash_handle(&in_pool->m_table, lookup);
+    return (found != NULL) ? found->m_value : CSH_INTERN_INVALID_HANDLE_M;
+}
+
+S_CSHStringView CSH_intern_get(const S_CSHInternPool* in_pool, CSHInternHandle_t in_handle)
+{
+    if (in_pool == NULL || in_handle == CSH_INTERN_INVALID_HANDLE_M || in_handle > in_pool->m_count)
+    {
+        return CSH_STRING_VIEW_DEFAULT_M;
+    }
+
+    const S_CSHInternEntry* entry = &in_pool->m_entries[in_handle - 1];
+    return CSH_string_view_buffer(entry->m_strPtr, entry->m_size);
+}
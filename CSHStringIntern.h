@@ -0,0 +1,110 @@
+#ifndef CSH_STRING_INTERN_H
+#define CSH_STRING_INTERN_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "CSHAllocator.h"
+#include "CSHArena.h"
+#include "CSHString.h"
+#include "GenericHashMap.h"
+
+// [ typedef uint32_t CSHInternHandle_t ]
+// Identifies a distinct string in a S_CSHInternPool. Two handles from the same pool are equal exactly when their strings are.
+// CSH_INTERN_INVALID_HANDLE_M (0) is never a valid handle, and is returned on failure.
+typedef uint32_t CSHInternHandle_t;
+
+#define CSH_INTERN_INVALID_HANDLE_M 0
+#define CSH_INTERN_CHUNK_SIZE_M (64 * 1024)
+
+// [ typedef struct S_CSHInternEntry ]
+// m_strPtr: The interned characters, which are null terminated and never move while the pool is alive.
+// m_size: The size in characters, not including the null terminator.
+typedef struct
+{
+    CSHConstCharPtr_t m_strPtr;
+    size_t m_size;
+} S_CSHInternEntry;
+
+// [ typedef struct S_CSHInternLookup ]
+// What the pool's map is looked up by. The map only stores each string's hash and handle, 
+// so m_entries is where a candidate's characters are found to compare against m_strPtr.
+// m_entries is NULL for the lookup made from a stored key, which never matches, as the pool only inserts strings it failed to find.
+typedef struct
+{
+    const S_CSHInternEntry* m_entries;
+    CSHConstCharPtr_t m_strPtr;
+    size_t m_size;
+    uint64_t m_hash;
+} S_CSHInternLookup;
+
+// Helpers for the pool's map of CSH_kernel_hash's to handles, which keeps the hashes so the map can grow without rehashing the strings.
+// The map's key is the first member of its entry, so the handle stored alongside it is reached by converting the key's pointer to the entry's.
+#define CSH_INTERN_HASH_MF(in_lookup) ((in_lookup).m_hash)
+#define CSH_INTERN_KEY_VIEW_MF(in_key) ((S_CSHInternLookup){NULL, NULL, 0, *(in_key)})
+#define CSH_INTERN_KEY_ENTRY_MF(in_key, in_lookup) (&(in_lookup).m_entries[((const S_MapEntry_CSHInternHash_handle*)(in_key))->m_value - 1])
+#define CSH_INTERN_EQUAL_MF(in_key, in_lookup) (*(in_key) == (in_lookup).m_hash && (in_lookup).m_entries != NULL \
+    && CSH_INTERN_KEY_ENTRY_MF(in_key, in_lookup)->m_size == (in_lookup).m_size \
+    && memcmp(CSH_INTERN_KEY_ENTRY_MF(in_key, in_lookup)->m_strPtr, (in_lookup).m_strPtr, (in_lookup).m_size * CSH_CHAR_SIZE) == 0)
+
+// The external definitions of this map's inline functions are emitted by CSHStringIntern.c.
+#ifndef G_MAP_CSHInternHash_handle
+#define G_MAP_CSHInternHash_handle
+CREATE_GEN_MAP_M(uint64_t, CSHInternHandle_t, CSHInternHash_handle, S_CSHInternLookup, 
+    CSH_INTERN_HASH_MF, CSH_INTERN_EQUAL_MF, CSH_INTERN_KEY_VIEW_MF, G_MAP_KEY_NO_FREE_MF);
+#endif
+
+// [ typedef struct S_CSHInternPool ]
+// Deduplicates strings, storing one copy of each distinct value and handing out CSHInternHandle_t's for them.
+// The characters are packed back to back into large chunks taken from m_arena, so there is no per string allocation.
+// m_arena: Where the characters are stored, released all at once by CSH_intern_release. The pool must not be moved after CSH_intern_init.
+// m_cursor, m_end: The free space left in the current chunk.
+// m_entries: The interned strings, m_entries[handle - 1].
+// m_count: The number of distinct strings interned.
+// m_entryCapacity: The number of entries m_entries has room for.
+// m_table: Maps each interned string's hash to its handle, strings with the same hash each have their own slot.
+// m_maxCstrSize: The bound used for cstrs, the same as S_CSHString's m_maxCstrSize.
+// m_allocator: The allocator m_entries and m_table come from.
+typedef struct
+{
+    S_CSHArena m_arena;
+    CSHCharPtr_t m_cursor;
+    CSHCharPtr_t m_end;
+    S_CSHInternEntry* m_entries;
+    size_t m_count;
+    size_t m_entryCapacity;
+    S_MapData_CSHInternHash_handle m_table;
+    size_t m_maxCstrSize;
+    const S_CSHAllocator* m_allocator;
+} S_CSHInternPool;
+
+// [ int8_t CSH_intern_init(S_CSHInternPool* in_pool, const S_CSHAllocator* in_allocator) ]
+// in_allocator = the allocator used for the pool's tables, NULL uses the default allocator.
+
+// [ int8_t CSH_intern_release(S_CSHInternPool* in_pool) ]
+// Frees everything the pool owns, every handle and view from it is invalidated.
+
+int8_t CSH_intern_init(S_CSHInternPool* in_pool, const S_CSHAllocator* in_allocator);
+int8_t CSH_intern_release(S_CSHInternPool* in_pool);
+
+// [ CSHInternHandle_t CSH_intern_view(S_CSHInternPool* in_pool, S_CSHStringView in_view) ]
+// Returns the handle for the characters in in_view, copying them into the pool the first time they're seen.
+// Returns CSH_INTERN_INVALID_HANDLE_M for an invalid view, or if the pool fails to allocate.
+
+// [ CSHInternHandle_t CSH_intern_cstr(S_CSHInternPool* in_pool, CSHConstCharPtr_t in_str) ]
+// The cstr must fit within m_maxCstrSize, the same as the CSH_string_*_cstr functions.
+
+// [ CSHInternHandle_t CSH_intern_find(const S_CSHInternPool* in_pool, S_CSHStringView in_view) ]
+// Same as CSH_intern_view, except nothing is added, CSH_INTERN_INVALID_HANDLE_M is returned if the string hasn't been interned.
+
+CSHInternHandle_t CSH_intern_view(S_CSHInternPool* in_pool, S_CSHStringView in_view);
+CSHInternHandle_t CSH_intern_cstr(S_CSHInternPool* in_pool, CSHConstCharPtr_t in_str);
+CSHInternHandle_t CSH_intern_string(S_CSHInternPool* in_pool, S_CSHString* in_str);
+CSHInternHandle_t CSH_intern_find(const S_CSHInternPool* in_pool, S_CSHStringView in_view);
+
+// [ S_CSHStringView CSH_intern_get(const S_CSHInternPool* in_pool, CSHInternHandle_t in_handle) ]
+// Returns a view of the interned string, which stays valid (and null terminated) until CSH_intern_release.
+// An invalid view is returned for a handle which isn't from this pool.
+
+S_CSHStringView CSH_intern_get(const S_CSHInternPool* in_pool, CSHInternHandle_t in_handle);
+
+#endif
@@ -0,0 +1,918 @@
+#include "CSHStringKernels.h"
+#include <string.h>
+
+#if CSH_SIMD_SSE2_M
+#include <emmintrin.h>
+#endif
+#if CSH_SIMD_AVX2_M
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#define CSH_KERNEL_NPOS_M (~(size_t)0)
+
+static inline uint32_t CSH_internal_ctz32(uint32_t in_value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, in_value);
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctz(in_value);
+#endif
+}
+
+static inline uint32_t CSH_internal_ctz64(uint64_t in_value)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, in_value);
+    return (uint32_t)index;
+#elif defined(_MSC_VER)
+    return ((uint32_t)in_value != 0) ? CSH_internal_ctz32((uint32_t)in_value) : (32 + CSH_internal_ctz32((uint32_t)(in_value >> 32)));
+#else
+    return (uint32_t)__builtin_ctzll(in_value);
+#endif
+}
+
+// Index of the highest set bit, in_value must not be 0.
+static inline uint32_t CSH_internal_msb32(uint32_t in_value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, in_value);
+    return (uint32_t)index;
+#else
+    return (uint32_t)(31 - __builtin_clz(in_value));
+#endif
+}
+
+size_t CSH_kernel_find(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize)
+{
+    return CSH_kernel_find_pair(in_haystack, in_haystackSize, in_needle, in_needleSize, 0, (in_needleSize > 0) ? (in_needleSize - 1) : 0);
+}
+
+size_t CSH_kernel_rfind(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize)
+{
+    return CSH_kernel_rfind_pair(in_haystack, in_haystackSize, in_needle, in_needleSize, 0, (in_needleSize > 0) ? (in_needleSize - 1) : 0);
+}
+
+size_t CSH_kernel_find_pair(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize, size_t in_indexOne, size_t in_indexTwo)
+{
+    if (in_needleSize == 0)
+    {
+        return 0;
+    }
+    if (in_needleSize > in_haystackSize)
+    {
+        return CSH_KERNEL_NPOS_M;
+    }
+    if (in_needleSize == 1)
+    {
+        const char* result = (const char*)memchr(in_haystack, in_needle[0], in_haystackSize);
+        return (result != NULL) ? (size_t)(result - in_haystack) : CSH_KERNEL_NPOS_M;
+    }
+
+    // Every start position in [0, lastStart] has room for the whole needle.
+    size_t lastStart = in_haystackSize - in_needleSize;
+    size_t i = 0;
+    const char byteOne = in_needle[in_indexOne];
+    const char byteTwo = in_needle[in_indexTwo];
+
+#if CSH_SIMD_AVX2_M
+    {
+        const __m256i one = _mm256_set1_epi8(byteOne);
+        const __m256i two = _mm256_set1_epi8(byteTwo);
+        for (; (i + 32) <= (lastStart + 1); i += 32)
+        {
+            __m256i blockOne = _mm256_loadu_si256((const __m256i*)(in_haystack + i + in_indexOne));
+            __m256i blockTwo = _mm256_loadu_si256((const __m256i*)(in_haystack + i + in_indexTwo));
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(one, blockOne), _mm256_cmpeq_epi8(two, blockTwo)));
+            while (mask != 0)
+            {
+                uint32_t bit = CSH_internal_ctz32(mask);
+                if (memcmp(in_haystack + i + bit, in_needle, in_needleSize) == 0)
+                {
+                    return (i + bit);
+                }
+                mask &= (mask - 1);
+            }
+        }
+    }
+#endif
+#if CSH_SIMD_SSE2_M
+    {
+        const __m128i one = _mm_set1_epi8(byteOne);
+        const __m128i two = _mm_set1_epi8(byteTwo);
+        for (; (i + 16) <= (lastStart + 1); i += 16)
+        {
+            __m128i blockOne = _mm_loadu_si128((const __m128i*)(in_haystack + i + in_indexOne));
+            __m128i blockTwo = _mm_loadu_si128((const __m128i*)(in_haystack + i + in_indexTwo));
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(one, blockOne), _mm_cmpeq_epi8(two, blockTwo)));
+            while (mask != 0)
+            {
+                uint32_t bit = CSH_internal_ctz32(mask);
+                if (memcmp(in_haystack + i + bit, in_needle, in_needleSize) == 0)
+                {
+                    return (i + bit);
+                }
+                mask &= (mask - 1);
+            }
+        }
+    }
+#endif
+
+    for (; i <= lastStart; i++)
+    {
+        if (in_haystack[i + in_indexOne] == byteOne && in_haystack[i + in_indexTwo] == byteTwo &&
+            memcmp(in_haystack + i, in_needle, in_needleSize) == 0)
+        {
+            return i;
+        }
+    }
+
+    return CSH_KERNEL_NPOS_M;
+}
+
+// The reverse of memchr, comparing a block at a time from the end (memrchr isn't available everywhere, so it's not relied on).
+static size_t CSH_internal_rfind_byte(const char* in_haystack, size_t in_haystackSize, char in_byte)
+{
+    // i is one past the highest position still to be checked, each block covers the positions [i - width, i).
+    size_t i = in_haystackSize;
+
+#if CSH_SIMD_AVX2_M
+    {
+        const __m256i byte = _mm256_set1_epi8(in_byte);
+        for (; i >= 32; i -= 32)
+        {
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(byte, _mm256_loadu_si256((const __m256i*)(in_haystack + i - 32))));
+            if (mask != 0)
+            {
+                return (i - 32) + CSH_internal_msb32(mask);
+            }
+        }
+    }
+#endif
+#if CSH_SIMD_SSE2_M
+    {
+        const __m128i byte = _mm_set1_epi8(in_byte);
+        for (; i >= 16; i -= 16)
+        {
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(byte, _mm_loadu_si128((const __m128i*)(in_haystack + i - 16))));
+            if (mask != 0)
+            {
+                return (i - 16) + CSH_internal_msb32(mask);
+            }
+        }
+    }
+#endif
+
+    for (; i > 0; i--)
+    {
+        if (in_haystack[i - 1] == in_byte)
+        {
+            return (i - 1);
+        }
+    }
+
+    return CSH_KERNEL_NPOS_M;
+}
+
+size_t CSH_kernel_rfind_pair(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize, size_t in_indexOne, size_t in_indexTwo)
+{
+    if (in_needleSize == 0)
+    {
+        return in_haystackSize;
+    }
+    if (in_needleSize > in_haystackSize)
+    {
+        return CSH_KERNEL_NPOS_M;
+    }
+    if (in_needleSize == 1)
+    {
+        return CSH_internal_rfind_byte(in_haystack, in_haystackSize, in_needle[0]);
+    }
+
+    // i is one past the highest start position still to be checked, each block covers the start positions [i - width, i).
+    size_t i = (in_haystackSize - in_needleSize) + 1;
+    const char byteOne = in_needle[in_indexOne];
+    const char byteTwo = in_needle[in_indexTwo];
+
+#if CSH_SIMD_AVX2_M
+    {
+        const __m256i one = _mm256_set1_epi8(byteOne);
+        const __m256i two = _mm256_set1_epi8(byteTwo);
+        for (; i >= 32; i -= 32)
+        {
+            size_t base = i - 32;
+            __m256i blockOne = _mm256_loadu_si256((const __m256i*)(in_haystack + base + in_indexOne));
+            __m256i blockTwo = _mm256_loadu_si256((const __m256i*)(in_haystack + base + in_indexTwo));
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(one, blockOne), _mm256_cmpeq_epi8(two, blockTwo)));
+            while (mask != 0)
+            {
+                uint32_t bit = CSH_internal_msb32(mask);
+                if (memcmp(in_haystack + base + bit, in_needle, in_needleSize) == 0)
+                {
+                    return (base + bit);
+                }
+                mask &= ~((uint32_t)1 << bit);
+            }
+        }
+    }
+#endif
+#if CSH_SIMD_SSE2_M
+    {
+        const __m128i one = _mm_set1_epi8(byteOne);
+        const __m128i two = _mm_set1_epi8(byteTwo);
+        for (; i >= 16; i -= 16)
+        {
+            size_t base = i - 16;
+            __m128i blockOne = _mm_loadu_si128((const __m128i*)(in_haystack + base + in_indexOne));
+            __m128i blockTwo = _mm_loadu_si128((const __m128i*)(in_haystack + base + in_indexTwo));
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(one, blockOne), _mm_cmpeq_epi8(two, blockTwo)));
+            while (mask != 0)
+            {
+                uint32_t bit = CSH_internal_msb32(mask);
+                if (memcmp(in_haystack + base + bit, in_needle, in_needleSize) == 0)
+                {
+                    return (base + bit);
+                }
+                mask &= ~((uint32_t)1 << bit);
+            }
+        }
+    }
+#endif
+
+    for (; i > 0; i--)
+    {
+        size_t start = i - 1;
+        if (in_haystack[start + in_indexOne] == byteOne && in_haystack[start + in_indexTwo] == byteTwo &&
+            memcmp(in_haystack + start, in_needle, in_needleSize) == 0)
+        {
+            return start;
+        }
+    }
+
+    return CSH_KERNEL_NPOS_M;
+}
+
+int CSH_kernel_compare(const char* in_strOne, const char* in_strTwo, size_t in_size)
+{
+    size_t i = 0;
+
+#if CSH_SIMD_AVX2_M
+    for (; (i + 32) <= in_size; i += 32)
+    {
+        __m256i one = _mm256_loadu_si256((const __m256i*)(in_strOne + i));
+        __m256i two = _mm256_loadu_si256((const __m256i*)(in_strTwo + i));
+        uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(one, two));
+        if (mask != 0)
+        {
+            size_t index = i + CSH_internal_ctz32(mask);
+            return (int)(uint8_t)in_strOne[index] - (int)(uint8_t)in_strTwo[index];
+        }
+    }
+#endif
+#if CSH_SIMD_SSE2_M
+    for (; (i + 16) <= in_size; i += 16)
+    {
+        __m128i one = _mm_loadu_si128((const __m128i*)(in_strOne + i));
+        __m128i two = _mm_loadu_si128((const __m128i*)(in_strTwo + i));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(one, two)) ^ 0xFFFFu;
+        if (mask != 0)
+        {
+            size_t index = i + CSH_internal_ctz32(mask);
+            return (int)(uint8_t)in_strOne[index] - (int)(uint8_t)in_strTwo[index];
+        }
+    }
+#endif
+
+    for (; i < in_size; i++)
+    {
+        if (in_strOne[i] != in_strTwo[i])
+        {
+            return (int)(uint8_t)in_strOne[i] - (int)(uint8_t)in_strTwo[i];
+        }
+    }
+
+    return 0;
+}
+
+static inline char CSH_internal_lower_char(char in_char)
+{
+    return (in_char >= 'A' && in_char <= 'Z') ? (char)(in_char + 32) : in_char;
+}
+
+static inline char CSH_internal_upper_char(char in_char)
+{
+    return (in_char >= 'a' && in_char <= 'z') ? (char)(in_char - 32) : in_char;
+}
+
+// Bytes at or above 0x80 are negative to the signed compares, so they never fall inside a letter range.
+#if CSH_SIMD_SSE2_M
+static inline __m128i CSH_internal_flip_case128(__m128i in_block, char in_first, char in_last)
+{
+    __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(in_block, _mm_set1_epi8((char)(in_first - 1))), _mm_cmplt_epi8(in_block, _mm_set1_epi8((char)(in_last + 1))));
+    return _mm_xor_si128(in_block, _mm_and_si128(inRange, _mm_set1_epi8(0x20)));
+}
+#endif
+#if CSH_SIMD_AVX2_M
+static inline __m256i CSH_internal_flip_case256(__m256i in_block, char in_first, char in_last)
+{
+    __m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi8(in_block, _mm256_set1_epi8((char)(in_first - 1))), _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(in_last + 1)), in_block));
+    return _mm256_xor_si256(in_block, _mm256_and_si256(inRange, _mm256_set1_epi8(0x20)));
+}
+#endif
+
+// Flips the case of every byte in [in_first, in_last], which is 'A'-'Z' for lowering and 'a'-'z' for uppering.
+static void CSH_internal_flip_case(char* in_data, size_t in_size, char in_first, char in_last)
+{
+    size_t i = 0;
+
+#if CSH_SIMD_AVX2_M
+    for (; (i + 32) <= in_size; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(in_data + i));
+        _mm256_storeu_si256((__m256i*)(in_data + i), CSH_internal_flip_case256(block, in_first, in_last));
+    }
+#endif
+#if CSH_SIMD_SSE2_M
+    for (; (i + 16) <= in_size; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(in_data + i));
+        _mm_storeu_si128((__m128i*)(in_data + i), CSH_internal_flip_case128(block, in_first, in_last));
+    }
+#endif
+
+    for (; i < in_size; i++)
+    {
+        if (in_data[i] >= in_first && in_data[i] <= in_last)
+        {
+            in_data[i] = (char)(in_data[i] ^ 0x20);
+        }
+    }
+}
+
+void CSH_kernel_to_lower(char* in_data, size_t in_size)
+{
+    CSH_internal_flip_case(in_data, in_size, 'A', 'Z');
+}
+
+void CSH_kernel_to_upper(char* in_data, size_t in_size)
+{
+    CSH_internal_flip_case(in_data, in_size, 'a', 'z');
+}
+
+bool CSH_kernel_equal_icase(const char* in_strOne, const char* in_strTwo, size_t in_size)
+{
+    size_t i = 0;
+
+#if CSH_SIMD_AVX2_M
+    for (; (i + 32) <= in_size; i += 32)
+    {
+        __m256i one = CSH_internal_flip_case256(_mm256_loadu_si256((const __m256i*)(in_strOne + i)), 'A', 'Z');
+        __m256i two = CSH_internal_flip_case256(_mm256_loadu_si256((const __m256i*)(in_strTwo + i)), 'A', 'Z');
+        if ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(one, two)) != 0xFFFFFFFFu)
+        {
+            return false;
+        }
+    }
+#endif
+#if CSH_SIMD_SSE2_M
+    for (; (i + 16) <= in_size; i += 16)
+    {
+        __m128i one = CSH_internal_flip_case128(_mm_loadu_si128((const __m128i*)(in_strOne + i)), 'A', 'Z');
+        __m128i two = CSH_internal_flip_case128(_mm_loadu_si128((const __m128i*)(in_strTwo + i)), 'A', 'Z');
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(one, two)) != 0xFFFF)
+        {
+            return false;
+        }
+    }
+#endif
+
+    for (; i < in_size; i++)
+    {
+        if (CSH_internal_lower_char(in_strOne[i]) != CSH_internal_lower_char(in_strTwo[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t CSH_kernel_find_icase(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize)
+{
+    if (in_needleSize == 0)
+    {
+        return 0;
+    }
+    if (in_needleSize > in_haystackSize)
+    {
+        return CSH_KERNEL_NPOS_M;
+    }
+
+    size_t lastStart = in_haystackSize - in_needleSize;
+    size_t i = 0;
+    const char firstByte = CSH_internal_lower_char(in_needle[0]);
+    const char lastByte = CSH_internal_lower_char(in_needle[in_needleSize - 1]);
+
+#if CSH_SIMD_AVX2_M
+    {
+        const __m256i first = _mm256_set1_epi8(firstByte);
+        const __m256i last = _mm256_set1_epi8(lastByte);
+        for (; (i + 32) <= (lastStart + 1); i += 32)
+        {
+            __m256i blockFirst = CSH_internal_flip_case256(_mm256_loadu_si256((const __m256i*)(in_haystack + i)), 'A', 'Z');
+            __m256i blockLast = CSH_internal_flip_case256(_mm256_loadu_si256((const __m256i*)(in_haystack + i + in_needleSize - 1)), 'A', 'Z');
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast)));
+            while (mask != 0)
+            {
+                uint32_t bit = CSH_internal_ctz32(mask);
+                if (CSH_kernel_equal_icase(in_haystack + i + bit, in_needle, in_needleSize))
+                {
+                    return (i + bit);
+                }
+                mask &= (mask - 1);
+            }
+        }
+    }
+#endif
+#if CSH_SIMD_SSE2_M
+    {
+        const __m128i first = _mm_set1_epi8(firstByte);
+        const __m128i last = _mm_set1_epi8(lastByte);
+        for (; (i + 16) <= (lastStart + 1); i += 16)
+        {
+            __m128i blockFirst = CSH_internal_flip_case128(_mm_loadu_si128((const __m128i*)(in_haystack + i)), 'A', 'Z');
+            __m128i blockLast = CSH_internal_flip_case128(_mm_loadu_si128((const __m128i*)(in_haystack + i + in_needleSize - 1)), 'A', 'Z');
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast)));
+            while (mask != 0)
+            {
+                uint32_t bit = CSH_internal_ctz32(mask);
+                if (CSH_kernel_equal_icase(in_haystack + i + bit, in_needle, in_needleSize))
+                {
+                    return (i + bit);
+                }
+                mask &= (mask - 1);
+            }
+        }
+    }
+#endif
+
+    for (; i <= lastStart; i++)
+    {
+        if (CSH_internal_lower_char(in_haystack[i]) == firstByte && CSH_kernel_equal_icase(in_haystack + i, in_needle, in_needleSize))
+        {
+            return i;
+        }
+    }
+
+    return CSH_KERNEL_NPOS_M;
+}
+
+// Hashing is a wyhash style multiply-fold over 16 byte chunks.
+#define CSH_KERNEL_HASH_P0_M 0xa0761d6478bd642fULL
+#define CSH_KERNEL_HASH_P1_M 0xe7037ed1a0b428dbULL
+
+// Multiplies in_a and in_b to 128 bits and xors the two halves together.
+static inline uint64_t CSH_internal_mum(uint64_t in_a, uint64_t in_b)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t)in_a * in_b;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high;
+    uint64_t low = _umul128(in_a, in_b, &high);
+    return low ^ high;
+#else
+    uint64_t aLow = (uint32_t)in_a, aHigh = in_a >> 32, bLow = (uint32_t)in_b, bHigh = in_b >> 32;
+    uint64_t lowLow = aLow * bLow, lowHigh = aLow * bHigh, highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+    uint64_t middle = (lowLow >> 32) + (uint32_t)lowHigh + (uint32_t)highLow;
+    uint64_t low = (middle << 32) | (uint32_t)lowLow;
+    uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+static inline uint64_t CSH_internal_read64(const char* in_ptr)
+{
+    uint64_t value;
+    memcpy(&value, in_ptr, sizeof(value));
+    return value;
+}
+
+static inline uint64_t CSH_internal_read32(const char* in_ptr)
+{
+    uint32_t value;
+    memcpy(&value, in_ptr, sizeof(value));
+    return value;
+}
+
+// Lowers the ASCII letters in each byte of in_word, bytes at or above 0x80 are left alone.
+static inline uint64_t CSH_internal_fold64(uint64_t in_word)
+{
+    const uint64_t lowBits = 0x7F7F7F7F7F7F7F7FULL;
+    const uint64_t highBits = 0x8080808080808080ULL;
+    uint64_t heptets = in_word & lowBits;
+    uint64_t aboveA = heptets + (0x0101010101010101ULL * (0x80 - 'A'));
+    uint64_t aboveZ = heptets + (0x0101010101010101ULL * (0x80 - 'Z' - 1));
+    uint64_t isUpper = (aboveA ^ aboveZ) & ~in_word & highBits;
+    return in_word | (isUpper >> 2);
+}
+
+// Every load goes through in_fold when in_fold is set, so folding costs a few ALU ops per 8 bytes.
+static inline uint64_t CSH_internal_hash(const char* in_data, size_t in_size, uint64_t in_seed, bool in_fold)
+{
+    uint64_t seed = in_seed ^ CSH_KERNEL_HASH_P0_M;
+    uint64_t a = 0;
+    uint64_t b = 0;
+    const char* ptr = in_data;
+    size_t remaining = in_size;
+
+    while (remaining > 16)
+    {
+        uint64_t wordOne = CSH_internal_read64(ptr);
+        uint64_t wordTwo = CSH_internal_read64(ptr + 8);
+        if (in_fold)
+        {
+            wordOne = CSH_internal_fold64(wordOne);
+            wordTwo = CSH_internal_fold64(wordTwo);
+        }
+        seed = CSH_internal_mum(wordOne ^ CSH_KERNEL_HASH_P1_M, wordTwo ^ seed);
+        ptr += 16;
+        remaining -= 16;
+    }
+
+    // The last 1-16 bytes, read as (possibly overlapping) words so nothing past the end is touched.
+    if (remaining >= 8)
+    {
+        a = CSH_internal_read64(ptr);
+        b = CSH_internal_read64(ptr + remaining - 8);
+    }
+    else if (remaining >= 4)
+    {
+        a = (CSH_internal_read32(ptr) << 32) | CSH_internal_read32(ptr + remaining - 4);
+    }
+    else if (remaining > 0)
+    {
+        a = ((uint64_t)(uint8_t)ptr[0] << 16) | ((uint64_t)(uint8_t)ptr[remaining / 2] << 8) | (uint64_t)(uint8_t)ptr[remaining - 1];
+    }
+    if (in_fold)
+    {
+        a = CSH_internal_fold64(a);
+        b = CSH_internal_fold64(b);
+    }
+
+    return CSH_internal_mum(CSH_KERNEL_HASH_P1_M ^ (uint64_t)in_size, CSH_internal_mum(a ^ CSH_KERNEL_HASH_P1_M, b ^ seed));
+}
+
+// Inputs at least this long are hashed with the striped bulk path below.
+#define CSH_KERNEL_HASH_BULK_MIN_SIZE_M 256
+#define CSH_KERNEL_HASH_STRIPE_SIZE_M 64
+#define CSH_KERNEL_HASH_STRIPES_PER_BLOCK_M 16
+#define CSH_KERNEL_HASH_PRIME32_M 0x9E3779B1u
+
+static const uint64_t CSH_KERNEL_HASH_SECRET[8] =
+{
+    0x4396d60dbd8537afULL, 0xe98ff1a0396ff552ULL, 0xfe0612e395ab3d91ULL, 0xa2757f60ebe1e246ULL,
+    0xb920fdfffd1ecb88ULL, 0xc3886454811320c9ULL, 0x38bd8413abc9c71dULL, 0x79307f8e50c9e6c1ULL
+};
+
+// The scramble keys are the secret rotated by 3 lanes.
+static const uint64_t CSH_KERNEL_HASH_SCRAMBLE[8] =
+{
+    0xa2757f60ebe1e246ULL, 0xb920fdfffd1ecb88ULL, 0xc3886454811320c9ULL, 0x38bd8413abc9c71dULL,
+    0x79307f8e50c9e6c1ULL, 0x4396d60dbd8537afULL, 0xe98ff1a0396ff552ULL, 0xfe0612e395ab3d91ULL
+};
+
+// CSH_internal_fold64 on every 8 byte lane of a vector, for the folded bulk hash. The per byte sums can't carry, so they match the scalar version exactly.
+#if CSH_SIMD_AVX2_M
+static inline __m256i CSH_internal_fold256(__m256i in_data)
+{
+    __m256i heptets = _mm256_and_si256(in_data, _mm256_set1_epi8(0x7F));
+    __m256i aboveA = _mm256_add_epi8(heptets, _mm256_set1_epi8((char)(0x80 - 'A')));
+    __m256i aboveZ = _mm256_add_epi8(heptets, _mm256_set1_epi8((char)(0x80 - 'Z' - 1)));
+    __m256i isUpper = _mm256_andnot_si256(in_data, _mm256_and_si256(_mm256_xor_si256(aboveA, aboveZ), _mm256_set1_epi8((char)0x80)));
+    return _mm256_or_si256(in_data, _mm256_srli_epi64(isUpper, 2));
+}
+#elif CSH_SIMD_SSE2_M
+static inline __m128i CSH_internal_fold128(__m128i in_data)
+{
+    __m128i heptets = _mm_and_si128(in_data, _mm_set1_epi8(0x7F));
+    __m128i aboveA = _mm_add_epi8(heptets, _mm_set1_epi8((char)(0x80 - 'A')));
+    __m128i aboveZ = _mm_add_epi8(heptets, _mm_set1_epi8((char)(0x80 - 'Z' - 1)));
+    __m128i isUpper = _mm_andnot_si128(in_data, _mm_and_si128(_mm_xor_si128(aboveA, aboveZ), _mm_set1_epi8((char)0x80)));
+    return _mm_or_si128(in_data, _mm_srli_epi64(isUpper, 2));
+}
+#endif
+
+// xxh3 style bulk hashing, 8 independent 64 bit lanes accumulate each 64 byte stripe:
+//   acc[j] += data[j ^ 1] + lo32(data[j] ^ secret[j]) * hi32(data[j] ^ secret[j])
+// and every 16 stripes each lane is scrambled with acc = ((acc ^ (acc >> 47)) ^ scramble[j]) * prime32.
+// The SIMD and scalar paths compute exactly the same values, so the hash doesn't depend on how the library was built.
+// in_fold lowers every stripe as it's loaded, the same as CSH_internal_hash.
+static uint64_t CSH_internal_hash_bulk(const char* in_data, size_t in_size, uint64_t in_seed, bool in_fold)
+{
+    uint64_t acc[8];
+    size_t stripeCount = in_size / CSH_KERNEL_HASH_STRIPE_SIZE_M;
+    for (size_t j = 0; j < 8; j++)
+    {
+        acc[j] = CSH_KERNEL_HASH_SECRET[j] ^ in_seed;
+    }
+
+#if CSH_SIMD_AVX2_M
+    {
+        __m256i accVec[2];
+        __m256i keyVec[2];
+        __m256i scrambleVec[2];
+        const __m256i prime = _mm256_set1_epi32((int)CSH_KERNEL_HASH_PRIME32_M);
+        for (size_t k = 0; k < 2; k++)
+        {
+            accVec[k] = _mm256_loadu_si256((const __m256i*)(acc + (k * 4)));
+            keyVec[k] = _mm256_loadu_si256((const __m256i*)(CSH_KERNEL_HASH_SECRET + (k * 4)));
+            scrambleVec[k] = _mm256_loadu_si256((const __m256i*)(CSH_KERNEL_HASH_SCRAMBLE + (k * 4)));
+        }
+        for (size_t s = 0; s < stripeCount; s++)
+        {
+            const char* stripe = in_data + (s * CSH_KERNEL_HASH_STRIPE_SIZE_M);
+            for (size_t k = 0; k < 2; k++)
+            {
+                __m256i data = _mm256_loadu_si256((const __m256i*)(stripe + (k * 32)));
+                if (in_fold)
+                {
+                    data = CSH_internal_fold256(data);
+                }
+                __m256i dataKey = _mm256_xor_si256(data, keyVec[k]);
+                __m256i product = _mm256_mul_epu32(dataKey, _mm256_srli_epi64(dataKey, 32));
+                __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                accVec[k] = _mm256_add_epi64(accVec[k], _mm256_add_epi64(product, swapped));
+            }
+            if (((s + 1) % CSH_KERNEL_HASH_STRIPES_PER_BLOCK_M) == 0)
+            {
+                for (size_t k = 0; k < 2; k++)
+                {
+                    __m256i value = _mm256_xor_si256(_mm256_xor_si256(accVec[k], _mm256_srli_epi64(accVec[k], 47)), scrambleVec[k]);
+                    __m256i low = _mm256_mul_epu32(value, prime);
+                    __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime);
+                    accVec[k] = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+                }
+            }
+        }
+        for (size_t k = 0; k < 2; k++)
+        {
+            _mm256_storeu_si256((__m256i*)(acc + (k * 4)), accVec[k]);
+        }
+    }
+#elif CSH_SIMD_SSE2_M
+    {
+        __m128i accVec[4];
+        __m128i keyVec[4];
+        __m128i scrambleVec[4];
+        const __m128i prime = _mm_set1_epi32((int)CSH_KERNEL_HASH_PRIME32_M);
+        for (size_t k = 0; k < 4; k++)
+        {
+            accVec[k] = _mm_loadu_si128((const __m128i*)(acc + (k * 2)));
+            keyVec[k] = _mm_loadu_si128((const __m128i*)(CSH_KERNEL_HASH_SECRET + (k * 2)));
+            scrambleVec[k] = _mm_loadu_si128((const __m128i*)(CSH_KERNEL_HASH_SCRAMBLE + (k * 2)));
+        }
+        for (size_t s = 0; s < stripeCount; s++)
+        {
+            const char* stripe = in_data + (s * CSH_KERNEL_HASH_STRIPE_SIZE_M);
+            for (size_t k = 0; k < 4; k++)
+            {
+                __m128i data = _mm_loadu_si128((const __m128i*)(stripe + (k * 16)));
+                if (in_fold)
+                {
+                    data = CSH_internal_fold128(data);
+                }
+                __m128i dataKey = _mm_xor_si128(data, keyVec[k]);
+                __m128i product = _mm_mul_epu32(dataKey, _mm_srli_epi64(dataKey, 32));
+                __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                accVec[k] = _mm_add_epi64(accVec[k], _mm_add_epi64(product, swapped));
+            }
+            if (((s + 1) % CSH_KERNEL_HASH_STRIPES_PER_BLOCK_M) == 0)
+            {
+                for (size_t k = 0; k < 4; k++)
+                {
+                    __m128i value = _mm_xor_si128(_mm_xor_si128(accVec[k], _mm_srli_epi64(accVec[k], 47)), scrambleVec[k]);
+                    __m128i low = _mm_mul_epu32(value, prime);
+                    __m128i high = _mm_mul_epu32(_mm_srli_epi64(value, 32), prime);
+                    accVec[k] = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+                }
+            }
+        }
+        for (size_t k = 0; k < 4; k++)
+        {
+            _mm_storeu_si128((__m128i*)(acc + (k * 2)), accVec[k]);
+        }
+    }
+#else
+    for (size_t s = 0; s < stripeCount; s++)
+    {
+        const char* stripe = in_data + (s * CSH_KERNEL_HASH_STRIPE_SIZE_M);
+        uint64_t data[8];
+        for (size_t j = 0; j < 8; j++)
+        {
+            data[j] = CSH_internal_read64(stripe + (j * 8));
+            if (in_fold)
+            {
+                data[j] = CSH_internal_fold64(data[j]);
+            }
+        }
+        for (size_t j = 0; j < 8; j++)
+        {
+            uint64_t dataKey = data[j] ^ CSH_KERNEL_HASH_SECRET[j];
+            acc[j] += data[j ^ 1] + ((dataKey & 0xFFFFFFFFULL) * (dataKey >> 32));
+        }
+        if (((s + 1) % CSH_KERNEL_HASH_STRIPES_PER_BLOCK_M) == 0)
+        {
+            for (size_t j = 0; j < 8; j++)
+            {
+                acc[j] = ((acc[j] ^ (acc[j] >> 47)) ^ CSH_KERNEL_HASH_SCRAMBLE[j]) * CSH_KERNEL_HASH_PRIME32_M;
+            }
+        }
+    }
+#endif
+
+    // Merge the lanes, then hash the remaining partial stripe with the merged value as its seed.
+    uint64_t result = in_seed ^ ((uint64_t)in_size * CSH_KERNEL_HASH_P1_M);
+    for (size_t j = 0; j < 8; j += 2)
+    {
+        result ^= CSH_internal_mum(acc[j] ^ CSH_KERNEL_HASH_SECRET[j + 1], acc[j + 1] ^ CSH_KERNEL_HASH_SECRET[j]);
+    }
+
+    size_t bulkSize = stripeCount * CSH_KERNEL_HASH_STRIPE_SIZE_M;
+    return CSH_internal_hash(in_data + bulkSize, in_size - bulkSize, result, in_fold);
+}
+
+uint64_t CSH_kernel_hash(const char* in_data, size_t in_size, uint64_t in_seed)
+{
+    if (in_size >= CSH_KERNEL_HASH_BULK_MIN_SIZE_M)
+    {
+        return CSH_internal_hash_bulk(in_data, in_size, in_seed, false);
+    }
+
+    return CSH_internal_hash(in_data, in_size, in_seed, false);
+}
+
+uint64_t CSH_kernel_hash_icase(const char* in_data, size_t in_size, uint64_t in_seed)
+{
+    if (in_size >= CSH_KERNEL_HASH_BULK_MIN_SIZE_M)
+    {
+        return CSH_internal_hash_bulk(in_data, in_size, in_seed, true);
+    }
+
+    return CSH_internal_hash(in_data, in_size, in_seed, true);
+}
+
+size_t CSH_kernel_find_any(const char* in_haystack, size_t in_haystackSize, const char* in_set, size_t in_setSize)
+{
+    if (in_setSize == 0)
+    {
+        return CSH_KERNEL_NPOS_M;
+    }
+    if (in_setSize == 1)
+    {
+        const char* result = (const char*)memchr(in_haystack, in_set[0], in_haystackSize);
+        return (result != NULL) ? (size_t)(result - in_haystack) : CSH_KERNEL_NPOS_M;
+    }
+
+    size_t i = 0;
+    if (in_setSize <= CSH_KERNEL_FIND_ANY_SIMD_MAX_M)
+    {
+#if CSH_SIMD_AVX2_M
+        {
+            __m256i set[CSH_KERNEL_FIND_ANY_SIMD_MAX_M];
+            for (size_t j = 0; j < in_setSize; j++)
+            {
+                set[j] = _mm256_set1_epi8(in_set[j]);
+            }
+            for (; (i + 32) <= in_haystackSize; i += 32)
+            {
+                __m256i block = _mm256_loadu_si256((const __m256i*)(in_haystack + i));
+                __m256i matches = _mm256_cmpeq_epi8(block, set[0]);
+                for (size_t j = 1; j < in_setSize; j++)
+                {
+                    matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, set[j]));
+                }
+                uint32_t mask = (uint32_t)_mm256_movemask_epi8(matches);
+                if (mask != 0)
+                {
+                    return (i + CSH_internal_ctz32(mask));
+                }
+            }
+        }
+#endif
+#if CSH_SIMD_SSE2_M
+        {
+            __m128i set[CSH_KERNEL_FIND_ANY_SIMD_MAX_M];
+            for (size_t j = 0; j < in_setSize; j++)
+            {
+                set[j] = _mm_set1_epi8(in_set[j]);
+            }
+            for (; (i + 16) <= in_haystackSize; i += 16)
+            {
+                __m128i block = _mm_loadu_si128((const __m128i*)(in_haystack + i));
+                __m128i matches = _mm_cmpeq_epi8(block, set[0]);
+                for (size_t j = 1; j < in_setSize; j++)
+                {
+                    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, set[j]));
+                }
+                uint32_t mask = (uint32_t)_mm_movemask_epi8(matches);
+                if (mask != 0)
+                {
+                    return (i + CSH_internal_ctz32(mask));
+                }
+            }
+        }
+#endif
+    }
+
+    // A 256 bit membership bitmap for the tail, larger sets and scalar builds.
+    uint64_t bitmap[4] = {0, 0, 0, 0};
+    for (size_t j = 0; j < in_setSize; j++)
+    {
+        uint8_t byte = (uint8_t)in_set[j];
+        bitmap[byte >> 6] |= (1ULL << (byte & 63));
+    }
+    for (; i < in_haystackSize; i++)
+    {
+        uint8_t byte = (uint8_t)in_haystack[i];
+        if ((bitmap[byte >> 6] >> (byte & 63)) & 1)
+        {
+            return i;
+        }
+    }
+
+    return CSH_KERNEL_NPOS_M;
+}
+
+uint32_t CSH_kernel_match_bytes16(const uint8_t* in_data, uint8_t in_byte)
+{
+#if CSH_SIMD_SSE2_M
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)in_data), _mm_set1_epi8((char)in_byte)));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        mask |= (uint32_t)(in_data[i] == in_byte) << i;
+    }
+    return mask;
+#endif
+}
+
+uint32_t CSH_kernel_match_high_bits16(const uint8_t* in_data)
+{
+#if CSH_SIMD_SSE2_M
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)in_data));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        mask |= (uint32_t)(in_data[i] >> 7) << i;
+    }
+    return mask;
+#endif
+}
+
+uint32_t CSH_kernel_ctz32(uint32_t in_value)
+{
+    return CSH_internal_ctz32(in_value);
+}
+
+uint32_t CSH_kernel_ctz64(uint64_t in_value)
+{
+    return CSH_internal_ctz64(in_value);
+}
+
+uint64_t CSH_kernel_match_byte64(const char* in_data, size_t in_size, char in_byte)
+{
+    uint64_t mask = 0;
+    size_t i = 0;
+    if (in_size >= 64)
+    {
+#if CSH_SIMD_AVX2_M
+        const __m256i byte = _mm256_set1_epi8(in_byte);
+        uint64_t low = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)in_data), byte));
+        uint64_t high = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(in_data + 32)), byte));
+        return low | (high << 32);
+#elif CSH_SIMD_SSE2_M
+        const __m128i byte = _mm_set1_epi8(in_byte);
+        for (; i < 64; i += 16)
+        {
+            mask |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(in_data + i)), byte)) << i;
+        }
+        return mask;
+#endif
+    }
+
+    size_t size = (in_size < 64) ? in_size : 64;
+    for (; i < size; i++)
+    {
+        mask |= (uint64_t)(in_data[i] == in_byte) << i;
+    }
+    return mask;
+}
@@ -0,0 +1,112 @@
+#ifndef CSH_STRING_KERNELS_H
+#define CSH_STRING_KERNELS_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Length bounded byte kernels the CSH string functions are built on. 
+// None of them depend on null terminators, so they work on S_CSHString, S_CSHStringView and raw buffers alike.
+//
+// The SIMD paths are chosen at compile time, SSE2 is used on any x86-64 build, AVX2 when the compiler targets it (-mavx2, /arch:AVX2).
+// Setting CSH_SIMD_ENABLED_M to 0 forces the scalar paths.
+
+#define CSH_SIMD_ENABLED_M 1
+
+#if CSH_SIMD_ENABLED_M && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define CSH_SIMD_SSE2_M 1
+#else
+    #define CSH_SIMD_SSE2_M 0
+#endif
+
+#if CSH_SIMD_ENABLED_M && CSH_SIMD_SSE2_M && defined(__AVX2__)
+    #define CSH_SIMD_AVX2_M 1
+#else
+    #define CSH_SIMD_AVX2_M 0
+#endif
+
+// [ size_t CSH_kernel_find(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize) ]
+// Returns the offset of the first occurrence of in_needle in in_haystack, or CSH_STRING_NPOS (~0) if there isn't one.
+// An empty needle matches at offset 0.
+// Candidate positions are found by comparing the first and last byte of the needle against 16/32 haystack positions at once,
+// and only those candidates are verified with memcmp.
+
+// [ size_t CSH_kernel_rfind(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize) ]
+// Returns the offset of the last occurrence of in_needle in in_haystack, or CSH_STRING_NPOS (~0) if there isn't one.
+// An empty needle matches at offset in_haystackSize.
+// Same first/last byte filter as CSH_kernel_find, walking blocks from the end of the haystack toward the front.
+
+// [ size_t CSH_kernel_find_pair(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize, size_t in_indexOne, size_t in_indexTwo),
+//   size_t CSH_kernel_rfind_pair(...) ]
+// Same as CSH_kernel_find and CSH_kernel_rfind, filtering candidates on the needle bytes at in_indexOne and in_indexTwo instead of the first and last byte.
+// Picking bytes which are rare in the haystack (see S_CSHStringSearcher) means far fewer candidates need verifying.
+// Both indices must be less than in_needleSize.
+
+size_t CSH_kernel_find(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize);
+size_t CSH_kernel_rfind(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize);
+size_t CSH_kernel_find_pair(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize, size_t in_indexOne, size_t in_indexTwo);
+size_t CSH_kernel_rfind_pair(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize, size_t in_indexOne, size_t in_indexTwo);
+
+// [ #define CSH_KERNEL_FIND_ANY_SIMD_MAX_M ]
+// Sets of up to this many bytes are searched for with SIMD by CSH_kernel_find_any, one compare per set byte per block.
+// Larger sets are searched one byte at a time against a 256 bit membership bitmap.
+
+#define CSH_KERNEL_FIND_ANY_SIMD_MAX_M 8
+
+// [ size_t CSH_kernel_find_any(const char* in_haystack, size_t in_haystackSize, const char* in_set, size_t in_setSize) ]
+// Returns the offset of the first byte of in_haystack which is any of the in_setSize bytes in in_set, or CSH_STRING_NPOS (~0) if there isn't one.
+// An empty set never matches. A single byte is found with memchr.
+
+size_t CSH_kernel_find_any(const char* in_haystack, size_t in_haystackSize, const char* in_set, size_t in_setSize);
+
+// [ int CSH_kernel_compare(const char* in_strOne, const char* in_strTwo, size_t in_size) ]
+// Same as memcmp, returns <0, 0 or >0 by the first differing byte (compared as unsigned), 16/32 bytes per step.
+
+int CSH_kernel_compare(const char* in_strOne, const char* in_strTwo, size_t in_size);
+
+// [ uint64_t CSH_kernel_hash(const char* in_data, size_t in_size, uint64_t in_seed) ]
+// Fast non-cryptographic 64 bit hash (wyhash style for short inputs, xxh3 style striped SIMD accumulation for long ones).
+// The result only depends on the bytes and the seed, not on whether the SIMD paths are enabled, but it isn't stable across byte orders.
+// Not suitable where an attacker chooses the keys and a fixed seed is used.
+
+uint64_t CSH_kernel_hash(const char* in_data, size_t in_size, uint64_t in_seed);
+
+// [ uint32_t CSH_kernel_match_bytes16(const uint8_t* in_data, uint8_t in_byte), uint32_t CSH_kernel_match_high_bits16(const uint8_t* in_data) ]
+// Return a bit mask with bit i set for each of the 16 bytes at in_data equal to in_byte, or with its high bit set.
+// Used for hash map group probing (see GenericHashMap.h) in builds without SSE2.
+
+// [ uint32_t CSH_kernel_ctz32(uint32_t in_value), uint32_t CSH_kernel_ctz64(uint64_t in_value) ]
+// Index of the lowest set bit, in_value must not be 0.
+
+// [ uint64_t CSH_kernel_match_byte64(const char* in_data, size_t in_size, char in_byte) ]
+// Returns a bit mask with bit i set for each of the first 64 bytes (or in_size, if fewer) at in_data equal to in_byte.
+// Iterating a mask's set bits finds every occurrence in the block with one scan, which beats a memchr per occurrence when they're close together (see S_CSHLineIterator).
+
+uint32_t CSH_kernel_match_bytes16(const uint8_t* in_data, uint8_t in_byte);
+uint32_t CSH_kernel_match_high_bits16(const uint8_t* in_data);
+uint32_t CSH_kernel_ctz32(uint32_t in_value);
+uint32_t CSH_kernel_ctz64(uint64_t in_value);
+uint64_t CSH_kernel_match_byte64(const char* in_data, size_t in_size, char in_byte);
+
+// Case insensitive kernels, only ASCII letters are folded, every other byte (including UTF-8 sequences) must match exactly.
+
+// [ void CSH_kernel_to_lower(char* in_data, size_t in_size),
+//   void CSH_kernel_to_upper(char* in_data, size_t in_size) ]
+// Maps ASCII letters in place, 16/32 bytes per step.
+
+// [ bool CSH_kernel_equal_icase(const char* in_strOne, const char* in_strTwo, size_t in_size) ]
+// Returns true if the two buffers match, ignoring ASCII case.
+
+// [ size_t CSH_kernel_find_icase(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize) ]
+// Same as CSH_kernel_find, ignoring ASCII case. The haystack is folded on the fly, a lowered copy is never made.
+
+// [ uint64_t CSH_kernel_hash_icase(const char* in_data, size_t in_size, uint64_t in_seed) ]
+// Hashes in_data as if it had been lowered (the same result as CSH_kernel_hash on a lowered copy), so strings which are equal ignoring case hash the same. 
+// Folding is done 8 bytes at a time within the hash's own loads, and a vector at a time in the striped path for long inputs.
+
+void CSH_kernel_to_lower(char* in_data, size_t in_size);
+void CSH_kernel_to_upper(char* in_data, size_t in_size);
+bool CSH_kernel_equal_icase(const char* in_strOne, const char* in_strTwo, size_t in_size);
+size_t CSH_kernel_find_icase(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize);
+uint64_t CSH_kernel_hash_icase(const char* in_data, size_t in_size, uint64_t in_seed);
+
+#endif
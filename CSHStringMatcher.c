@@ -0,0 +1,276 @@
+#include "CSHStringMatcher.h"
+#include <string.h>
+
+// Returns the child of in_node reached by in_class, or 0 if there isn't one.
+static uint32_t CSH_internal_matcher_child(const S_CSHMatcherNode* in_nodes, uint32_t in_node, uint16_t in_class)
+{
+    for (uint32_t child = in_nodes[in_node].m_firstChild; child != 0; child = in_nodes[child].m_nextSibling)
+    {
+        if (in_nodes[child].m_class == in_class)
+        {
+            return child;
+        }
+    }
+
+    return 0;
+}
+
+int8_t CSH_matcher_init(S_CSHMatcher* in_this, const S_CSHStringView* in_patterns, size_t in_patternCount, uint32_t in_flags, const S_CSHAllocator* in_allocator)
+{
+    if (in_this == NULL || (in_patterns == NULL && in_patternCount > 0) || in_patternCount >= CSH_MATCHER_NO_PATTERN_M)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    memset(in_this, 0, sizeof(S_CSHMatcher));
+    in_this->m_allocator = CSH_allocator_resolve(in_allocator);
+    in_this->m_flags = in_flags;
+
+    // Every pattern character can add at most one state, plus the root.
+    size_t maxNodes = 1;
+    for (size_t i = 0; i < in_patternCount; i++)
+    {
+        if (in_patterns[i].m_strPtr == NULL || in_patterns[i].m_size == 0)
+        {
+            return CSHSSC_BAD_INPUT_STR;
+        }
+        maxNodes += in_patterns[i].m_size;
+        if (maxNodes >= UINT32_MAX)
+        {
+            return CSHSSC_BAD_INPUT_ARG;
+        }
+    }
+
+    // Byte classes, only bytes which appear in a pattern get a class of their own.
+    in_this->m_classCount = 1;
+    for (size_t i = 0; i < in_patternCount; i++)
+    {
+        const uint8_t* pattern = (const uint8_t*)in_patterns[i].m_strPtr;
+        for (size_t j = 0; j < in_patterns[i].m_size; j++)
+        {
+            if (in_this->m_classes[pattern[j]] == 0)
+            {
+                in_this->m_classes[pattern[j]] = in_this->m_classCount++;
+            }
+        }
+    }
+
+    in_this->m_patternCount = in_patternCount;
+    in_this->m_nodeCapacity = maxNodes;
+    in_this->m_nodes = (S_CSHMatcherNode*)CSH_allocator_alloc(in_this->m_allocator, maxNodes * sizeof(S_CSHMatcherNode));
+    in_this->m_patternSizes = (size_t*)CSH_allocator_alloc(in_this->m_allocator, (in_patternCount + 1) * sizeof(size_t));
+    in_this->m_patternNext = (uint32_t*)CSH_allocator_alloc(in_this->m_allocator, (in_patternCount + 1) * sizeof(uint32_t));
+    uint32_t* queue = (uint32_t*)CSH_allocator_alloc(in_this->m_allocator, maxNodes * sizeof(uint32_t));
+    if (in_this->m_nodes == NULL || in_this->m_patternSizes == NULL || in_this->m_patternNext == NULL || queue == NULL)
+    {
+        if (queue != NULL)
+        {
+            CSH_allocator_free(in_this->m_allocator, queue, maxNodes * sizeof(uint32_t));
+        }
+        CSH_matcher_free(in_this);
+        return CSHSSC_ALLOC_FAILED;
+    }
+
+    S_CSHMatcherNode* nodes = in_this->m_nodes;
+    memset(&nodes[0], 0, sizeof(S_CSHMatcherNode));
+    nodes[0].m_pattern = CSH_MATCHER_NO_PATTERN_M;
+    uint32_t nodeCount = 1;
+
+    // Build the trie.
+    for (size_t i = 0; i < in_patternCount; i++)
+    {
+        const uint8_t* pattern = (const uint8_t*)in_patterns[i].m_strPtr;
+        uint32_t node = 0;
+        for (size_t j = 0; j < in_patterns[i].m_size; j++)
+        {
+            uint16_t byteClass = in_this->m_classes[pattern[j]];
+            uint32_t child = CSH_internal_matcher_child(nodes, node, byteClass);
+            if (child == 0)
+            {
+                child = nodeCount++;
+                memset(&nodes[child], 0, sizeof(S_CSHMatcherNode));
+                nodes[child].m_pattern = CSH_MATCHER_NO_PATTERN_M;
+                nodes[child].m_class = byteClass;
+                nodes[child].m_nextSibling = nodes[node].m_firstChild;
+                nodes[node].m_firstChild = child;
+            }
+            node = child;
+        }
+
+        in_this->m_patternSizes[i] = in_patterns[i].m_size;
+        in_this->m_patternNext[i] = nodes[node].m_pattern;
+        nodes[node].m_pattern = (uint32_t)i;
+    }
+    in_this->m_nodeCount = nodeCount;
+
+    // Failure and output links, breadth first so a state's fail state is always finished before it.
+    size_t queueHead = 0;
+    size_t queueTail = 0;
+    for (uint32_t child = nodes[0].m_firstChild; child != 0; child = nodes[child].m_nextSibling)
+    {
+        queue[queueTail++] = child;
+    }
+    while (queueHead < queueTail)
+    {
+        uint32_t node = queue[queueHead++];
+        for (uint32_t child = nodes[node].m_firstChild; child != 0; child = nodes[child].m_nextSibling)
+        {
+            uint32_t fail = nodes[node].m_fail;
+            uint32_t target = CSH_internal_matcher_child(nodes, fail, nodes[child].m_class);
+            while (target == 0 && fail != 0)
+            {
+                fail = nodes[fail].m_fail;
+                target = CSH_internal_matcher_child(nodes, fail, nodes[child].m_class);
+            }
+
+            nodes[child].m_fail = target;
+            nodes[child].m_output = (nodes[target].m_pattern != CSH_MATCHER_NO_PATTERN_M) ? target : nodes[target].m_output;
+            queue[queueTail++] = child;
+        }
+    }
+
+    if ((in_flags & CSHMF_DFA) != 0)
+    {
+        size_t stride = in_this->m_classCount;
+        in_this->m_table = (uint32_t*)CSH_allocator_alloc(in_this->m_allocator, (size_t)nodeCount * stride * sizeof(uint32_t));
+        if (in_this->m_table == NULL)
+        {
+            CSH_allocator_free(in_this->m_allocator, queue, maxNodes * sizeof(uint32_t));
+            CSH_matcher_free(in_this);
+            return CSHSSC_ALLOC_FAILED;
+        }
+
+        // The root's missing transitions loop back to the root, every other state inherits its fail state's row (already filled, as the order is breadth first).
+        memset(in_this->m_table, 0, stride * sizeof(uint32_t));
+        for (uint32_t child = nodes[0].m_firstChild; child != 0; child = nodes[child].m_nextSibling)
+        {
+            in_this->m_table[nodes[child].m_class] = child;
+        }
+        for (size_t i = 0; i < queueTail; i++)
+        {
+            uint32_t node = queue[i];
+            uint32_t* row = in_this->m_table + ((size_t)node * stride);
+            memcpy(row, in_this->m_table + ((size_t)nodes[node].m_fail * stride), stride * sizeof(uint32_t));
+            for (uint32_t child = nodes[node].m_firstChild; child != 0; child = nodes[child].m_nextSibling)
+            {
+                row[nodes[child].m_class] = child;
+            }
+        }
+    }
+
+    CSH_allocator_free(in_this->m_allocator, queue, maxNodes * sizeof(uint32_t));
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_matcher_free(S_CSHMatcher* in_this)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    if (in_this->m_table != NULL)
+    {
+        CSH_allocator_free(in_this->m_allocator, in_this->m_table, (size_t)in_this->m_nodeCount * in_this->m_classCount * sizeof(uint32_t));
+    }
+    if (in_this->m_nodes != NULL)
+    {
+        CSH_allocator_free(in_this->m_allocator, in_this->m_nodes, in_this->m_nodeCapacity * sizeof(S_CSHMatcherNode));
+    }
+    if (in_this->m_patternSizes != NULL)
+    {
+        CSH_allocator_free(in_this->m_allocator, in_this->m_patternSizes, (in_this->m_patternCount + 1) * sizeof(size_t));
+    }
+    if (in_this->m_patternNext != NULL)
+    {
+        CSH_allocator_free(in_this->m_allocator, in_this->m_patternNext, (in_this->m_patternCount + 1) * sizeof(uint32_t));
+    }
+
+    const S_CSHAllocator* allocator = in_this->m_allocator;
+    memset(in_this, 0, sizeof(S_CSHMatcher));
+    in_this->m_allocator = allocator;
+
+    return CSHSSC_NONE;
+}
+
+// Reports every pattern completed by in_node for a match ending just before in_end, returns false if the callback asked to stop.
+static bool CSH_internal_matcher_report(const S_CSHMatcher* in_this, uint32_t in_node, size_t in_end, CSHMatchCallback_t in_callback, void* in_context, size_t* in_count)
+{
+    const S_CSHMatcherNode* nodes = in_this->m_nodes;
+    uint32_t node = (nodes[in_node].m_pattern != CSH_MATCHER_NO_PATTERN_M) ? in_node : nodes[in_node].m_output;
+    while (node != 0)
+    {
+        for (uint32_t pattern = nodes[node].m_pattern; pattern != CSH_MATCHER_NO_PATTERN_M; pattern = in_this->m_patternNext[pattern])
+        {
+            *in_count += 1;
+            if (!in_callback(in_context, pattern, in_end - in_this->m_patternSizes[pattern]))
+            {
+                return false;
+            }
+        }
+        node = nodes[node].m_output;
+    }
+
+    return true;
+}
+
+size_t CSH_matcher_scan(const S_CSHMatcher* in_this, S_CSHStringView in_view, CSHMatchCallback_t in_callback, void* in_context)
+{
+    if (in_this == NULL || in_this->m_nodes == NULL || in_view.m_strPtr == NULL || in_callback == NULL)
+    {
+        return 0;
+    }
+
+    const S_CSHMatcherNode* nodes = in_this->m_nodes;
+    const uint8_t* input = (const uint8_t*)in_view.m_strPtr;
+    size_t count = 0;
+    uint32_t state = 0;
+
+    if (in_this->m_table != NULL)
+    {
+        const uint32_t* table = in_this->m_table;
+        size_t stride = in_this->m_classCount;
+        for (size_t i = 0; i < in_view.m_size; i++)
+        {
+            state = table[((size_t)state * stride) + in_this->m_classes[input[i]]];
+            if (state != 0 && (nodes[state].m_pattern != CSH_MATCHER_NO_PATTERN_M || nodes[state].m_output != 0))
+            {
+                if (!CSH_internal_matcher_report(in_this, state, (i + 1), in_callback, in_context, &count))
+                {
+                    break;
+                }
+            }
+        }
+
+        return count;
+    }
+
+    for (size_t i = 0; i < in_view.m_size; i++)
+    {
+        uint16_t byteClass = in_this->m_classes[input[i]];
+        if (byteClass == 0)
+        {
+            // Bytes which aren't in any pattern always lead back to the root.
+            state = 0;
+            continue;
+        }
+
+        uint32_t next = CSH_internal_matcher_child(nodes, state, byteClass);
+        while (next == 0 && state != 0)
+        {
+            state = nodes[state].m_fail;
+            next = CSH_internal_matcher_child(nodes, state, byteClass);
+        }
+        state = next;
+
+        if (state != 0 && (nodes[state].m_pattern != CSH_MATCHER_NO_PATTERN_M || nodes[state].m_output != 0))
+        {
+            if (!CSH_internal_matcher_report(in_this, state, (i + 1), in_callback, in_context, &count))
+            {
+                break;
+            }
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,84 @@
+#ifndef CSH_STRING_MATCHER_H
+#define CSH_STRING_MATCHER_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "CSHAllocator.h"
+#include "CSHString.h"
+
+// Multi-pattern matching (Aho-Corasick), every occurrence of every pattern is found in a single pass over the input.
+// For a handful of patterns CSH_string_find or S_CSHStringSearcher is faster, the matcher wins once there are tens or hundreds of patterns.
+
+enum E_CSHMatcherFlags
+{
+    CSHMF_NONE = 0,
+    // Flattens the automaton into a full transition table (a DFA), so each input byte costs one table lookup instead of following failure links.
+    // The table holds (node count * byte class count) 32 bit entries.
+    CSHMF_DFA = 1 << 0
+};
+
+// [ typedef struct S_CSHMatcherNode ]
+// A state of the automaton, which corresponds to a prefix of one or more patterns.
+// m_firstChild, m_nextSibling: The trie, children are linked through their siblings, 0 (the root) means none.
+// m_fail: The state for the longest proper suffix of this state's prefix which is also a prefix in the trie.
+// m_output: The nearest state along the failure links which completes a pattern, 0 if there isn't one.
+// m_pattern: The first pattern this state completes, or CSH_MATCHER_NO_PATTERN_M.
+// m_class: The byte class of the transition into this state.
+typedef struct
+{
+    uint32_t m_firstChild;
+    uint32_t m_nextSibling;
+    uint32_t m_fail;
+    uint32_t m_output;
+    uint32_t m_pattern;
+    uint16_t m_class;
+} S_CSHMatcherNode;
+
+#define CSH_MATCHER_NO_PATTERN_M UINT32_MAX
+
+// [ typedef struct S_CSHMatcher ]
+// m_nodes: The states, m_nodes[0] is the root.
+// m_nodeCapacity: The number of states m_nodes was allocated with, one per pattern character plus the root.
+// m_table: The flattened transitions when built with CSHMF_DFA (m_table[state * m_classCount + class]), otherwise NULL.
+// m_patternSizes: The size of each pattern in characters, indexed by pattern id.
+// m_patternNext: The next pattern id completed by the same state (duplicate patterns), or CSH_MATCHER_NO_PATTERN_M.
+// m_classes: Maps each byte to its class, bytes which don't appear in any pattern all share class 0.
+// m_classCount: The number of byte classes, which is the row width of m_table.
+typedef struct
+{
+    S_CSHMatcherNode* m_nodes;
+    uint32_t m_nodeCount;
+    size_t m_nodeCapacity;
+    uint32_t* m_table;
+    size_t* m_patternSizes;
+    uint32_t* m_patternNext;
+    size_t m_patternCount;
+    uint16_t m_classes[256];
+    uint16_t m_classCount;
+    uint32_t m_flags;
+    const S_CSHAllocator* m_allocator;
+} S_CSHMatcher;
+
+// [ typedef bool (*CSHMatchCallback_t)(void* in_context, size_t in_patternId, size_t in_pos) ]
+// Called for each match, in_patternId is the pattern's index in the array passed to CSH_matcher_init, in_pos is the offset the match starts at.
+// Return false to stop scanning.
+typedef bool (*CSHMatchCallback_t)(void* in_context, size_t in_patternId, size_t in_pos);
+
+// [ int8_t CSH_matcher_init(S_CSHMatcher* in_this, const S_CSHStringView* in_patterns, size_t in_patternCount, uint32_t in_flags, const S_CSHAllocator* in_allocator) ]
+// Compiles the patterns into a matcher, the patterns are not referenced afterwards.
+// in_flags = a combination of E_CSHMatcherFlags.
+// Returns CSHSSC_BAD_INPUT_STR if any pattern is an invalid or empty view, or CSHSSC_ALLOC_FAILED.
+
+// [ int8_t CSH_matcher_free(S_CSHMatcher* in_this) ]
+
+int8_t CSH_matcher_init(S_CSHMatcher* in_this, const S_CSHStringView* in_patterns, size_t in_patternCount, uint32_t in_flags, const S_CSHAllocator* in_allocator);
+int8_t CSH_matcher_free(S_CSHMatcher* in_this);
+
+// [ size_t CSH_matcher_scan(const S_CSHMatcher* in_this, S_CSHStringView in_view, CSHMatchCallback_t in_callback, void* in_context) ]
+// Reports every match in in_view (overlapping matches included) to in_callback, ordered by where the matches end.
+// Matches ending at the same position are reported longest first.
+// Use CSH_string_view to scan a S_CSHString. Returns the number of matches reported.
+
+size_t CSH_matcher_scan(const S_CSHMatcher* in_this, S_CSHStringView in_view, CSHMatchCallback_t in_callback, void* in_context);
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef CSH_STRING_NUMBER_H
+#define CSH_STRING_NUMBER_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "CSHString.h"
+
+// [ #define CSH_NUMBER_MAX_CHARS_M ]
+// The most characters any of the number formatting functions appends, "-1.2345678901234567e-308" is the longest.
+
+#define CSH_NUMBER_MAX_CHARS_M 24
+
+// [ int8_t CSH_string_append_u64(S_CSHString* in_this, uint64_t in_value),
+//   int8_t CSH_string_append_i64(S_CSHString* in_this, int64_t in_value),
+//   int8_t CSH_string_append_u32(S_CSHString* in_this, uint32_t in_value),
+//   int8_t CSH_string_append_i32(S_CSHString* in_this, int32_t in_value) ]
+// Appends the value in decimal, the same as printf's %llu / %lld.
+// The digits are counted first, so they're written straight into the string's spare capacity two at a time, with no temporary buffer.
+
+int8_t CSH_string_append_u64(S_CSHString* in_this, uint64_t in_value);
+int8_t CSH_string_append_i64(S_CSHString* in_this, int64_t in_value);
+int8_t CSH_string_append_u32(S_CSHString* in_this, uint32_t in_value);
+int8_t CSH_string_append_i32(S_CSHString* in_this, int32_t in_value);
+
+// [ int8_t CSH_string_append_hex(S_CSHString* in_this, uint64_t in_value, bool in_uppercase) ]
+// Appends the value in hexadecimal without a prefix or leading zeros, the same as printf's %llx / %llX.
+
+int8_t CSH_string_append_hex(S_CSHString* in_this, uint64_t in_value, bool in_uppercase);
+
+// [ int8_t CSH_string_append_double(S_CSHString* in_this, double in_value) ]
+// Appends the shortest decimal which reads back (with strtod) as exactly in_value, found with the Schubfach algorithm.
+// Of several equally short decimals, the closest to in_value is used.
+// The layout follows printf's %g: plain notation when the exponent is from -5 to 16 (0.00001, 123.25, 10000000000000000), 
+// otherwise scientific with at least two exponent digits (1e+17, 2.5e-06). Integers are written without a decimal point.
+// Infinity and NaN are written as "inf", "-inf" and "nan", and negative zero as "-0".
+
+int8_t CSH_string_append_double(S_CSHString* in_this, double in_value);
+
+// [ int8_t CSH_string_view_parse_u64(S_CSHStringView in_view, uint64_t* out_value, size_t* out_size),
+//   int8_t CSH_string_view_parse_i64(S_CSHStringView in_view, int64_t* out_value, size_t* out_size) ]
+// Parses a decimal integer with an optional sign ('+' only for u64) from the start of in_view, never reading past its end, 
+// so a string's range (CSH_string_substr_view) or a raw buffer (CSH_string_view_buffer) can be parsed in place.
+// Leading whitespace isn't skipped. If out_size isn't NULL it's set to how many characters were used.
+// Returns CSHSSC_BAD_INPUT_STR if in_view doesn't start with a number, 
+// or CSHSSC_BAD_INPUT_ARG if it doesn't fit, with out_value clamped to the type's limit.
+// Digits are converted 8 at a time within a uint64_t where the platform is little endian.
+
+int8_t CSH_string_view_parse_u64(S_CSHStringView in_view, uint64_t* out_value, size_t* out_size);
+int8_t CSH_string_view_parse_i64(S_CSHStringView in_view, int64_t* out_value, size_t* out_size);
+
+// [ int8_t CSH_string_view_parse_double(S_CSHStringView in_view, double* out_value, size_t* out_size) ]
+// Parses [+-]digits[.digits][(e|E)[+-]digits], or "inf", "infinity" and "nan" in any case, from the start of in_view 
+// into the nearest double (ties to even), the same value strtod gives. Hexadecimal floats aren't supported.
+// Out of range values become infinity or zero, which isn't treated as an error.
+// Most numbers are converted with Clinger's fast path or the Eisel-Lemire algorithm, only the rare ambiguous ones fall back to strtod.
+// The decimal point is always '.', the fallback parses in the "C" locale so it doesn't depend on the program's LC_NUMERIC.
+// Returns and sets out_size the same as CSH_string_view_parse_i64.
+
+int8_t CSH_string_view_parse_double(S_CSHStringView in_view, double* out_value, size_t* out_size);
+
+// [ size_t CSH_string_view_parse_i64_list(S_CSHStringView in_view, CSHChar_t in_delimiter, int64_t* out_values, size_t in_maxCount, size_t* out_pos),
+//   size_t CSH_string_view_parse_double_list(S_CSHStringView in_view, CSHChar_t in_delimiter, double* out_values, size_t in_maxCount, size_t* out_pos) ]
+// Parses a whole in_delimiter separated column ("1,2,3") into out_values in one call, returning how many values were written.
+// Stops at the first field which isn't exactly one number (an empty field, trailing characters or an overflow), 
+// or once in_maxCount values are written. If out_pos isn't NULL it's set to where parsing stopped: 
+// in_view's size when everything was parsed, otherwise the start of the field that wasn't.
+
+size_t CSH_string_view_parse_i64_list(S_CSHStringView in_view, CSHChar_t in_delimiter, int64_t* out_values, size_t in_maxCount, size_t* out_pos);
+size_t CSH_string_view_parse_double_list(S_CSHStringView in_view, CSHChar_t in_delimiter, double* out_values, size_t in_maxCount, size_t* out_pos);
+
+#endif
@@ -0,0 +1,244 @@
+#include "CSHStringSearcher.h"
+#include "CSHStringKernels.h"
+#include <string.h>
+
+// How often in_byte is expected to appear in typical text (logs, paths, source, prose), higher is more common.
+// Only the ordering matters, it's used to pick the needle bytes the SIMD filter compares against.
+static uint8_t CSH_internal_byte_rank(uint8_t in_byte)
+{
+    static const char commonLower[] = "etaoinshrdlcumwfgypbvkjxqz";
+
+    if (in_byte == ' ')
+    {
+        return 255;
+    }
+    if (in_byte >= 'a' && in_byte <= 'z')
+    {
+        return (uint8_t)(250 - (strchr(commonLower, in_byte) - commonLower));
+    }
+    if (in_byte >= '0' && in_byte <= '9')
+    {
+        return 210;
+    }
+    if (in_byte >= 'A' && in_byte <= 'Z')
+    {
+        return (uint8_t)(200 - (strchr(commonLower, in_byte + 32) - commonLower));
+    }
+    if (in_byte == '.' || in_byte == ',' || in_byte == '/' || in_byte == '-' || in_byte == '_' || in_byte == ':' || in_byte == '=' || in_byte == '\n')
+    {
+        return 215;
+    }
+    if (in_byte > 32 && in_byte < 127)
+    {
+        return 160;
+    }
+    if (in_byte == '\t' || in_byte == '\r')
+    {
+        return 150;
+    }
+    if (in_byte == 0)
+    {
+        return 100;
+    }
+
+    return 50;
+}
+
+int8_t CSH_searcher_init(S_CSHStringSearcher* in_this, S_CSHStringView in_needle, const S_CSHAllocator* in_allocator)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+    if (in_needle.m_strPtr == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    memset(in_this, 0, sizeof(S_CSHStringSearcher));
+    in_this->m_allocator = CSH_allocator_resolve(in_allocator);
+    in_this->m_size = in_needle.m_size;
+
+    if (in_needle.m_size > 0)
+    {
+        in_this->m_needle = (CSHCharPtr_t)CSH_allocator_alloc(in_this->m_allocator, in_needle.m_size * CSH_CHAR_SIZE);
+        if (in_this->m_needle == NULL)
+        {
+            in_this->m_size = 0;
+            return CSHSSC_ALLOC_FAILED;
+        }
+        memcpy(in_this->m_needle, in_needle.m_strPtr, in_needle.m_size * CSH_CHAR_SIZE);
+    }
+
+    const uint8_t* needle = (const uint8_t*)in_this->m_needle;
+    size_t size = in_this->m_size;
+
+    // Horspool tables, a byte not in the needle lets the window skip past it entirely.
+    for (size_t i = 0; i < 256; i++)
+    {
+        in_this->m_skip[i] = size;
+        in_this->m_rskip[i] = size;
+    }
+    for (size_t i = 0; (i + 1) < size; i++)
+    {
+        in_this->m_skip[needle[i]] = (size - 1) - i;
+    }
+    for (size_t i = size; i > 1; i--)
+    {
+        in_this->m_rskip[needle[i - 1]] = (i - 1);
+    }
+
+    // The two rarest bytes, at different positions where the needle allows it.
+    for (size_t i = 1; i < size; i++)
+    {
+        if (CSH_internal_byte_rank(needle[i]) < CSH_internal_byte_rank(needle[in_this->m_indexOne]))
+        {
+            in_this->m_indexOne = i;
+        }
+    }
+    in_this->m_indexTwo = (in_this->m_indexOne == 0 && size > 1) ? 1 : 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        if (i != in_this->m_indexOne && CSH_internal_byte_rank(needle[i]) < CSH_internal_byte_rank(needle[in_this->m_indexTwo]))
+        {
+            in_this->m_indexTwo = i;
+        }
+    }
+
+    in_this->m_useHorspool = (!CSH_SIMD_SSE2_M || size >= CSH_SEARCHER_HORSPOOL_MIN_SIZE_M);
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_searcher_free(S_CSHStringSearcher* in_this)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    if (in_this->m_needle != NULL)
+    {
+        CSH_allocator_free(in_this->m_allocator, in_this->m_needle, in_this->m_size * CSH_CHAR_SIZE);
+    }
+    in_this->m_needle = NULL;
+    in_this->m_size = 0;
+
+    return CSHSSC_NONE;
+}
+
+// Forward search of in_haystack, returns the offset of the first match or CSH_STRING_NPOS.
+static size_t CSH_internal_searcher_find(const S_CSHStringSearcher* in_this, CSHConstCharPtr_t in_haystack, size_t in_haystackSize)
+{
+    size_t size = in_this->m_size;
+    if (size <= 1 || !in_this->m_useHorspool)
+    {
+        return CSH_kernel_find_pair(in_haystack, in_haystackSize, in_this->m_needle, size, in_this->m_indexOne, in_this->m_indexTwo);
+    }
+    if (size > in_haystackSize)
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    const uint8_t* haystack = (const uint8_t*)in_haystack;
+    uint8_t lastByte = (uint8_t)in_this->m_needle[size - 1];
+    size_t lastStart = in_haystackSize - size;
+    size_t i = 0;
+    while (i <= lastStart)
+    {
+        uint8_t endByte = haystack[i + size - 1];
+        if (endByte == lastByte && memcmp(in_haystack + i, in_this->m_needle, size - 1) == 0)
+        {
+            return i;
+        }
+        i += in_this->m_skip[endByte];
+    }
+
+    return CSH_STRING_NPOS;
+}
+
+// Backward search of in_haystack, returns the offset of the last match or CSH_STRING_NPOS.
+static size_t CSH_internal_searcher_rfind(const S_CSHStringSearcher* in_this, CSHConstCharPtr_t in_haystack, size_t in_haystackSize)
+{
+    size_t size = in_this->m_size;
+    if (size <= 1 || !in_this->m_useHorspool)
+    {
+        return CSH_kernel_rfind_pair(in_haystack, in_haystackSize, in_this->m_needle, size, in_this->m_indexOne, in_this->m_indexTwo);
+    }
+    if (size > in_haystackSize)
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    const uint8_t* haystack = (const uint8_t*)in_haystack;
+    uint8_t firstByte = (uint8_t)in_this->m_needle[0];
+    size_t start = in_haystackSize - size;
+    while (true)
+    {
+        uint8_t startByte = haystack[start];
+        if (startByte == firstByte && memcmp(in_haystack + start + 1, in_this->m_needle + 1, size - 1) == 0)
+        {
+            return start;
+        }
+        if (start < in_this->m_rskip[startByte])
+        {
+            break;
+        }
+        start -= in_this->m_rskip[startByte];
+    }
+
+    return CSH_STRING_NPOS;
+}
+
+size_t CSH_searcher_find(const S_CSHStringSearcher* in_this, S_CSHStringView in_view, size_t in_pos)
+{
+    if (in_this == NULL || in_view.m_strPtr == NULL)
+    {
+        return CSH_STRING_NPOS;
+    }
+    if (in_pos >= in_view.m_size)
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    size_t result = CSH_internal_searcher_find(in_this, (in_view.m_strPtr + in_pos), (in_view.m_size - in_pos));
+    return (result != CSH_STRING_NPOS) ? (in_pos + result) : CSH_STRING_NPOS;
+}
+
+size_t CSH_searcher_rfind(const S_CSHStringSearcher* in_this, S_CSHStringView in_view, size_t in_pos)
+{
+    if (in_this == NULL || in_view.m_strPtr == NULL)
+    {
+        return CSH_STRING_NPOS;
+    }
+    if (in_pos >= in_view.m_size)
+    {
+        return CSH_STRING_NPOS;
+    }
+
+    size_t result = CSH_internal_searcher_rfind(in_this, (in_view.m_strPtr + in_pos), (in_view.m_size - in_pos));
+    return (result != CSH_STRING_NPOS) ? (in_pos + result) : CSH_STRING_NPOS;
+}
+
+size_t CSH_searcher_count(const S_CSHStringSearcher* in_this, S_CSHStringView in_view)
+{
+    if (in_this == NULL || in_view.m_strPtr == NULL || in_this->m_size == 0)
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    size_t pos = 0;
+    while (pos < in_view.m_size)
+    {
+        size_t result = CSH_internal_searcher_find(in_this, (in_view.m_strPtr + pos), (in_view.m_size - pos));
+        if (result == CSH_STRING_NPOS)
+        {
+            break;
+        }
+        count++;
+        pos += result + in_this->m_size;
+    }
+
+    return count;
+}
@@ -0,0 +1,58 @@
+#ifndef CSH_STRING_SEARCHER_H
+#define CSH_STRING_SEARCHER_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "CSHAllocator.h"
+#include "CSHString.h"
+
+// [ #define CSH_SEARCHER_HORSPOOL_MIN_SIZE_M ]
+// Needles at least this long are searched with Boyer-Moore-Horspool, whose skips grow with the needle length,
+// shorter needles use the SIMD rare byte filter. Without SIMD support, Horspool is always used.
+
+#define CSH_SEARCHER_HORSPOOL_MIN_SIZE_M 64
+
+// [ typedef struct S_CSHStringSearcher ]
+// A needle preprocessed once, which can then be searched for in any number of strings and views.
+// m_needle: The searcher's own copy of the needle, so the needle passed to CSH_searcher_init doesn't need to outlive it.
+// m_size: The size of the needle in characters.
+// m_indexOne, m_indexTwo: The positions of the two bytes in the needle least likely to appear in typical text, used to filter candidates.
+// m_skip: Horspool shift table for forward searches, indexed by the haystack byte aligned with the end of the needle.
+// m_rskip: Horspool shift table for backward searches, indexed by the haystack byte aligned with the start of the needle.
+// m_useHorspool: Whether the skip tables or the rare byte filter are used.
+// m_allocator: The allocator m_needle was allocated with.
+typedef struct
+{
+    CSHCharPtr_t m_needle;
+    size_t m_size;
+    size_t m_indexOne;
+    size_t m_indexTwo;
+    size_t m_skip[256];
+    size_t m_rskip[256];
+    bool m_useHorspool;
+    const S_CSHAllocator* m_allocator;
+} S_CSHStringSearcher;
+
+// [ int8_t CSH_searcher_init(S_CSHStringSearcher* in_this, S_CSHStringView in_needle, const S_CSHAllocator* in_allocator) ]
+// Builds a searcher for in_needle, copying it with in_allocator (NULL uses the default allocator).
+// Use CSH_string_view or CSH_string_view_cstr to build a searcher from a S_CSHString or cstr.
+// Returns CSHSSC_BAD_INPUT_STR for an invalid view, or CSHSSC_ALLOC_FAILED.
+
+// [ int8_t CSH_searcher_free(S_CSHStringSearcher* in_this) ]
+// Frees the searcher's copy of the needle.
+
+int8_t CSH_searcher_init(S_CSHStringSearcher* in_this, S_CSHStringView in_needle, const S_CSHAllocator* in_allocator);
+int8_t CSH_searcher_free(S_CSHStringSearcher* in_this);
+
+// [ size_t CSH_searcher_find(const S_CSHStringSearcher* in_this, S_CSHStringView in_view, size_t in_pos),
+//   size_t CSH_searcher_rfind(const S_CSHStringSearcher* in_this, S_CSHStringView in_view, size_t in_pos) ]
+// Same as CSH_string_view_find and CSH_string_view_rfind, with the searcher's needle.
+
+// [ size_t CSH_searcher_count(const S_CSHStringSearcher* in_this, S_CSHStringView in_view) ]
+// Returns the number of non-overlapping occurrences of the needle in in_view, 0 for an empty needle or invalid view.
+
+size_t CSH_searcher_find(const S_CSHStringSearcher* in_this, S_CSHStringView in_view, size_t in_pos);
+size_t CSH_searcher_rfind(const S_CSHStringSearcher* in_this, S_CSHStringView in_view, size_t in_pos);
+size_t CSH_searcher_count(const S_CSHStringSearcher* in_this, S_CSHStringView in_view);
+
+#endif
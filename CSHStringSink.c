@@ -0,0 +1,261 @@
+#include "CSHStringSink.h"
+#include "CSHGeneralUtils.h"
+#include <string.h>
+#include <errno.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+// Writes in_count pieces to in_fileDescriptor, continuing from where a partial write stopped.
+static int8_t CSH_internal_sink_write_pieces(int in_fileDescriptor, const S_CSHStringView* in_pieces, size_t in_count)
+{
+#ifdef _WIN32
+    for (size_t i = 0; i < in_count; i++)
+    {
+        const char* data = in_pieces[i].m_strPtr;
+        size_t remaining = in_pieces[i].m_size;
+        while (remaining > 0)
+        {
+            unsigned int chunk = (remaining > 0x40000000) ? 0x40000000 : (unsigned int)remaining;
+            int written = _write(in_fileDescriptor, data, chunk);
+            if (written <= 0)
+            {
+                return CSHSSC_IO_FAILED;
+            }
+            data += written;
+            remaining -= (size_t)written;
+        }
+    }
+#else
+    struct iovec vectors[CSH_SINK_MAX_PIECES_M];
+    for (size_t i = 0; i < in_count; i++)
+    {
+        vectors[i].iov_base = (void*)in_pieces[i].m_strPtr;
+        vectors[i].iov_len = in_pieces[i].m_size;
+    }
+
+    struct iovec* current = vectors;
+    int remaining = (int)in_count;
+    while (remaining > 0)
+    {
+        ssize_t written = writev(in_fileDescriptor, current, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return CSHSSC_IO_FAILED;
+        }
+
+        // Skips the vectors which were written completely, and trims the one the write stopped in.
+        size_t done = (size_t)written;
+        while (remaining > 0 && done >= current->iov_len)
+        {
+            done -= current->iov_len;
+            current++;
+            remaining--;
+        }
+        if (remaining > 0)
+        {
+            current->iov_base = (char*)current->iov_base + done;
+            current->iov_len -= done;
+        }
+    }
+#endif
+
+    return CSHSSC_NONE;
+}
+
+// Makes room for one more piece and, if in_copySize > 0, for in_copySize more bytes in the buffer, flushing if there isn't.
+static int8_t CSH_internal_sink_make_room(S_CSHStringSink* in_this, size_t in_copySize)
+{
+    if (in_this->m_pieceCount == CSH_SINK_MAX_PIECES_M || (in_this->m_bufferCapacity - in_this->m_bufferSize) < in_copySize)
+    {
+        return CSH_sink_flush(in_this);
+    }
+
+    return CSHSSC_NONE;
+}
+
+// Appends a piece to the queue, there must be room for it.
+static int8_t CSH_internal_sink_queue(S_CSHStringSink* in_this, S_CSHStringView in_view)
+{
+    in_this->m_pieces[in_this->m_pieceCount++] = in_view;
+    in_this->m_queuedSize += in_view.m_size;
+
+    return (in_this->m_queuedSize >= in_this->m_flushSize) ? CSH_sink_flush(in_this) : CSHSSC_NONE;
+}
+
+// Copies in_view into the buffer, extending the last piece when it's the run of the buffer just before.
+static int8_t CSH_internal_sink_copy(S_CSHStringSink* in_this, S_CSHStringView in_view)
+{
+    CSHCharPtr_t bufferEnd = in_this->m_buffer + in_this->m_bufferSize;
+    bool extendsLast = (in_this->m_pieceCount > 0 && 
+        (in_this->m_pieces[in_this->m_pieceCount - 1].m_strPtr + in_this->m_pieces[in_this->m_pieceCount - 1].m_size) == bufferEnd);
+
+    if (!extendsLast || (in_this->m_bufferCapacity - in_this->m_bufferSize) < in_view.m_size)
+    {
+        int8_t result = CSH_internal_sink_make_room(in_this, in_view.m_size);
+        if (result < 0)
+        {
+            return result;
+        }
+        bufferEnd = in_this->m_buffer + in_this->m_bufferSize;
+        extendsLast = (in_this->m_pieceCount > 0 && 
+            (in_this->m_pieces[in_this->m_pieceCount - 1].m_strPtr + in_this->m_pieces[in_this->m_pieceCount - 1].m_size) == bufferEnd);
+    }
+
+    memcpy(bufferEnd, in_view.m_strPtr, in_view.m_size);
+    in_this->m_bufferSize += in_view.m_size;
+    if (extendsLast)
+    {
+        in_this->m_pieces[in_this->m_pieceCount - 1].m_size += in_view.m_size;
+        in_this->m_queuedSize += in_view.m_size;
+        return (in_this->m_queuedSize >= in_this->m_flushSize) ? CSH_sink_flush(in_this) : CSHSSC_NONE;
+    }
+
+    return CSH_internal_sink_queue(in_this, CSH_string_view_buffer(bufferEnd, in_view.m_size));
+}
+
+int8_t CSH_sink_init(S_CSHStringSink* in_this, int in_fileDescriptor, size_t in_bufferSize, const S_CSHAllocator* in_allocator)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    in_this->m_fileDescriptor = in_fileDescriptor;
+    in_this->m_bufferSize = 0;
+    in_this->m_bufferCapacity = (in_bufferSize > 0) ? in_bufferSize : CSH_SINK_DEFAULT_BUFFER_SIZE_M;
+    in_this->m_pieceCount = 0;
+    in_this->m_queuedSize = 0;
+    in_this->m_flushSize = in_this->m_bufferCapacity * 4;
+    in_this->m_maxCstrSize = CSH_STRING_MAX_CSTR_CHAR_COUNT_M + 1;
+    in_this->m_allocator = CSH_allocator_resolve(in_allocator);
+    in_this->m_buffer = (CSHCharPtr_t)CSH_allocator_alloc(in_this->m_allocator, in_this->m_bufferCapacity);
+
+    if (in_this->m_buffer == NULL)
+    {
+        in_this->m_bufferCapacity = 0;
+        return CSHSSC_ALLOC_FAILED;
+    }
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_sink_free(S_CSHStringSink* in_this)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    int8_t result = CSH_sink_flush(in_this);
+    CSH_allocator_free(in_this->m_allocator, in_this->m_buffer, in_this->m_bufferCapacity);
+    in_this->m_buffer = NULL;
+    in_this->m_bufferCapacity = 0;
+
+    return result;
+}
+
+int8_t CSH_sink_write(S_CSHStringSink* in_this, S_CSHStringView in_view)
+{
+    if (in_this == NULL || in_view.m_strPtr == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+    if (in_view.m_size == 0)
+    {
+        return CSHSSC_NONE;
+    }
+    if (in_view.m_size < in_this->m_bufferCapacity)
+    {
+        return CSH_internal_sink_copy(in_this, in_view);
+    }
+
+    // Too big to copy, so it's written now, along with everything queued before it.
+    int8_t result = CSH_internal_sink_make_room(in_this, 0);
+    if (result < 0)
+    {
+        return result;
+    }
+    in_this->m_pieces[in_this->m_pieceCount++] = in_view;
+    in_this->m_queuedSize += in_view.m_size;
+
+    return CSH_sink_flush(in_this);
+}
+
+int8_t CSH_sink_write_string(S_CSHStringSink* in_this, S_CSHString* in_str)
+{
+    return CSH_sink_write(in_this, CSH_string_view(in_str));
+}
+
+int8_t CSH_sink_write_cstr(S_CSHStringSink* in_this, CSHConstCharPtr_t in_str)
+{
+    if (in_this == NULL || in_str == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+
+    size_t result = CSH_STRNLEN_MF(in_str, in_this->m_maxCstrSize);
+    if (result == in_this->m_maxCstrSize)
+    {
+        return CSHSSC_CSTR_DOESNT_FIT;
+    }
+
+    return CSH_sink_write(in_this, CSH_string_view_buffer(in_str, result));
+}
+
+int8_t CSH_sink_write_ref(S_CSHStringSink* in_this, S_CSHStringView in_view)
+{
+    if (in_this == NULL || in_view.m_strPtr == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+    if (in_view.m_size == 0)
+    {
+        return CSHSSC_NONE;
+    }
+    if (in_view.m_size < CSH_SINK_REF_MIN_SIZE_M && in_view.m_size < in_this->m_bufferCapacity)
+    {
+        return CSH_internal_sink_copy(in_this, in_view);
+    }
+
+    int8_t result = CSH_internal_sink_make_room(in_this, 0);
+    if (result < 0)
+    {
+        return result;
+    }
+
+    return CSH_internal_sink_queue(in_this, in_view);
+}
+
+int8_t CSH_sink_write_string_ref(S_CSHStringSink* in_this, S_CSHString* in_str)
+{
+    return CSH_sink_write_ref(in_this, CSH_string_view(in_str));
+}
+
+int8_t CSH_sink_flush(S_CSHStringSink* in_this)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    int8_t result = CSHSSC_NONE;
+    if (in_this->m_pieceCount > 0)
+    {
+        result = CSH_internal_sink_write_pieces(in_this->m_fileDescriptor, in_this->m_pieces, in_this->m_pieceCount);
+    }
+
+    in_this->m_bufferSize = 0;
+    in_this->m_pieceCount = 0;
+    in_this->m_queuedSize = 0;
+
+    return result;
+}
@@ -0,0 +1,87 @@
+#ifndef CSH_STRING_SINK_H
+#define CSH_STRING_SINK_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "CSHAllocator.h"
+#include "CSHString.h"
+
+// [ #define CSH_SINK_DEFAULT_BUFFER_SIZE_M ]
+// The size in bytes of a sink's copy buffer, when 0 is passed to CSH_sink_init.
+
+// [ #define CSH_SINK_MAX_PIECES_M ]
+// The most pieces (runs of copied bytes and referenced writes) a sink queues before it flushes, kept well under IOV_MAX.
+
+// [ #define CSH_SINK_REF_MIN_SIZE_M ]
+// Writes queued with CSH_sink_write_ref which are smaller than this are copied anyway, since copying them costs less than an extra iovec.
+
+#define CSH_SINK_DEFAULT_BUFFER_SIZE_M (64 * 1024)
+#define CSH_SINK_MAX_PIECES_M 64
+#define CSH_SINK_REF_MIN_SIZE_M 1024
+
+// [ typedef struct S_CSHStringSink ]
+// Buffered output to a file descriptor (a file, pipe or socket), which writes many strings with one writev call.
+// Small writes are copied into the buffer, large ones are queued as references to the caller's memory, so they're never copied.
+// The queue is flushed when the buffer is full, when CSH_SINK_MAX_PIECES_M pieces are queued, or when m_flushSize bytes are queued.
+// m_fileDescriptor: Where the output is written, the sink doesn't close it.
+// m_buffer: The copy buffer, small writes are appended to it.
+// m_bufferSize: The number of bytes of m_buffer in use.
+// m_bufferCapacity: The size of m_buffer in bytes.
+// m_pieces: The queued output in order, each either a run of m_buffer or the memory of a referenced write.
+// m_pieceCount: The number of queued pieces.
+// m_queuedSize: The total size of the queued pieces in bytes.
+// m_flushSize: The queued size which triggers a flush, (4 * m_bufferCapacity) after init, it can be changed at any time.
+// m_maxCstrSize: The maximum size of a cstr passed to CSH_sink_write_cstr, plus 1, the same as S_CSHString's m_maxCstrSize.
+// m_allocator: The allocator m_buffer comes from.
+typedef struct
+{
+    int m_fileDescriptor;
+    CSHCharPtr_t m_buffer;
+    size_t m_bufferSize;
+    size_t m_bufferCapacity;
+    S_CSHStringView m_pieces[CSH_SINK_MAX_PIECES_M];
+    size_t m_pieceCount;
+    size_t m_queuedSize;
+    size_t m_flushSize;
+    size_t m_maxCstrSize;
+    const S_CSHAllocator* m_allocator;
+} S_CSHStringSink;
+
+// [ int8_t CSH_sink_init(S_CSHStringSink* in_this, int in_fileDescriptor, size_t in_bufferSize, const S_CSHAllocator* in_allocator) ]
+// Creates a sink writing to in_fileDescriptor (such as fileno(stdout), don't mix it with stdio writes to the same FILE), 
+// with a in_bufferSize byte buffer (0 uses CSH_SINK_DEFAULT_BUFFER_SIZE_M) from in_allocator (NULL uses the default allocator).
+// Returns CSHSSC_ALLOC_FAILED if the buffer couldn't be allocated.
+
+// [ int8_t CSH_sink_free(S_CSHStringSink* in_this) ]
+// Flushes the sink and frees its buffer, returning the result of the flush. The file descriptor is left open.
+
+int8_t CSH_sink_init(S_CSHStringSink* in_this, int in_fileDescriptor, size_t in_bufferSize, const S_CSHAllocator* in_allocator);
+int8_t CSH_sink_free(S_CSHStringSink* in_this);
+
+// [ int8_t CSH_sink_write(S_CSHStringSink* in_this, S_CSHStringView in_view),
+//   int8_t CSH_sink_write_string(S_CSHStringSink* in_this, S_CSHString* in_str),
+//   int8_t CSH_sink_write_cstr(S_CSHStringSink* in_this, CSHConstCharPtr_t in_str) ]
+// Queues the characters for output. The memory can be reused as soon as these return: 
+// anything smaller than the buffer is copied into it, and anything larger is written straight away, in the same writev as the queue before it.
+
+// [ int8_t CSH_sink_write_ref(S_CSHStringSink* in_this, S_CSHStringView in_view),
+//   int8_t CSH_sink_write_string_ref(S_CSHStringSink* in_this, S_CSHString* in_str) ]
+// Queues the characters by reference, they're only read when the queue is flushed, so they must stay valid and unchanged until 
+// the next explicit CSH_sink_flush (or CSH_sink_free). Views smaller than CSH_SINK_REF_MIN_SIZE_M are copied instead.
+
+// Every write returns CSHSSC_IO_FAILED if it caused a flush which failed, see CSH_sink_flush.
+
+int8_t CSH_sink_write(S_CSHStringSink* in_this, S_CSHStringView in_view);
+int8_t CSH_sink_write_string(S_CSHStringSink* in_this, S_CSHString* in_str);
+int8_t CSH_sink_write_cstr(S_CSHStringSink* in_this, CSHConstCharPtr_t in_str);
+int8_t CSH_sink_write_ref(S_CSHStringSink* in_this, S_CSHStringView in_view);
+int8_t CSH_sink_write_string_ref(S_CSHStringSink* in_this, S_CSHString* in_str);
+
+// [ int8_t CSH_sink_flush(S_CSHStringSink* in_this) ]
+// Writes everything queued with as few writev calls as possible, retrying partial writes and interrupted calls.
+// Returns CSHSSC_IO_FAILED if writing fails (errno is left as writev set it), the output which wasn't written is dropped either way.
+// On Windows, which has no writev, each piece is written with its own _write call, which still avoids copying the referenced pieces.
+
+int8_t CSH_sink_flush(S_CSHStringSink* in_this);
+
+#endif
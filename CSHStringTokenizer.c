@@ -0,0 +1,156 @@
+#include "CSHStringTokenizer.h"
+#include "CSHStringKernels.h"
+#include <string.h>
+
+// The slice vector's functions are inline in CSHStringTokenizer.h, these declarations emit their external definitions here, 
+// for calls the compiler doesn't inline (such as the vec_grow below in an unoptimized build).
+extern inline const S_CSHAllocator* vec_allocator_CSHStringSlice(S_VecData_CSHStringSlice* in_vec);
+extern inline bool vec_set_capacity_CSHStringSlice(S_VecData_CSHStringSlice* in_vec, size_t in_capacity);
+extern inline bool vec_grow_CSHStringSlice(S_VecData_CSHStringSlice* in_vec, size_t in_size);
+extern inline bool vec_push_back_CSHStringSlice(S_VecData_CSHStringSlice* in_vec, S_CSHStringSlice in_data);
+extern inline S_CSHStringSlice vec_pop_back_CSHStringSlice(S_VecData_CSHStringSlice* in_vec);
+extern inline void vec_clear_CSHStringSlice(S_VecData_CSHStringSlice* in_vec);
+extern inline void vec_shrink_to_fit_CSHStringSlice(S_VecData_CSHStringSlice* in_vec);
+extern inline void vec_erase_CSHStringSlice(S_VecData_CSHStringSlice* in_vec, size_t in_index);
+extern inline bool vec_reserve_CSHStringSlice(S_VecData_CSHStringSlice* in_vec, size_t in_size);
+extern inline bool vec_insert_range_CSHStringSlice(S_VecData_CSHStringSlice* in_vec, size_t in_index, const S_CSHStringSlice* in_data, size_t in_count);
+extern inline bool vec_insert_CSHStringSlice(S_VecData_CSHStringSlice* in_vec, size_t in_index, S_CSHStringSlice in_data);
+extern inline bool vec_append_range_CSHStringSlice(S_VecData_CSHStringSlice* in_vec, const S_CSHStringSlice* in_data, size_t in_count);
+extern inline bool vec_resize_CSHStringSlice(S_VecData_CSHStringSlice* in_vec, size_t in_size, S_CSHStringSlice in_value);
+
+static int8_t CSH_internal_tokenizer_init(S_CSHTokenizer* in_this, S_CSHStringView in_view, S_CSHStringView in_delimiters, int8_t in_mode)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+    if (in_view.m_strPtr == NULL)
+    {
+        return CSHSSC_BAD_INPUT_STR;
+    }
+    if (in_delimiters.m_strPtr == NULL || in_delimiters.m_size == 0)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    in_this->m_view = in_view;
+    in_this->m_pos = 0;
+    in_this->m_delimiters = in_delimiters;
+    in_this->m_mode = in_mode;
+    in_this->m_skipEmpty = false;
+    in_this->m_done = false;
+
+    return CSHSSC_NONE;
+}
+
+int8_t CSH_tokenizer_init_char(S_CSHTokenizer* in_this, S_CSHStringView in_view, CSHChar_t in_delimiter)
+{
+    if (in_this == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    int8_t result = CSH_internal_tokenizer_init(in_this, in_view, CSH_string_view_buffer(&in_delimiter, 1), CSHTM_CHAR);
+    // The delimiter is kept in the tokenizer itself (not pointed to by m_delimiters), so the tokenizer can still be copied.
+    in_this->m_delimiters = CSH_STRING_VIEW_DEFAULT_M;
+    in_this->m_delimiter = in_delimiter;
+
+    return result;
+}
+
+int8_t CSH_tokenizer_init_set(S_CSHTokenizer* in_this, S_CSHStringView in_view, S_CSHStringView in_delimiters)
+{
+    return CSH_internal_tokenizer_init(in_this, in_view, in_delimiters, CSHTM_SET);
+}
+
+int8_t CSH_tokenizer_init_separator(S_CSHTokenizer* in_this, S_CSHStringView in_view, S_CSHStringView in_separator)
+{
+    return CSH_internal_tokenizer_init(in_this, in_view, in_separator, CSHTM_SEPARATOR);
+}
+
+bool CSH_tokenizer_next(S_CSHTokenizer* in_this, S_CSHStringSlice* out_slice)
+{
+    if (in_this == NULL || out_slice == NULL)
+    {
+        return false;
+    }
+
+    CSHConstCharPtr_t delimiters = (in_this->m_mode == CSHTM_CHAR) ? &in_this->m_delimiter : in_this->m_delimiters.m_strPtr;
+    size_t delimitersSize = (in_this->m_mode == CSHTM_CHAR) ? 1 : in_this->m_delimiters.m_size;
+
+    while (!in_this->m_done)
+    {
+        CSHConstCharPtr_t start = in_this->m_view.m_strPtr + in_this->m_pos;
+        size_t remaining = in_this->m_view.m_size - in_this->m_pos;
+        size_t found = (in_this->m_mode == CSHTM_SEPARATOR) ? 
+            CSH_kernel_find(start, remaining, delimiters, delimitersSize) :
+            CSH_kernel_find_any(start, remaining, delimiters, delimitersSize);
+
+        S_CSHStringSlice slice = {in_this->m_pos, remaining};
+        if (found == CSH_STRING_NPOS)
+        {
+            in_this->m_pos = in_this->m_view.m_size;
+            in_this->m_done = true;
+        }
+        else
+        {
+            slice.m_size = found;
+            // A set delimiter is one character, a separator is all of it.
+            in_this->m_pos += found + ((in_this->m_mode == CSHTM_SEPARATOR) ? delimitersSize : 1);
+        }
+
+        if (slice.m_size > 0 || !in_this->m_skipEmpty)
+        {
+            *out_slice = slice;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+S_CSHStringView CSH_tokenizer_view(const S_CSHTokenizer* in_this, S_CSHStringSlice in_slice)
+{
+    if (in_this == NULL)
+    {
+        return CSH_STRING_VIEW_DEFAULT_M;
+    }
+
+    return CSH_string_view_substr(in_this->m_view, in_slice.m_offset, in_slice.m_size);
+}
+
+size_t CSH_tokenizer_fill(S_CSHTokenizer* in_this, S_CSHStringSlice* out_slices, size_t in_maxCount)
+{
+    if (out_slices == NULL)
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    while (count < in_maxCount && CSH_tokenizer_next(in_this, &out_slices[count]))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+int8_t CSH_tokenizer_fill_vec(S_CSHTokenizer* in_this, S_VecData_CSHStringSlice* io_vec)
+{
+    if (in_this == NULL || io_vec == NULL)
+    {
+        return CSHSSC_BAD_INPUT_ARG;
+    }
+
+    while (!in_this->m_done)
+    {
+        if (io_vec->m_size == io_vec->m_capacity && !vec_grow_CSHStringSlice(io_vec, io_vec->m_size + 1))
+        {
+            return CSHSSC_ALLOC_FAILED;
+        }
+
+        io_vec->m_size += CSH_tokenizer_fill(in_this, io_vec->m_data + io_vec->m_size, io_vec->m_capacity - io_vec->m_size);
+    }
+
+    return CSHSSC_NONE;
+}
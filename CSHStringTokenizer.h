@@ -0,0 +1,96 @@
+#ifndef CSH_STRING_TOKENIZER_H
+#define CSH_STRING_TOKENIZER_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "CSHString.h"
+#include "GenericVector.h"
+
+// [ typedef struct S_CSHStringSlice ]
+// A token found by a S_CSHTokenizer, as a position in the tokenized view rather than a copy.
+// m_offset: The position of the token's first character.
+// m_size: The number of characters in the token.
+typedef struct
+{
+    size_t m_offset;
+    size_t m_size;
+} S_CSHStringSlice;
+
+// The external definitions of this vector's inline functions are emitted by CSHStringTokenizer.c.
+#ifndef G_VEC_CSHStringSlice
+#define G_VEC_CSHStringSlice
+CREATE_GEN_VEC_M(S_CSHStringSlice, CSHStringSlice);
+#endif
+
+enum E_CSHTokenizerModes
+{
+    // Tokens are separated by m_delimiter.
+    CSHTM_CHAR = 0,
+    // Tokens are separated by any one of a set of characters.
+    CSHTM_SET,
+    // Tokens are separated by a whole multi character separator.
+    CSHTM_SEPARATOR
+};
+
+// [ typedef struct S_CSHTokenizer ]
+// Splits a view into tokens without allocating or copying, each call to CSH_tokenizer_next scans on from the end of the last token.
+// The view and the delimiters are not copied, so they must stay valid and unchanged while the tokenizer is used.
+// m_view: The view being tokenized.
+// m_pos: Where the next token starts.
+// m_delimiters: The delimiter characters (CSHTM_SET) or the separator (CSHTM_SEPARATOR), unused for CSHTM_CHAR.
+// m_delimiter: The delimiter for CSHTM_CHAR.
+// m_mode: One of E_CSHTokenizerModes.
+// m_skipEmpty: Whether empty tokens (between adjacent delimiters, or at either end) are skipped, false after init.
+//  Set it to true to treat runs of delimiters as one, the same as strtok.
+// m_done: Whether the last token has been returned.
+typedef struct
+{
+    S_CSHStringView m_view;
+    size_t m_pos;
+    S_CSHStringView m_delimiters;
+    CSHChar_t m_delimiter;
+    int8_t m_mode;
+    bool m_skipEmpty;
+    bool m_done;
+} S_CSHTokenizer;
+
+// [ int8_t CSH_tokenizer_init_char(S_CSHTokenizer* in_this, S_CSHStringView in_view, CSHChar_t in_delimiter),
+//   int8_t CSH_tokenizer_init_set(S_CSHTokenizer* in_this, S_CSHStringView in_view, S_CSHStringView in_delimiters),
+//   int8_t CSH_tokenizer_init_separator(S_CSHTokenizer* in_this, S_CSHStringView in_view, S_CSHStringView in_separator) ]
+// Starts tokenizing in_view, split on one character, on any character of in_delimiters (" \t\r\n"), or on the whole of in_separator ("\r\n", ", ").
+// Use CSH_string_view to tokenize a S_CSHString, and CSH_string_view_cstr or CSH_string_view_buffer for cstrs and raw buffers.
+// Without m_skipEmpty, N delimiters always give N + 1 tokens, so an empty view gives one empty token.
+// Delimiters are found with CSH_kernel_find_any (SIMD for up to CSH_KERNEL_FIND_ANY_SIMD_MAX_M characters) and separators with CSH_kernel_find.
+// Returns CSHSSC_BAD_INPUT_STR for an invalid view, or CSHSSC_BAD_INPUT_ARG for an invalid or empty set or separator.
+
+int8_t CSH_tokenizer_init_char(S_CSHTokenizer* in_this, S_CSHStringView in_view, CSHChar_t in_delimiter);
+int8_t CSH_tokenizer_init_set(S_CSHTokenizer* in_this, S_CSHStringView in_view, S_CSHStringView in_delimiters);
+int8_t CSH_tokenizer_init_separator(S_CSHTokenizer* in_this, S_CSHStringView in_view, S_CSHStringView in_separator);
+
+// [ bool CSH_tokenizer_next(S_CSHTokenizer* in_this, S_CSHStringSlice* out_slice) ]
+// Finds the next token, returning false once there are no more.
+//
+// S_CSHStringSlice slice;
+// while (CSH_tokenizer_next(&tokenizer, &slice))
+// {
+//     S_CSHStringView token = CSH_tokenizer_view(&tokenizer, slice);
+// }
+
+// [ S_CSHStringView CSH_tokenizer_view(const S_CSHTokenizer* in_this, S_CSHStringSlice in_slice) ]
+// The characters of a slice returned by this tokenizer.
+
+bool CSH_tokenizer_next(S_CSHTokenizer* in_this, S_CSHStringSlice* out_slice);
+S_CSHStringView CSH_tokenizer_view(const S_CSHTokenizer* in_this, S_CSHStringSlice in_slice);
+
+// [ size_t CSH_tokenizer_fill(S_CSHTokenizer* in_this, S_CSHStringSlice* out_slices, size_t in_maxCount) ]
+// Writes up to in_maxCount of the remaining tokens to out_slices, returning how many were written. 
+// Fewer than in_maxCount means the tokenizer is done.
+
+// [ int8_t CSH_tokenizer_fill_vec(S_CSHTokenizer* in_this, S_VecData_CSHStringSlice* io_vec) ]
+// Appends all the remaining tokens to io_vec, growing it geometrically and filling its spare capacity in bulk.
+// Returns CSHSSC_ALLOC_FAILED if it couldn't grow, with the tokens that fit appended.
+
+size_t CSH_tokenizer_fill(S_CSHTokenizer* in_this, S_CSHStringSlice* out_slices, size_t in_maxCount);
+int8_t CSH_tokenizer_fill_vec(S_CSHTokenizer* in_this, S_VecData_CSHStringSlice* io_vec);
+
+#endif
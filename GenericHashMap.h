@@ -0,0 +1,323 @@
+#ifndef GENERIC_HASH_MAP_H
+#define GENERIC_HASH_MAP_H
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "CSHAllocator.h"
+#include "CSHString.h"
+#include "CSHStringKernels.h"
+
+#if CSH_SIMD_SSE2_M
+#include <emmintrin.h>
+#endif
+
+#define G_MAP_DATA_M(T) S_MapData_##T
+#define G_MAP_ENTRY_M(T) S_MapEntry_##T
+#define G_MAP_INSERT_M(T) map_insert_##T
+#define G_MAP_FIND_M(T) map_find_##T
+#define G_MAP_ERASE_M(T) map_erase_##T
+#define G_MAP_RESERVE_M(T) map_reserve_##T
+#define G_MAP_CLEAR_M(T) map_clear_##T
+#define G_MAP_NEXT_M(T) map_next_##T
+
+#define G_MAP_DATA_DEFAULT_M(T) (G_MAP_DATA_M(T)){NULL, NULL, 0, 0, 0, NULL}
+// Creates an empty map which allocates its memory from in_allocator, see CSHAllocator.h.
+#define G_MAP_DATA_ALLOCATOR_M(T, in_allocator) (G_MAP_DATA_M(T)){NULL, NULL, 0, 0, 0, in_allocator}
+
+// SwissTable style control bytes, one per slot. 
+// A full slot stores the low 7 bits of its key's hash (so the high bit is clear), empty and deleted slots have the high bit set.
+// The first G_MAP_GROUP_WIDTH_M control bytes are mirrored after the last slot, so a group can be loaded from any slot without wrapping.
+#define G_MAP_CTRL_EMPTY_M ((uint8_t)0x80)
+#define G_MAP_CTRL_DELETED_M ((uint8_t)0xFE)
+#define G_MAP_GROUP_WIDTH_M 16
+#define G_MAP_MIN_CAPACITY_M 16
+
+// Helpers for maps whose keys can be compared and copied directly (integers, pointers, enums), for use as CREATE_GEN_MAP_M arguments.
+#define G_MAP_KEY_EQUAL_MF(in_key, in_lookup) (*(in_key) == (in_lookup))
+#define G_MAP_KEY_IDENTITY_MF(in_key) (*(in_key))
+#define G_MAP_KEY_NO_FREE_MF(in_key) ((void)(in_key))
+#define G_MAP_KEY_HASH_MF(in_lookup) CSH_kernel_hash((const char*)&(in_lookup), sizeof(in_lookup), 0)
+
+// Helpers for maps keyed by S_CSHString and looked up by S_CSHStringView, see CREATE_GEN_STRING_MAP_M.
+#define G_MAP_STRING_EQUAL_MF(in_key, in_lookup) (CSH_string_view_compare(CSH_string_view(in_key), (in_lookup)) == CSHSSC_NONE)
+#define G_MAP_STRING_VIEW_MF(in_key) CSH_string_view(in_key)
+#define G_MAP_STRING_FREE_MF(in_key) CSH_string_free(in_key)
+
+// [ #define G_MAP_GROUP_MATCH_MF(in_ctrl, in_byte), #define G_MAP_GROUP_MATCH_FREE_MF(in_ctrl) ]
+// Evaluate to a bit mask with bit i set for each of the G_MAP_GROUP_WIDTH_M control bytes at in_ctrl which equal in_byte, or are empty/deleted.
+// These are macros rather than functions so the generated map functions stay self contained, the SSE2 versions compile to a handful of instructions.
+#if CSH_SIMD_SSE2_M
+    #define G_MAP_GROUP_MATCH_MF(in_ctrl, in_byte) ((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(in_ctrl)), _mm_set1_epi8((char)(in_byte)))))
+    #define G_MAP_GROUP_MATCH_FREE_MF(in_ctrl) ((uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(in_ctrl))))
+#else
+    #define G_MAP_GROUP_MATCH_MF(in_ctrl, in_byte) CSH_kernel_match_bytes16((in_ctrl), (in_byte))
+    #define G_MAP_GROUP_MATCH_FREE_MF(in_ctrl) CSH_kernel_match_high_bits16(in_ctrl)
+#endif
+
+#if defined(_MSC_VER)
+    #define G_MAP_LOWEST_BIT_MF(in_mask) CSH_kernel_ctz32(in_mask)
+#else
+    #define G_MAP_LOWEST_BIT_MF(in_mask) ((uint32_t)__builtin_ctz(in_mask))
+#endif
+
+// Remember to enclose a call to this within an ifndef, define, endif block, the same as CREATE_GEN_VEC_M. See below for an example.
+//
+// #ifndef G_MAP_int_float
+// #define G_MAP_int_float
+// CREATE_GEN_MAP_M(int, float, int_float, int, G_MAP_KEY_HASH_MF, G_MAP_KEY_EQUAL_MF, G_MAP_KEY_IDENTITY_MF, G_MAP_KEY_NO_FREE_MF);
+// #endif
+//
+// K: The key type stored in the map.
+// V: The value type stored in the map.
+// Y: The suffix of the generated names.
+// L: The type keys are looked up by, which can differ from K so lookups don't need an owning key (S_CSHStringView for S_CSHString keys).
+// HASH_F(L in_lookup): Evaluates to the uint64_t hash of a lookup key.
+// EQUAL_F(const K* in_key, L in_lookup): Evaluates to true if a stored key matches a lookup key.
+// KEY_VIEW_F(K* in_key): Evaluates to the lookup key (L) for a stored key, which must hash the same as HASH_F does.
+// KEY_FREE_F(K* in_key): Releases a stored key, called when the map is cleared or a key is erased or replaced.
+//
+// The map is open addressing, with the slots split into groups of 16 which are probed with one SIMD compare of their control bytes,
+// so most lookups touch one group of control bytes and a single entry. The map grows by doubling once 7/8ths of its slots are used.
+// Pointers to entries are invalidated by any insert which grows the map.
+//
+#define CREATE_GEN_MAP_M(K, V, Y, L, HASH_F, EQUAL_F, KEY_VIEW_F, KEY_FREE_F) \
+\
+typedef struct \
+{ \
+	K m_key; \
+	V m_value; \
+} S_MapEntry_##Y; \
+\
+typedef struct \
+{ \
+	uint8_t* m_ctrl; \
+	S_MapEntry_##Y* m_entries; \
+	size_t m_size; \
+	size_t m_capacity; \
+	size_t m_growthLeft; \
+	const S_CSHAllocator* m_allocator; \
+} S_MapData_##Y; \
+\
+inline const S_CSHAllocator* map_allocator_##Y(S_MapData_##Y * in_map) \
+{ \
+	if (in_map->m_allocator == NULL) \
+	{ \
+		in_map->m_allocator = CSH_allocator_get_default(); \
+	} \
+	return in_map->m_allocator; \
+} \
+\
+inline void map_set_ctrl_##Y(S_MapData_##Y * in_map, size_t in_index, uint8_t in_ctrl) \
+{ \
+	in_map->m_ctrl[in_index] = in_ctrl; \
+	if (in_index < G_MAP_GROUP_WIDTH_M) \
+	{ \
+		in_map->m_ctrl[in_map->m_capacity + in_index] = in_ctrl; \
+	} \
+} \
+\
+/* Returns the first empty or deleted slot along in_hash's probe sequence. */ \
+inline size_t map_find_free_##Y(const S_MapData_##Y * in_map, uint64_t in_hash) \
+{ \
+	size_t mask = in_map->m_capacity - 1; \
+	size_t pos = (size_t)(in_hash >> 7) & mask; \
+	for (size_t step = G_MAP_GROUP_WIDTH_M; ; step += G_MAP_GROUP_WIDTH_M) \
+	{ \
+		uint32_t freeMask = G_MAP_GROUP_MATCH_FREE_MF(in_map->m_ctrl + pos); \
+		if (freeMask != 0) \
+		{ \
+			return (pos + G_MAP_LOWEST_BIT_MF(freeMask)) & mask; \
+		} \
+		pos = (pos + step) & mask; \
+	} \
+} \
+\
+/* Moves every entry into a table with in_capacity slots, which must be a power of 2 of at least G_MAP_MIN_CAPACITY_M. */ \
+inline bool map_rehash_##Y(S_MapData_##Y * in_map, size_t in_capacity) \
+{ \
+	const S_CSHAllocator* allocator = map_allocator_##Y(in_map); \
+	uint8_t* newCtrl = (uint8_t*)CSH_allocator_alloc(allocator, in_capacity + G_MAP_GROUP_WIDTH_M); \
+	S_MapEntry_##Y* newEntries = (S_MapEntry_##Y*)CSH_allocator_alloc(allocator, in_capacity * sizeof(S_MapEntry_##Y)); \
+	if (newCtrl == NULL || newEntries == NULL) \
+	{ \
+		CSH_allocator_free(allocator, newCtrl, in_capacity + G_MAP_GROUP_WIDTH_M); \
+		CSH_allocator_free(allocator, newEntries, in_capacity * sizeof(S_MapEntry_##Y)); \
+		return false; \
+	} \
+	memset(newCtrl, G_MAP_CTRL_EMPTY_M, in_capacity + G_MAP_GROUP_WIDTH_M); \
+	\
+	S_MapData_##Y newMap = *in_map; \
+	newMap.m_ctrl = newCtrl; \
+	newMap.m_entries = newEntries; \
+	newMap.m_capacity = in_capacity; \
+	for (size_t i = 0; i < in_map->m_capacity; i++) \
+	{ \
+		if ((in_map->m_ctrl[i] & 0x80) == 0) \
+		{ \
+			uint64_t hash = HASH_F(KEY_VIEW_F(&in_map->m_entries[i].m_key)); \
+			size_t index = map_find_free_##Y(&newMap, hash); \
+			map_set_ctrl_##Y(&newMap, index, (uint8_t)(hash & 0x7F)); \
+			newEntries[index] = in_map->m_entries[i]; \
+		} \
+	} \
+	\
+	if (in_map->m_capacity > 0) \
+	{ \
+		CSH_allocator_free(allocator, in_map->m_ctrl, in_map->m_capacity + G_MAP_GROUP_WIDTH_M); \
+		CSH_allocator_free(allocator, in_map->m_entries, in_map->m_capacity * sizeof(S_MapEntry_##Y)); \
+	} \
+	in_map->m_ctrl = newCtrl; \
+	in_map->m_entries = newEntries; \
+	in_map->m_capacity = in_capacity; \
+	in_map->m_growthLeft = (in_capacity - (in_capacity / 8)) - in_map->m_size; \
+	return true; \
+} \
+\
+inline bool map_reserve_##Y(S_MapData_##Y * in_map, size_t in_size) \
+{ \
+	size_t capacity = G_MAP_MIN_CAPACITY_M; \
+	while ((capacity - (capacity / 8)) < in_size) \
+	{ \
+		capacity *= 2; \
+	} \
+	if (capacity <= in_map->m_capacity) \
+	{ \
+		return true; \
+	} \
+	return map_rehash_##Y(in_map, capacity); \
+} \
+\
+/* Returns the entry for in_key, or NULL if it isn't in the map. */ \
+inline S_MapEntry_##Y* map_find_##Y(const S_MapData_##Y * in_map, L in_key) \
+{ \
+	if (in_map->m_size == 0) \
+	{ \
+		return NULL; \
+	} \
+	\
+	uint64_t hash = HASH_F(in_key); \
+	uint8_t h2 = (uint8_t)(hash & 0x7F); \
+	size_t mask = in_map->m_capacity - 1; \
+	size_t pos = (size_t)(hash >> 7) & mask; \
+	for (size_t step = G_MAP_GROUP_WIDTH_M; ; step += G_MAP_GROUP_WIDTH_M) \
+	{ \
+		const uint8_t* group = in_map->m_ctrl + pos; \
+		for (uint32_t match = G_MAP_GROUP_MATCH_MF(group, h2); match != 0; match &= (match - 1)) \
+		{ \
+			S_MapEntry_##Y* entry = &in_map->m_entries[(pos + G_MAP_LOWEST_BIT_MF(match)) & mask]; \
+			if (EQUAL_F(&entry->m_key, in_key)) \
+			{ \
+				return entry; \
+			} \
+		} \
+		if (G_MAP_GROUP_MATCH_MF(group, G_MAP_CTRL_EMPTY_M) != 0) \
+		{ \
+			return NULL; \
+		} \
+		pos = (pos + step) & mask; \
+	} \
+} \
+\
+/* Inserts in_key with in_value, or replaces the value if the key is already in the map (in which case in_key is freed). */ \
+/* Returns the entry, or NULL if the map failed to grow. */ \
+inline S_MapEntry_##Y* map_insert_##Y(S_MapData_##Y * in_map, K in_key, V in_value) \
+{ \
+	S_MapEntry_##Y* entry = map_find_##Y(in_map, KEY_VIEW_F(&in_key)); \
+	if (entry != NULL) \
+	{ \
+		KEY_FREE_F(&in_key); \
+		entry->m_value = in_value; \
+		return entry; \
+	} \
+	\
+	if (in_map->m_capacity == 0 && !map_rehash_##Y(in_map, G_MAP_MIN_CAPACITY_M)) \
+	{ \
+		return NULL; \
+	} \
+	uint64_t hash = HASH_F(KEY_VIEW_F(&in_key)); \
+	size_t index = map_find_free_##Y(in_map, hash); \
+	if (in_map->m_ctrl[index] == G_MAP_CTRL_EMPTY_M && in_map->m_growthLeft == 0) \
+	{ \
+		/* Out of room, double unless most of the used slots are deleted entries, in which case rehashing in place reclaims them. */ \
+		size_t capacity = (in_map->m_size >= (in_map->m_capacity / 2)) ? (in_map->m_capacity * 2) : in_map->m_capacity; \
+		if (!map_rehash_##Y(in_map, capacity)) \
+		{ \
+			return NULL; \
+		} \
+		index = map_find_free_##Y(in_map, hash); \
+	} \
+	\
+	if (in_map->m_ctrl[index] == G_MAP_CTRL_EMPTY_M) \
+	{ \
+		in_map->m_growthLeft -= 1; \
+	} \
+	map_set_ctrl_##Y(in_map, index, (uint8_t)(hash & 0x7F)); \
+	in_map->m_entries[index].m_key = in_key; \
+	in_map->m_entries[index].m_value = in_value; \
+	in_map->m_size += 1; \
+	return &in_map->m_entries[index]; \
+} \
+\
+/* Removes in_key from the map, freeing the stored key. Returns false if it wasn't in the map. */ \
+inline bool map_erase_##Y(S_MapData_##Y * in_map, L in_key) \
+{ \
+	S_MapEntry_##Y* entry = map_find_##Y(in_map, in_key); \
+	if (entry == NULL) \
+	{ \
+		return false; \
+	} \
+	\
+	KEY_FREE_F(&entry->m_key); \
+	map_set_ctrl_##Y(in_map, (size_t)(entry - in_map->m_entries), G_MAP_CTRL_DELETED_M); \
+	in_map->m_size -= 1; \
+	return true; \
+} \
+\
+/* Frees every stored key and the map's memory. */ \
+inline void map_clear_##Y(S_MapData_##Y * in_map) \
+{ \
+	if (in_map->m_capacity > 0) \
+	{ \
+		for (size_t i = 0; i < in_map->m_capacity; i++) \
+		{ \
+			if ((in_map->m_ctrl[i] & 0x80) == 0) \
+			{ \
+				KEY_FREE_F(&in_map->m_entries[i].m_key); \
+			} \
+		} \
+		CSH_allocator_free(in_map->m_allocator, in_map->m_ctrl, in_map->m_capacity + G_MAP_GROUP_WIDTH_M); \
+		CSH_allocator_free(in_map->m_allocator, in_map->m_entries, in_map->m_capacity * sizeof(S_MapEntry_##Y)); \
+		in_map->m_ctrl = NULL; \
+		in_map->m_entries = NULL; \
+		in_map->m_size = 0; \
+		in_map->m_capacity = 0; \
+		in_map->m_growthLeft = 0; \
+	} \
+} \
+\
+/* Iterates the entries in no particular order, start with *io_index = 0, returns NULL once there are no more. */ \
+inline S_MapEntry_##Y* map_next_##Y(const S_MapData_##Y * in_map, size_t* io_index) \
+{ \
+	for (; *io_index < in_map->m_capacity; *io_index += 1) \
+	{ \
+		if ((in_map->m_ctrl[*io_index] & 0x80) == 0) \
+		{ \
+			*io_index += 1; \
+			return &in_map->m_entries[*io_index - 1]; \
+		} \
+	} \
+	return NULL; \
+}
+
+// Generates a map keyed by S_CSHString, which is looked up (found and erased) by S_CSHStringView, so lookups never build an owning string.
+// The map takes ownership of the key strings passed to map_insert_##Y, and frees them.
+//
+// #ifndef G_MAP_STRING_int
+// #define G_MAP_STRING_int
+// CREATE_GEN_STRING_MAP_M(int, string_int);
+// #endif
+//
+#define CREATE_GEN_STRING_MAP_M(V, Y) \
+	CREATE_GEN_MAP_M(S_CSHString, V, Y, S_CSHStringView, CSH_string_view_hash, G_MAP_STRING_EQUAL_MF, G_MAP_STRING_VIEW_MF, G_MAP_STRING_FREE_MF)
+
+#endif
@@ -2,6 +2,8 @@
 #define GENERIC_VECTOR_H
 #include <string.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include "CSHAllocator.h"
 
 #define G_VEC_DATA_M(T) S_VecData_##T
 #define G_VEC_PUSH_BACK_M(T) vec_push_back_##T
@@ -11,9 +13,16 @@
 #define G_VEC_ERASE_M(T) vec_erase_##T
 #define G_VEC_RESERVE_M(T) vec_reserve_##T
 #define G_VEC_INSERT_M(T) vec_insert_##T
+#define G_VEC_INSERT_RANGE_M(T) vec_insert_range_##T
+#define G_VEC_APPEND_RANGE_M(T) vec_append_range_##T
+#define G_VEC_RESIZE_M(T) vec_resize_##T
 
 #define G_VEC_DATA_SIZE_M(X) sizeof(X)
-#define G_VEC_DATA_DEFAULT_M(T) (G_VEC_DATA_M(T)){NULL, 0, 0, 0}
+// The capacity of a vector's first allocation, each later one doubles it, so N push backs cost O(N) copies in total.
+#define G_VEC_MIN_CAPACITY_M 8
+#define G_VEC_DATA_DEFAULT_M(T) (G_VEC_DATA_M(T)){NULL, 0, 0, 0, NULL}
+// Creates an empty vector which allocates its memory from in_allocator, see CSHAllocator.h.
+#define G_VEC_DATA_ALLOCATOR_M(T, in_allocator) (G_VEC_DATA_M(T)){NULL, 0, 0, 0, in_allocator}
 
 // Remember to enclose a call to this within an ifndef, define, endif block. See below for an example.
 // This to ensure it can be called in header files, without creating multiple defintions in a source file.
@@ -23,6 +32,17 @@
 // CREATE_GEN_VEC_M(int, int);
 // #endif
 //
+// m_allocator is the allocator the vector's memory comes from, NULL means the default allocator.
+// It is set to the default allocator the first time the vector allocates, so the same allocator is used to free it.
+//
+// Growing reallocates the data in place where the allocator can, so elements must be safe to move with memcpy (no pointers into themselves).
+// push_back, insert, insert_range, append_range and resize grow the capacity geometrically, reserve sets it to exactly in_size when it's smaller.
+// These return bool: true on success, false if the memory couldn't be allocated (or the index or range is invalid), leaving the vector unchanged.
+// push_back, insert and reserve used to return void, so callers which ignored a failed allocation should now check the result.
+// reserve also returns true when the capacity is already at least in_size.
+// insert_range and append_range copy in_count elements from in_data, which may point into the vector itself.
+// resize fills any new elements with in_value.
+//
 #define CREATE_GEN_VEC_M(X, Y) \
 \
 typedef struct \
@@ -31,29 +51,59 @@ typedef struct \
 	size_t m_size; \
 	size_t m_capacity; \
 	size_t m_dataSize; \
+	const S_CSHAllocator* m_allocator; \
 } S_VecData_##Y; \
 \
-inline void vec_push_back_##Y(S_VecData_##Y * in_vec, X in_data) \
+inline const S_CSHAllocator* vec_allocator_##Y(S_VecData_##Y * in_vec) \
 { \
-    if (in_vec->m_capacity < (in_vec->m_size + 1)) \
-    { \
-        X* tempData = (X*)malloc((in_vec->m_size + 1) * G_VEC_DATA_SIZE_M(X)); \
-        \
-        if (in_vec->m_size > 0) \
-		{ \
-        	memcpy(tempData, in_vec->m_data, in_vec->m_size * G_VEC_DATA_SIZE_M(X)); \
-            free(in_vec->m_data); \
-        } \
-		tempData[in_vec->m_size] = in_data; \
-		in_vec->m_data = tempData; \
-        in_vec->m_size += 1; \
-        in_vec->m_capacity += 1; \
-    } \
-    else \
+	if (in_vec->m_allocator == NULL) \
 	{ \
-        in_vec->m_data[in_vec->m_size] = in_data; \
-		in_vec->m_size += 1; \
-    } \
+		in_vec->m_allocator = CSH_allocator_get_default(); \
+	} \
+	return in_vec->m_allocator; \
+} \
+\
+inline bool vec_set_capacity_##Y(S_VecData_##Y * in_vec, size_t in_capacity) \
+{ \
+	if (in_capacity == 0) \
+	{ \
+		CSH_allocator_free(in_vec->m_allocator, in_vec->m_data, in_vec->m_capacity * G_VEC_DATA_SIZE_M(X)); \
+		in_vec->m_data = NULL; \
+		in_vec->m_capacity = 0; \
+		return true; \
+	} \
+	\
+	X* tempData = (X*)CSH_allocator_realloc(vec_allocator_##Y(in_vec), in_vec->m_data, in_vec->m_capacity * G_VEC_DATA_SIZE_M(X), in_capacity * G_VEC_DATA_SIZE_M(X)); \
+	if (tempData == NULL) \
+	{ \
+		return false; \
+	} \
+	in_vec->m_data = tempData; \
+	in_vec->m_capacity = in_capacity; \
+	return true; \
+} \
+\
+inline bool vec_grow_##Y(S_VecData_##Y * in_vec, size_t in_size) \
+{ \
+	if (in_vec->m_capacity >= in_size) \
+	{ \
+		return true; \
+	} \
+	\
+	size_t newCapacity = (in_vec->m_capacity > 0) ? (in_vec->m_capacity * 2) : G_VEC_MIN_CAPACITY_M; \
+	return vec_set_capacity_##Y(in_vec, (newCapacity > in_size) ? newCapacity : in_size); \
+} \
+\
+inline bool vec_push_back_##Y(S_VecData_##Y * in_vec, X in_data) \
+{ \
+	if (in_vec->m_size == in_vec->m_capacity && !vec_grow_##Y(in_vec, in_vec->m_size + 1)) \
+	{ \
+		return false; \
+	} \
+	\
+	in_vec->m_data[in_vec->m_size] = in_data; \
+	in_vec->m_size += 1; \
+	return true; \
 } \
 \
 inline X vec_pop_back_##Y(S_VecData_##Y * in_vec) \
@@ -71,7 +121,8 @@ inline void vec_clear_##Y(S_VecData_##Y * in_vec) \
 { \
 	if (in_vec->m_capacity > 0) \
 	{ \
-		free(in_vec->m_data); \
+		CSH_allocator_free(in_vec->m_allocator, in_vec->m_data, in_vec->m_capacity * G_VEC_DATA_SIZE_M(X)); \
+		in_vec->m_data = NULL; \
 		in_vec->m_size = 0; \
 		in_vec->m_capacity = 0; \
 	} \
@@ -81,11 +132,7 @@ inline void vec_shrink_to_fit_##Y(S_VecData_##Y * in_vec) \
 { \
 	if (in_vec->m_size < in_vec->m_capacity) \
 	{ \
-		X* tempData = (X*)malloc(in_vec->m_size * G_VEC_DATA_SIZE_M(X)); \
-		memcpy(tempData, in_vec->m_data, in_vec->m_size * G_VEC_DATA_SIZE_M(X)); \
-		free(in_vec->m_data); \
-		in_vec->m_data = tempData; \
-		in_vec->m_capacity = in_vec->m_size; \
+		vec_set_capacity_##Y(in_vec, in_vec->m_size); \
 	} \
 } \
 \
@@ -93,74 +140,91 @@ inline void vec_erase_##Y(S_VecData_##Y * in_vec, size_t in_index) \
 { \
 	if (in_index < in_vec->m_size) \
 	{ \
-		for (size_t i = in_index; i < (in_vec->m_size - 1); i++) \
-		{ \
-			in_vec->m_data[i] = in_vec->m_data[i + 1]; \
-		} \
+		memmove(in_vec->m_data + in_index, in_vec->m_data + in_index + 1, (in_vec->m_size - in_index - 1) * G_VEC_DATA_SIZE_M(X)); \
 		in_vec->m_size -= 1; \
 	} \
 } \
 \
-inline void vec_reserve_##Y(S_VecData_##Y * in_vec, size_t in_size) \
+inline bool vec_reserve_##Y(S_VecData_##Y * in_vec, size_t in_size) \
 { \
 	if (in_vec->m_capacity < in_size) \
 	{ \
-		X* tempData = (X*)malloc(in_size * G_VEC_DATA_SIZE_M(X)); \
-		memcpy(tempData, in_vec->m_data, in_vec->m_size * G_VEC_DATA_SIZE_M(X)); \
-		free(in_vec->m_data); \
-		in_vec->m_data = tempData; \
-		in_vec->m_capacity = in_size; \
+		return vec_set_capacity_##Y(in_vec, in_size); \
+	} \
+	return true; \
+} \
+\
+inline bool vec_insert_range_##Y(S_VecData_##Y * in_vec, size_t in_index, const X* in_data, size_t in_count) \
+{ \
+	if (in_index > in_vec->m_size || (in_data == NULL && in_count > 0)) \
+	{ \
+		return false; \
+	} \
+	if (in_count == 0) \
+	{ \
+		return true; \
+	} \
+	\
+	/* in_data may point into the vector itself, so it's found again by offset once the vector has grown and shifted. */ \
+	bool isAliased = (in_vec->m_data != NULL && in_data >= in_vec->m_data && in_data < (in_vec->m_data + in_vec->m_size)); \
+	size_t sourceIndex = isAliased ? (size_t)(in_data - in_vec->m_data) : 0; \
+	if (!vec_grow_##Y(in_vec, in_vec->m_size + in_count)) \
+	{ \
+		return false; \
+	} \
+	\
+	X* dest = in_vec->m_data + in_index; \
+	memmove(dest + in_count, dest, (in_vec->m_size - in_index) * G_VEC_DATA_SIZE_M(X)); \
+	if (!isAliased) \
+	{ \
+		memcpy(dest, in_data, in_count * G_VEC_DATA_SIZE_M(X)); \
 	} \
+	else if ((sourceIndex + in_count) <= in_index) \
+	{ \
+		memcpy(dest, in_vec->m_data + sourceIndex, in_count * G_VEC_DATA_SIZE_M(X)); \
+	} \
+	else if (sourceIndex >= in_index) \
+	{ \
+		memcpy(dest, in_vec->m_data + sourceIndex + in_count, in_count * G_VEC_DATA_SIZE_M(X)); \
+	} \
+	else \
+	{ \
+		/* The source straddles in_index, its front stayed put and its back moved up with the tail. */ \
+		size_t frontCount = in_index - sourceIndex; \
+		memcpy(dest, in_vec->m_data + sourceIndex, frontCount * G_VEC_DATA_SIZE_M(X)); \
+		memcpy(dest + frontCount, in_vec->m_data + in_index + in_count, (in_count - frontCount) * G_VEC_DATA_SIZE_M(X)); \
+	} \
+	\
+	in_vec->m_size += in_count; \
+	return true; \
+} \
+\
+inline bool vec_insert_##Y(S_VecData_##Y * in_vec, size_t in_index, X in_data) \
+{ \
+	return vec_insert_range_##Y(in_vec, in_index, &in_data, 1); \
+} \
+\
+inline bool vec_append_range_##Y(S_VecData_##Y * in_vec, const X* in_data, size_t in_count) \
+{ \
+	return vec_insert_range_##Y(in_vec, in_vec->m_size, in_data, in_count); \
 } \
 \
-inline void vec_insert_##Y(S_VecData_##Y * in_vec, size_t in_index, X in_data) \
+inline bool vec_resize_##Y(S_VecData_##Y * in_vec, size_t in_size, X in_value) \
 { \
-	if (in_index <= in_vec->m_size) \
+	if (in_size > in_vec->m_size) \
 	{ \
-		if (in_vec->m_capacity < (in_vec->m_size + 1)) \
+		if (!vec_grow_##Y(in_vec, in_size)) \
 		{ \
-			X* tempData = (X*)malloc((in_vec->m_size + 1) * G_VEC_DATA_SIZE_M(X)); \
-			for (size_t i = 0, j = 0; i < (in_vec->m_size + 1); i++) \
-			{ \
-				if (i == in_index) \
-				{ \
-					tempData[i] = in_data; \
-					continue; \
-				} \
-				\
-				if (i < in_vec->m_size) \
-				{ \
-					tempData[i] = in_vec->m_data[j]; \
-					j += 1; \
-				} \
-			} \
-			\
-			free(in_vec->m_data); \
-			in_vec->m_data = tempData; \
-			in_vec->m_size += 1; \
-			in_vec->m_capacity += 1; \
+			return false; \
 		} \
-		else \
+		for (size_t i = in_vec->m_size; i < in_size; i++) \
 		{ \
-			X replacedValue; \
-			for (size_t i = 0; i < (in_vec->m_size + 1); i++) \
-			{ \
-				if (i == in_index) \
-				{ \
-					replacedValue = in_vec->m_data[i]; \
-					in_vec->m_data[i] = in_data; \
-					continue; \
-				} \
-				if (i > in_index) \
-				{ \
-					X tempValue = in_vec->m_data[i]; \
-					in_vec->m_data[i] = replacedValue; \
-					replacedValue = tempValue; \
-				} \
-			} \
-			in_vec->m_size += 1; \
+			in_vec->m_data[i] = in_value; \
 		} \
 	} \
+	\
+	in_vec->m_size = in_size; \
+	return true; \
 }
 	
 #endif
\ No newline at end of file
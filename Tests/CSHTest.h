@@ -0,0 +1,106 @@
+#ifndef CSH_TEST_H
+#define CSH_TEST_H
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "CSHAllocator.h"
+
+// Each test in this directory is a standalone program which returns 0 once every check has passed. From the repository root:
+//
+// for test in Tests/Test*.c; do cc -std=c11 -O2 -DCSH_STRING_ASSERT_ENABLED_M=0 -I. "$test" CSH*.c -lm -o test.out && ./test.out; done
+//
+// CSH_STRING_ASSERT_ENABLED_M is turned off so failed allocations are returned as CSHSSC_ALLOC_FAILED, rather than asserted,
+// and optimisations need to be on, as the inline functions of CSHGeneralUtils.h have no external definitions.
+
+static int CSH_test_failures = 0;
+
+// [ #define CSH_TEST_CHECK_MF(in_condition) ]
+// Prints in_condition and its line if it's false, and counts it as a failure. The test carries on, so every failing check is reported.
+#define CSH_TEST_CHECK_MF(in_condition) \
+{ \
+    if (!(in_condition)) \
+    { \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #in_condition); \
+        CSH_test_failures += 1; \
+    } \
+}
+
+// [ int CSH_test_result(const char* in_name) ]
+// Prints how many checks failed, and returns what the test's main should.
+static inline int CSH_test_result(const char* in_name)
+{
+    printf("%s: %d failed\n", in_name, CSH_test_failures);
+    return (CSH_test_failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// [ typedef struct S_CSHTestAllocator ]
+// The context of CSH_TEST_ALLOCATOR_M, an allocator over malloc which counts what's allocated through it.
+// m_allocCount: The number of successful m_alloc and m_realloc calls.
+// m_liveBytes:
+//  The bytes allocated and not yet freed, as told by the sizes passed to m_free and m_realloc,
+//  so it returns to 0 only if every allocation was freed with the size it was made with.
+// m_failAfter: The number of further allocations which succeed before every one fails, SIZE_MAX never fails.
+typedef struct
+{
+    size_t m_allocCount;
+    size_t m_liveBytes;
+    size_t m_failAfter;
+} S_CSHTestAllocator;
+
+#define CSH_TEST_ALLOCATOR_DEFAULT_M (S_CSHTestAllocator){0, 0, SIZE_MAX}
+
+static inline bool CSH_test_allocator_take(S_CSHTestAllocator* in_this)
+{
+    if (in_this->m_failAfter == 0)
+    {
+        return false;
+    }
+    if (in_this->m_failAfter != SIZE_MAX)
+    {
+        in_this->m_failAfter -= 1;
+    }
+    return true;
+}
+
+static inline void* CSH_test_alloc(void* in_context, size_t in_size)
+{
+    S_CSHTestAllocator* state = (S_CSHTestAllocator*)in_context;
+    void* ptr = CSH_test_allocator_take(state) ? malloc((in_size > 0) ? in_size : 1) : NULL;
+    if (ptr != NULL)
+    {
+        state->m_allocCount += 1;
+        state->m_liveBytes += in_size;
+    }
+    return ptr;
+}
+
+static inline void* CSH_test_realloc(void* in_context, void* in_ptr, size_t in_oldSize, size_t in_newSize)
+{
+    S_CSHTestAllocator* state = (S_CSHTestAllocator*)in_context;
+    void* ptr = CSH_test_allocator_take(state) ? realloc(in_ptr, (in_newSize > 0) ? in_newSize : 1) : NULL;
+    if (ptr != NULL)
+    {
+        state->m_allocCount += 1;
+        state->m_liveBytes += in_newSize;
+        state->m_liveBytes -= (in_ptr != NULL) ? in_oldSize : 0;
+    }
+    return ptr;
+}
+
+static inline void CSH_test_free(void* in_context, void* in_ptr, size_t in_size)
+{
+    S_CSHTestAllocator* state = (S_CSHTestAllocator*)in_context;
+    if (in_ptr != NULL)
+    {
+        state->m_liveBytes -= in_size;
+        free(in_ptr);
+    }
+}
+
+// [ #define CSH_TEST_ALLOCATOR_M(in_state) ]
+// An S_CSHAllocator counting into in_state (S_CSHTestAllocator*).
+#define CSH_TEST_ALLOCATOR_M(in_state) (S_CSHAllocator){CSH_test_alloc, CSH_test_realloc, CSH_test_free, (in_state)}
+
+#endif
@@ -0,0 +1,114 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+#include "CSHStringTokenizer.h"
+
+// Everything a string allocates comes from its allocator, and is freed with the size it was allocated with.
+static void CSH_test_string_allocator(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+
+    S_CSHString str = CSH_STRING_ALLOCATOR_M(&allocator);
+    for (size_t i = 0; i < 1000; i++)
+    {
+        CSH_string_add_char(&str, 'a');
+    }
+    CSH_TEST_CHECK_MF(state.m_liveBytes == str.m_capacity);
+
+    // Strings made from another string use its allocator.
+    S_CSHString sub = CSH_string_substr(&str, 10, 500);
+    CSH_TEST_CHECK_MF(sub.m_allocator == &allocator && state.m_liveBytes == (str.m_capacity + sub.m_capacity));
+
+    // Front slack is part of the allocation, and is freed with it.
+    CSH_string_concat_left_cstr("front", &sub);
+    CSH_string_reserve_front(&sub, 100);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == (str.m_capacity + sub.m_frontSlack + sub.m_capacity));
+
+    CSH_string_free(&sub);
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+// Attaching an allocator moves a heap string's contents into memory from it.
+static void CSH_test_set_allocator(void)
+{
+    S_CSHTestAllocator oneState = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHTestAllocator twoState = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator one = CSH_TEST_ALLOCATOR_M(&oneState);
+    // Without m_realloc, growing falls back to m_alloc, memcpy and m_free.
+    S_CSHAllocator two = {CSH_test_alloc, NULL, CSH_test_free, &twoState};
+
+    S_CSHString str = CSH_STRING_ALLOCATOR_M(&one);
+    CSH_string_assign_cstr(&str, "a string long enough to be stored on the heap");
+    CSH_string_reserve_front(&str, 8);
+    CSH_TEST_CHECK_MF(CSH_string_set_allocator(&str, &two) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(oneState.m_liveBytes == 0 && twoState.m_liveBytes == str.m_capacity);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), "a string long enough to be stored on the heap") == 0);
+
+    CSH_string_concat_right(&str, &str);
+    CSH_TEST_CHECK_MF(str.m_size == 90 && strncmp(CSH_string_data(&str) + 45, "a string", 8) == 0);
+
+    // Failing to allocate in the new allocator leaves the string where it was.
+    oneState.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(CSH_string_set_allocator(&str, &one) == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(str.m_allocator == &two && str.m_size == 90);
+
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(twoState.m_liveBytes == 0 && oneState.m_liveBytes == 0);
+}
+
+// The default allocator is used by strings without one, and they keep it after the default changes.
+static void CSH_test_default_allocator(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+
+    CSH_allocator_set_default(&allocator);
+    CSH_TEST_CHECK_MF(CSH_allocator_get_default() == &allocator && CSH_allocator_resolve(NULL) == &allocator);
+    S_CSHString str = CSH_string_create_cstr("this one is long enough to be on the heap", 100);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == str.m_capacity);
+    CSH_allocator_set_default(NULL);
+    CSH_TEST_CHECK_MF(CSH_allocator_get_default() == &CSH_ALLOCATOR_HEAP);
+
+    CSH_string_assign_cstr(&str, "this one is long enough to be on the heap, and then some more");
+    CSH_TEST_CHECK_MF(state.m_liveBytes == str.m_capacity);
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+// Vectors allocate through their allocator too.
+static void CSH_test_vector_allocator(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+
+    S_VecData_CSHStringSlice vec = G_VEC_DATA_ALLOCATOR_M(CSHStringSlice, &allocator);
+    for (size_t i = 0; i < 100; i++)
+    {
+        CSH_TEST_CHECK_MF(vec_push_back_CSHStringSlice(&vec, (S_CSHStringSlice){i, 1}));
+    }
+    CSH_TEST_CHECK_MF(state.m_liveBytes == (vec.m_capacity * sizeof(S_CSHStringSlice)));
+
+    vec_reserve_CSHStringSlice(&vec, 500);
+    vec_shrink_to_fit_CSHStringSlice(&vec);
+    CSH_TEST_CHECK_MF(vec.m_capacity == 100 && state.m_liveBytes == (100 * sizeof(S_CSHStringSlice)));
+
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(!vec_push_back_CSHStringSlice(&vec, (S_CSHStringSlice){100, 1}));
+    CSH_TEST_CHECK_MF(!vec_reserve_CSHStringSlice(&vec, 1000));
+    CSH_TEST_CHECK_MF(vec.m_size == 100 && vec.m_data[99].m_offset == 99);
+    state.m_failAfter = SIZE_MAX;
+
+    vec_clear_CSHStringSlice(&vec);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_string_allocator();
+    CSH_test_set_allocator();
+    CSH_test_default_allocator();
+    CSH_test_vector_allocator();
+
+    return CSH_test_result(__FILE__);
+}
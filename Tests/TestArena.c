@@ -0,0 +1,81 @@
+#include "CSHTest.h"
+#include "CSHArena.h"
+
+// Allocations are aligned, the most recent one is grown and freed in place, and reset reuses the blocks.
+static void CSH_test_bump_allocation(void)
+{
+    S_CSHArena arena;
+    CSH_TEST_CHECK_MF(CSH_arena_init(&arena, 4096, CSHAF_NONE) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(arena.m_firstBlock == NULL);
+
+    uint8_t* one = (uint8_t*)CSH_arena_alloc(&arena, 3);
+    uint8_t* two = (uint8_t*)CSH_arena_alloc(&arena, 5);
+    CSH_TEST_CHECK_MF(one != NULL && two != NULL && two > one);
+    CSH_TEST_CHECK_MF(((uintptr_t)one % CSH_ARENA_ALIGNMENT_M) == 0 && ((uintptr_t)two % CSH_ARENA_ALIGNMENT_M) == 0);
+
+    memcpy(two, "abcde", 5);
+    uint8_t* grown = (uint8_t*)CSH_arena_realloc(&arena, two, 5, 100);
+    CSH_TEST_CHECK_MF(grown == two && memcmp(grown, "abcde", 5) == 0);
+
+    // Only the most recent allocation can grow in place, anything else is copied.
+    uint8_t* moved = (uint8_t*)CSH_arena_realloc(&arena, one, 3, 10);
+    CSH_TEST_CHECK_MF(moved != one && moved > grown);
+
+    CSH_arena_free(&arena, moved, 10);
+    uint8_t* reused = (uint8_t*)CSH_arena_alloc(&arena, 10);
+    CSH_TEST_CHECK_MF(reused == moved);
+
+    // Allocations bigger than a block get a block of their own.
+    uint8_t* big = (uint8_t*)CSH_arena_alloc(&arena, 100000);
+    CSH_TEST_CHECK_MF(big != NULL);
+    memset(big, 1, 100000);
+
+    CSH_arena_reset(&arena);
+    CSH_TEST_CHECK_MF(CSH_arena_alloc(&arena, 3) == one);
+
+    CSH_arena_release(&arena);
+    CSH_TEST_CHECK_MF(arena.m_firstBlock == NULL);
+    CSH_TEST_CHECK_MF(CSH_arena_alloc(&arena, 3) != NULL);
+    CSH_arena_release(&arena);
+}
+
+// Strings made in an arena, and the strings derived from them, allocate from it.
+static void CSH_test_arena_strings(void)
+{
+    for (uint32_t flags = CSHAF_NONE; flags <= CSHAF_HUGE_PAGES; flags++)
+    {
+        S_CSHArena arena;
+        CSH_arena_init(&arena, 0, flags);
+        for (size_t round = 0; round < 3; round++)
+        {
+            S_CSHString str = CSH_arena_string_create_cstr(&arena, "a string that is long enough for the heap", 100);
+            CSH_TEST_CHECK_MF(str.m_status == CSHSSC_NONE && str.m_allocator == CSH_ARENA_ALLOCATOR_MF(&arena));
+            for (size_t i = 0; i < 10000; i++)
+            {
+                CSH_string_add_char(&str, 'z');
+            }
+
+            S_CSHString sub = CSH_string_substr(&str, 2, 200);
+            S_CSHString joined = CSH_string_create_concat(&str, &sub);
+            CSH_TEST_CHECK_MF(sub.m_allocator == CSH_ARENA_ALLOCATOR_MF(&arena) && joined.m_allocator == CSH_ARENA_ALLOCATOR_MF(&arena));
+            CSH_TEST_CHECK_MF(joined.m_size == (str.m_size + 200) && strncmp(CSH_string_data(&joined) + str.m_size, "string", 6) == 0);
+
+            CSH_string_free(&joined);
+            CSH_string_free(&sub);
+            CSH_string_free(&str);
+            CSH_arena_reset(&arena);
+        }
+
+        S_CSHString overlong = CSH_arena_string_create_cstr(&arena, "abcdef", 5);
+        CSH_TEST_CHECK_MF(overlong.m_status == CSHSSC_BAD_INPUT_STR);
+        CSH_arena_release(&arena);
+    }
+}
+
+int main(void)
+{
+    CSH_test_bump_allocation();
+    CSH_test_arena_strings();
+
+    return CSH_test_result(__FILE__);
+}
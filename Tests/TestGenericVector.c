@@ -0,0 +1,182 @@
+#include "CSHTest.h"
+#include "GenericVector.h"
+
+#ifndef G_VEC_int
+#define G_VEC_int
+CREATE_GEN_VEC_M(int, int);
+#endif
+
+// The vector functions are inline, these declarations emit their external definitions for calls the compiler doesn't inline.
+extern inline const S_CSHAllocator* vec_allocator_int(S_VecData_int* in_vec);
+extern inline bool vec_set_capacity_int(S_VecData_int* in_vec, size_t in_capacity);
+extern inline bool vec_grow_int(S_VecData_int* in_vec, size_t in_size);
+extern inline bool vec_push_back_int(S_VecData_int* in_vec, int in_data);
+extern inline int vec_pop_back_int(S_VecData_int* in_vec);
+extern inline void vec_clear_int(S_VecData_int* in_vec);
+extern inline void vec_shrink_to_fit_int(S_VecData_int* in_vec);
+extern inline void vec_erase_int(S_VecData_int* in_vec, size_t in_index);
+extern inline bool vec_reserve_int(S_VecData_int* in_vec, size_t in_size);
+extern inline bool vec_insert_range_int(S_VecData_int* in_vec, size_t in_index, const int* in_data, size_t in_count);
+extern inline bool vec_insert_int(S_VecData_int* in_vec, size_t in_index, int in_data);
+extern inline bool vec_append_range_int(S_VecData_int* in_vec, const int* in_data, size_t in_count);
+extern inline bool vec_resize_int(S_VecData_int* in_vec, size_t in_size, int in_value);
+
+// Random push backs, inserts, erases, range inserts (often of the vector's own elements), appends and resizes agree with a plain array.
+static void CSH_test_vector_random(void)
+{
+    static int model[200000];
+    size_t modelSize = 0;
+    S_VecData_int vec = G_VEC_DATA_DEFAULT_M(int);
+    srand(3);
+
+    bool matches = true;
+    for (size_t round = 0; round < 200000 && matches; round++)
+    {
+        int value = rand();
+        switch (rand() % 9)
+        {
+        case 0:
+        case 1:
+        case 2:
+            matches = vec_push_back_int(&vec, value);
+            model[modelSize++] = value;
+            break;
+        case 3:
+            if (modelSize < 150000)
+            {
+                size_t index = (size_t)rand() % (modelSize + 1);
+                matches = vec_insert_int(&vec, index, value);
+                memmove(model + index + 1, model + index, (modelSize - index) * sizeof(int));
+                model[index] = value;
+                modelSize++;
+            }
+            break;
+        case 4:
+            if (modelSize > 0)
+            {
+                size_t index = (size_t)rand() % modelSize;
+                vec_erase_int(&vec, index);
+                memmove(model + index, model + index + 1, (modelSize - index - 1) * sizeof(int));
+                modelSize--;
+            }
+            break;
+        case 5:
+            if (modelSize > 0 && modelSize < 150000)
+            {
+                size_t index = (size_t)rand() % (modelSize + 1);
+                size_t source = (size_t)rand() % modelSize;
+                size_t count = (size_t)rand() % (modelSize - source + 1);
+                count = (count > 50) ? 50 : count;
+                int copy[50];
+                memcpy(copy, model + source, count * sizeof(int));
+                matches = vec_insert_range_int(&vec, index, vec.m_data + source, count);
+                memmove(model + index + count, model + index, (modelSize - index) * sizeof(int));
+                memcpy(model + index, copy, count * sizeof(int));
+                modelSize += count;
+            }
+            break;
+        case 6:
+            if (modelSize < 150000)
+            {
+                int values[20];
+                size_t count = (size_t)rand() % 20;
+                for (size_t i = 0; i < count; i++)
+                {
+                    values[i] = rand();
+                }
+                matches = vec_append_range_int(&vec, values, count);
+                memcpy(model + modelSize, values, count * sizeof(int));
+                modelSize += count;
+            }
+            break;
+        case 7:
+        {
+            size_t size = (size_t)rand() % (modelSize + 30);
+            size = (size > 150000) ? modelSize : size;
+            matches = vec_resize_int(&vec, size, value);
+            for (size_t i = modelSize; i < size; i++)
+            {
+                model[i] = value;
+            }
+            modelSize = size;
+            break;
+        }
+        default:
+            if ((rand() % 100) == 0)
+            {
+                vec_shrink_to_fit_int(&vec);
+                matches = (vec.m_capacity == vec.m_size);
+            }
+            break;
+        }
+        matches = matches && vec.m_size == modelSize && (modelSize == 0 || memcmp(vec.m_data, model, modelSize * sizeof(int)) == 0);
+    }
+    CSH_TEST_CHECK_MF(matches);
+    vec_clear_int(&vec);
+}
+
+// N push backs grow the capacity geometrically, so only a logarithmic number of reallocations, and reserve sets it exactly.
+static void CSH_test_vector_growth(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_VecData_int vec = G_VEC_DATA_ALLOCATOR_M(int, &allocator);
+
+    bool pushed = true;
+    for (int i = 0; i < 1000000; i++)
+    {
+        pushed = pushed && vec_push_back_int(&vec, i);
+    }
+    CSH_TEST_CHECK_MF(pushed && vec.m_size == 1000000 && state.m_allocCount <= 20);
+    CSH_TEST_CHECK_MF(vec.m_data[999999] == 999999 && vec_pop_back_int(&vec) == 999999 && vec.m_size == 999999);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == (vec.m_capacity * sizeof(int)));
+
+    vec_clear_int(&vec);
+    CSH_TEST_CHECK_MF(vec.m_size == 0 && vec.m_capacity == 0 && state.m_liveBytes == 0);
+    CSH_TEST_CHECK_MF(vec_reserve_int(&vec, 100) && vec.m_capacity == 100);
+    CSH_TEST_CHECK_MF(vec_reserve_int(&vec, 10) && vec.m_capacity == 100);
+    vec_clear_int(&vec);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+// Every growing operation returns false when it can't allocate, or for an invalid index or range, and leaves the vector as it was.
+static void CSH_test_vector_failures(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_VecData_int vec = G_VEC_DATA_ALLOCATOR_M(int, &allocator);
+
+    int values[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    CSH_TEST_CHECK_MF(vec_append_range_int(&vec, values, 8) && vec.m_capacity == 8);
+
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(!vec_push_back_int(&vec, 8));
+    CSH_TEST_CHECK_MF(!vec_insert_int(&vec, 0, 8));
+    CSH_TEST_CHECK_MF(!vec_insert_range_int(&vec, 4, vec.m_data, 8));
+    CSH_TEST_CHECK_MF(!vec_append_range_int(&vec, values, 1));
+    CSH_TEST_CHECK_MF(!vec_resize_int(&vec, 9, 8));
+    CSH_TEST_CHECK_MF(!vec_reserve_int(&vec, 9));
+    CSH_TEST_CHECK_MF(vec.m_size == 8 && vec.m_capacity == 8 && memcmp(vec.m_data, values, sizeof(values)) == 0);
+
+    // Nothing which fits in the capacity allocates.
+    CSH_TEST_CHECK_MF(vec_resize_int(&vec, 4, 0) && vec_insert_int(&vec, 0, 9) && vec_append_range_int(&vec, vec.m_data, 3));
+    CSH_TEST_CHECK_MF(vec.m_size == 8 && vec.m_data[0] == 9 && vec.m_data[5] == 9 && vec.m_data[7] == 1);
+    state.m_failAfter = SIZE_MAX;
+
+    CSH_TEST_CHECK_MF(!vec_insert_int(&vec, 9, 0) && !vec_insert_range_int(&vec, 0, NULL, 1));
+    CSH_TEST_CHECK_MF(vec_insert_range_int(&vec, 8, NULL, 0) && vec_append_range_int(&vec, values, 0) && vec.m_size == 8);
+    vec_erase_int(&vec, 8);
+    CSH_TEST_CHECK_MF(vec.m_size == 8);
+
+    vec_clear_int(&vec);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_vector_random();
+    CSH_test_vector_growth();
+    CSH_test_vector_failures();
+
+    return CSH_test_result(__FILE__);
+}
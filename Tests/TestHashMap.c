@@ -0,0 +1,206 @@
+#include "CSHTest.h"
+#include "GenericHashMap.h"
+
+// Every key hashes the same, so every lookup probes past other keys' entries and tombstones.
+#define CSH_TEST_COLLIDING_HASH_MF(in_lookup) ((void)(in_lookup), (uint64_t)0x1234)
+
+#ifndef G_MAP_int_int
+#define G_MAP_int_int
+CREATE_GEN_MAP_M(int, int, int_int, int, G_MAP_KEY_HASH_MF, G_MAP_KEY_EQUAL_MF, G_MAP_KEY_IDENTITY_MF, G_MAP_KEY_NO_FREE_MF);
+#endif
+
+#ifndef G_MAP_colliding_int
+#define G_MAP_colliding_int
+CREATE_GEN_MAP_M(int, int, colliding_int, int, CSH_TEST_COLLIDING_HASH_MF, G_MAP_KEY_EQUAL_MF, G_MAP_KEY_IDENTITY_MF, G_MAP_KEY_NO_FREE_MF);
+#endif
+
+#ifndef G_MAP_STRING_int
+#define G_MAP_STRING_int
+CREATE_GEN_STRING_MAP_M(int, string_int);
+#endif
+
+// The map functions are inline, these declarations emit their external definitions for calls the compiler doesn't inline.
+#define CSH_TEST_EMIT_MAP_MF(K, V, Y, L) \
+extern inline const S_CSHAllocator* map_allocator_##Y(S_MapData_##Y* in_map); \
+extern inline void map_set_ctrl_##Y(S_MapData_##Y* in_map, size_t in_index, uint8_t in_ctrl); \
+extern inline size_t map_find_free_##Y(const S_MapData_##Y* in_map, uint64_t in_hash); \
+extern inline bool map_rehash_##Y(S_MapData_##Y* in_map, size_t in_capacity); \
+extern inline bool map_reserve_##Y(S_MapData_##Y* in_map, size_t in_size); \
+extern inline S_MapEntry_##Y* map_find_##Y(const S_MapData_##Y* in_map, L in_key); \
+extern inline S_MapEntry_##Y* map_insert_##Y(S_MapData_##Y* in_map, K in_key, V in_value); \
+extern inline bool map_erase_##Y(S_MapData_##Y* in_map, L in_key); \
+extern inline void map_clear_##Y(S_MapData_##Y* in_map); \
+extern inline S_MapEntry_##Y* map_next_##Y(const S_MapData_##Y* in_map, size_t* io_index)
+
+CSH_TEST_EMIT_MAP_MF(int, int, int_int, int);
+CSH_TEST_EMIT_MAP_MF(int, int, colliding_int, int);
+CSH_TEST_EMIT_MAP_MF(S_CSHString, int, string_int, S_CSHStringView);
+
+// Random inserts, erases and finds agree with a plain array, and iteration visits every entry once.
+static void CSH_test_map_random(void)
+{
+    static int values[4096];
+    static bool present[4096];
+    S_MapData_int_int map = G_MAP_DATA_DEFAULT_M(int_int);
+    srand(8);
+    for (size_t round = 0; round < 300000; round++)
+    {
+        int key = rand() % 4096;
+        switch (rand() % 3)
+        {
+            case 0:
+            {
+                int value = rand();
+                CSH_TEST_CHECK_MF(map_insert_int_int(&map, key, value) != NULL);
+                values[key] = value;
+                present[key] = true;
+                break;
+            }
+            case 1:
+            {
+                CSH_TEST_CHECK_MF(map_erase_int_int(&map, key) == present[key]);
+                present[key] = false;
+                break;
+            }
+            default:
+            {
+                S_MapEntry_int_int* entry = map_find_int_int(&map, key);
+                CSH_TEST_CHECK_MF((entry != NULL) == present[key] && (entry == NULL || entry->m_value == values[key]));
+                break;
+            }
+        }
+    }
+
+    size_t expected = 0;
+    for (size_t i = 0; i < 4096; i++)
+    {
+        expected += present[i];
+    }
+    size_t visited = 0;
+    size_t index = 0;
+    for (S_MapEntry_int_int* entry = map_next_int_int(&map, &index); entry != NULL; entry = map_next_int_int(&map, &index))
+    {
+        CSH_TEST_CHECK_MF(present[entry->m_key] && entry->m_value == values[entry->m_key]);
+        visited += 1;
+    }
+    CSH_TEST_CHECK_MF(visited == expected && map.m_size == expected);
+    CSH_TEST_CHECK_MF((map.m_capacity & (map.m_capacity - 1)) == 0 && map.m_size <= (map.m_capacity - (map.m_capacity / 8)));
+
+    map_clear_int_int(&map);
+    CSH_TEST_CHECK_MF(map.m_size == 0 && map.m_capacity == 0 && map_find_int_int(&map, 1) == NULL);
+}
+
+// Keys whose hashes all collide are still found, across groups and past erased entries, and erasing and reinserting doesn't grow the map forever.
+static void CSH_test_map_collisions(void)
+{
+    S_MapData_colliding_int map = G_MAP_DATA_DEFAULT_M(colliding_int);
+    for (int i = 0; i < 100; i++)
+    {
+        map_insert_colliding_int(&map, i, i * 2);
+    }
+    for (int i = 0; i < 100; i += 2)
+    {
+        CSH_TEST_CHECK_MF(map_erase_colliding_int(&map, i));
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        S_MapEntry_colliding_int* entry = map_find_colliding_int(&map, i);
+        CSH_TEST_CHECK_MF((i % 2) == 0 ? (entry == NULL) : (entry != NULL && entry->m_value == (i * 2)));
+    }
+    CSH_TEST_CHECK_MF(map_find_colliding_int(&map, 1000) == NULL);
+
+    size_t capacity = map.m_capacity;
+    for (int round = 0; round < 100; round++)
+    {
+        map_insert_colliding_int(&map, 1000 + round, round);
+        map_erase_colliding_int(&map, 1000 + round);
+    }
+    CSH_TEST_CHECK_MF(map.m_size == 50 && map.m_capacity == capacity);
+    map_clear_colliding_int(&map);
+}
+
+// String keys are owned by the map, replaced keys are freed, and lookups use views.
+static void CSH_test_string_map(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_MapData_string_int map = G_MAP_DATA_DEFAULT_M(string_int);
+
+    char key[80];
+    for (int i = 0; i < 1000; i++)
+    {
+        snprintf(key, sizeof(key), "key-%d-%s", i, ((i % 3) != 0) ? "short" : "a considerably longer key that goes to the heap");
+        S_CSHString str = CSH_STRING_ALLOCATOR_M(&allocator);
+        CSH_string_assign_cstr(&str, key);
+        CSH_TEST_CHECK_MF(map_insert_string_int(&map, str, i) != NULL);
+    }
+    S_CSHString replaced = CSH_STRING_ALLOCATOR_M(&allocator);
+    CSH_string_assign_cstr(&replaced, "key-3-a considerably longer key that goes to the heap");
+    map_insert_string_int(&map, replaced, -3);
+    CSH_TEST_CHECK_MF(map.m_size == 1000);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        snprintf(key, sizeof(key), "key-%d-%s", i, ((i % 3) != 0) ? "short" : "a considerably longer key that goes to the heap");
+        S_MapEntry_string_int* entry = map_find_string_int(&map, CSH_string_view_cstr(key, 100));
+        CSH_TEST_CHECK_MF(entry != NULL && entry->m_value == ((i == 3) ? -3 : i));
+    }
+    CSH_TEST_CHECK_MF(map_find_string_int(&map, CSH_string_view_cstr("key-1-shor", 100)) == NULL);
+    CSH_TEST_CHECK_MF(map_find_string_int(&map, CSH_string_view_buffer("", 0)) == NULL);
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        snprintf(key, sizeof(key), "key-%d-%s", i, ((i % 3) != 0) ? "short" : "a considerably longer key that goes to the heap");
+        CSH_TEST_CHECK_MF(map_erase_string_int(&map, CSH_string_view_cstr(key, 100)));
+    }
+    CSH_TEST_CHECK_MF(map.m_size == 500);
+
+    map_clear_string_int(&map);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+// A map which can't grow returns NULL from insert, and keeps every entry it had.
+static void CSH_test_map_alloc_failure(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_MapData_int_int map = G_MAP_DATA_ALLOCATOR_M(int_int, &allocator);
+
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(map_insert_int_int(&map, 1, 1) == NULL && map.m_capacity == 0);
+    CSH_TEST_CHECK_MF(!map_reserve_int_int(&map, 100));
+
+    // The control bytes allocate but the entries don't.
+    state.m_failAfter = 1;
+    CSH_TEST_CHECK_MF(map_insert_int_int(&map, 1, 1) == NULL && state.m_liveBytes == 0);
+
+    state.m_failAfter = SIZE_MAX;
+    int key = 0;
+    while (map.m_growthLeft != 0 || map.m_size == 0)
+    {
+        map_insert_int_int(&map, key, key);
+        key += 1;
+    }
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(map_insert_int_int(&map, key, key) == NULL);
+    CSH_TEST_CHECK_MF(map_insert_int_int(&map, 0, -1) != NULL);
+    CSH_TEST_CHECK_MF(map.m_size == (size_t)key);
+    for (int i = 1; i < key; i++)
+    {
+        S_MapEntry_int_int* entry = map_find_int_int(&map, i);
+        CSH_TEST_CHECK_MF(entry != NULL && entry->m_value == i);
+    }
+
+    map_clear_int_int(&map);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_map_random();
+    CSH_test_map_collisions();
+    CSH_test_string_map();
+    CSH_test_map_alloc_failure();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,201 @@
+#include <inttypes.h>
+#include <math.h>
+#include "CSHTest.h"
+#include "CSHStringNumber.h"
+
+static uint64_t CSH_test_seed = 88172645463325252ULL;
+
+static uint64_t CSH_test_random(void)
+{
+    CSH_test_seed ^= CSH_test_seed << 13;
+    CSH_test_seed ^= CSH_test_seed >> 7;
+    CSH_test_seed ^= CSH_test_seed << 17;
+    return CSH_test_seed;
+}
+
+// Counts the significant digits of a formatted double, ignoring trailing zeros (which "1e+17" style integers don't have anyway).
+static int CSH_test_significant_digits(CSHConstCharPtr_t in_str)
+{
+    CSHConstCharPtr_t end = in_str;
+    while (*end != '\0' && *end != 'e')
+    {
+        end++;
+    }
+    int count = 0;
+    int trailing = 0;
+    bool started = false;
+    for (CSHConstCharPtr_t pos = in_str; pos < end; pos++)
+    {
+        if (*pos >= '0' && *pos <= '9')
+        {
+            started = started || (*pos != '0');
+            count += started ? 1 : 0;
+            trailing = (*pos == '0') ? (trailing + 1) : 0;
+        }
+    }
+    return count - trailing;
+}
+
+// The double reads back exactly, with no more significant digits than the shortest %.*e which also reads back.
+static bool CSH_test_check_double(double in_value)
+{
+    S_CSHString str = CSH_STRING_DEFAULT_M;
+    bool passed = (CSH_string_append_double(&str, in_value) == CSHSSC_NONE && str.m_size <= CSH_NUMBER_MAX_CHARS_M);
+    double back = strtod(CSH_string_data(&str), NULL);
+    passed = passed && (memcmp(&back, &in_value, sizeof(double)) == 0);
+    if (passed && in_value != 0.0)
+    {
+        char reference[64];
+        int digits = 1;
+        for (; digits <= 17; digits++)
+        {
+            snprintf(reference, sizeof(reference), "%.*e", (digits - 1), in_value);
+            if (strtod(reference, NULL) == in_value)
+            {
+                break;
+            }
+        }
+        passed = (CSH_test_significant_digits(CSH_string_data(&str)) <= digits);
+    }
+    CSH_string_free(&str);
+    return passed;
+}
+
+// Random bit patterns, powers of two and subnormals round trip with the shortest digits.
+static void CSH_test_double_round_trip(void)
+{
+    size_t failures = 0;
+    for (size_t i = 0; i < 300000; i++)
+    {
+        uint64_t bits = CSH_test_random();
+        if ((i % 4) == 1)
+        {
+            bits &= 0x800FFFFFFFFFFFFFULL;
+        }
+        else if ((i % 4) == 2)
+        {
+            bits &= 0xFFF0000000000000ULL | (CSH_test_random() & 0xFF);
+        }
+        double value;
+        memcpy(&value, &bits, sizeof(double));
+        if (!isinf(value) && !isnan(value))
+        {
+            failures += CSH_test_check_double(value) ? 0 : 1;
+        }
+    }
+    for (int exponent = -1074; exponent < 1024; exponent++)
+    {
+        failures += CSH_test_check_double(ldexp(1.0, exponent)) ? 0 : 1;
+    }
+    for (uint64_t bits = 1; bits < 20000; bits++)
+    {
+        double value;
+        memcpy(&value, &bits, sizeof(double));
+        failures += CSH_test_check_double(value) ? 0 : 1;
+    }
+    for (size_t i = 0; i < 20000; i++)
+    {
+        failures += CSH_test_check_double((double)(int64_t)(CSH_test_random() >> (CSH_test_random() % 64))) ? 0 : 1;
+    }
+    CSH_TEST_CHECK_MF(failures == 0);
+}
+
+// The %g style layout, and the special values.
+static void CSH_test_double_layout(void)
+{
+    struct
+    {
+        double m_value;
+        CSHConstCharPtr_t m_expected;
+    } cases[] =
+    {
+        {0.0, "0"}, {-0.0, "-0"}, {1.0, "1"}, {-1.0, "-1"}, {0.1, "0.1"}, {0.3, "0.3"}, {123.25, "123.25"}, {-1234.5678, "-1234.5678"},
+        {1e-5, "0.00001"}, {1e-6, "1e-06"}, {2.5e-6, "2.5e-06"}, {1e16, "10000000000000000"}, {1e17, "1e+17"}, {1e23, "1e+23"},
+        {9007199254740993.0, "9007199254740992"}, {1.7976931348623157e308, "1.7976931348623157e+308"}, {4.9e-324, "5e-324"},
+        {-2.2250738585072014e-308, "-2.2250738585072014e-308"}, {INFINITY, "inf"}, {-INFINITY, "-inf"}, {NAN, "nan"}
+    };
+
+    S_CSHString str = CSH_STRING_DEFAULT_M;
+    for (size_t i = 0; i < (sizeof(cases) / sizeof(cases[0])); i++)
+    {
+        CSH_string_clear(&str, false);
+        CSH_TEST_CHECK_MF(CSH_string_append_double(&str, cases[i].m_value) == CSHSSC_NONE);
+        CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), cases[i].m_expected) == 0);
+    }
+    CSH_TEST_CHECK_MF(strlen("-1.2345678901234567e-308") == CSH_NUMBER_MAX_CHARS_M);
+    CSH_string_free(&str);
+}
+
+// Integers and hex agree with printf, including the limits.
+static void CSH_test_integers(void)
+{
+    S_CSHString str = CSH_STRING_DEFAULT_M;
+    char reference[128];
+    bool matches = true;
+    for (size_t i = 0; i < 200000; i++)
+    {
+        uint64_t unsignedValue = CSH_test_random() >> (CSH_test_random() % 64);
+        int64_t signedValue = (int64_t)CSH_test_random() >> (CSH_test_random() % 64);
+        bool uppercase = ((i % 2) != 0);
+        CSH_string_clear(&str, false);
+        CSH_string_append_u64(&str, unsignedValue);
+        CSH_string_append_i64(&str, signedValue);
+        CSH_string_append_hex(&str, unsignedValue, uppercase);
+        CSH_string_append_i32(&str, (int32_t)signedValue);
+        CSH_string_append_u32(&str, (uint32_t)unsignedValue);
+        snprintf(reference, sizeof(reference), uppercase ? ("%" PRIu64 "%" PRId64 "%" PRIX64 "%" PRId32 "%" PRIu32) : ("%" PRIu64 "%" PRId64 "%" PRIx64 "%" PRId32 "%" PRIu32),
+                 unsignedValue, signedValue, unsignedValue, (int32_t)signedValue, (uint32_t)unsignedValue);
+        matches = matches && (strcmp(reference, CSH_string_data(&str)) == 0);
+    }
+    CSH_TEST_CHECK_MF(matches);
+
+    CSH_string_clear(&str, false);
+    CSH_string_append_i64(&str, INT64_MIN);
+    CSH_string_append_u64(&str, UINT64_MAX);
+    CSH_string_append_i32(&str, INT32_MIN);
+    CSH_string_append_u64(&str, 0);
+    CSH_string_append_hex(&str, 0, false);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), "-922337203685477580818446744073709551615-214748364800") == 0);
+    CSH_string_free(&str);
+}
+
+// Numbers are written into the spare capacity without allocating, and a failed grow leaves the string as it was.
+static void CSH_test_number_alloc(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHString str = CSH_STRING_ALLOCATOR_M(&allocator);
+    CSH_string_reserve(&str, 1000);
+
+    size_t allocCount = state.m_allocCount;
+    for (size_t i = 0; i < 20; i++)
+    {
+        CSH_string_append_u64(&str, i * 1000003);
+        CSH_string_append_double(&str, (double)i / 7.0);
+    }
+    CSH_TEST_CHECK_MF(state.m_allocCount == allocCount && str.m_size < 1000);
+
+    CSH_string_assign_cstr(&str, "a string which is stored on the heap");
+    CSH_string_shrink_to_fit(&str);
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(CSH_string_append_u64(&str, 12345) == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(CSH_string_append_i32(&str, -1) == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(CSH_string_append_hex(&str, 255, false) == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(CSH_string_append_double(&str, 0.5) == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), "a string which is stored on the heap") == 0);
+    state.m_failAfter = SIZE_MAX;
+
+    CSH_TEST_CHECK_MF(CSH_string_append_u64(NULL, 1) == CSHSSC_BAD_INPUT_STR && CSH_string_append_double(NULL, 1.0) == CSHSSC_BAD_INPUT_STR);
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_double_round_trip();
+    CSH_test_double_layout();
+    CSH_test_integers();
+    CSH_test_number_alloc();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,243 @@
+#include <errno.h>
+#include <inttypes.h>
+#include <locale.h>
+#include <math.h>
+#include "CSHTest.h"
+#include "CSHStringNumber.h"
+
+static uint64_t CSH_test_seed = 88172645463325252ULL;
+
+static uint64_t CSH_test_random(void)
+{
+    CSH_test_seed ^= CSH_test_seed << 13;
+    CSH_test_seed ^= CSH_test_seed >> 7;
+    CSH_test_seed ^= CSH_test_seed << 17;
+    return CSH_test_seed;
+}
+
+// The double and the characters used agree with strtod, and input strtod can't parse fails.
+static bool CSH_test_check_double(CSHConstCharPtr_t in_str)
+{
+    double value = -1.0;
+    size_t used = SIZE_MAX;
+    int8_t result = CSH_string_view_parse_double(CSH_string_view_buffer(in_str, strlen(in_str)), &value, &used);
+    char* end;
+    double reference = strtod(in_str, &end);
+    if (end == in_str)
+    {
+        return (result == CSHSSC_BAD_INPUT_STR);
+    }
+    bool bothNan = (value != value && reference != reference);
+    return (result == CSHSSC_NONE && used == (size_t)(end - in_str) && (bothNan || memcmp(&value, &reference, sizeof(double)) == 0));
+}
+
+// The integer, the characters used and overflow agree with strtoll and strtoull.
+static bool CSH_test_check_integer(CSHConstCharPtr_t in_str)
+{
+    S_CSHStringView view = CSH_string_view_buffer(in_str, strlen(in_str));
+    int64_t value;
+    size_t used;
+    int8_t result = CSH_string_view_parse_i64(view, &value, &used);
+    char* end;
+    errno = 0;
+    long long reference = strtoll(in_str, &end, 10);
+    bool passed = true;
+    if (in_str[0] == ' ' || end == in_str)
+    {
+        passed = (result == CSHSSC_BAD_INPUT_STR);
+    }
+    else
+    {
+        passed = (used == (size_t)(end - in_str) && value == reference && ((errno != 0) == (result == CSHSSC_BAD_INPUT_ARG)));
+    }
+    if (in_str[0] == '-')
+    {
+        return passed;
+    }
+
+    uint64_t unsignedValue;
+    result = CSH_string_view_parse_u64(view, &unsignedValue, &used);
+    errno = 0;
+    unsigned long long unsignedReference = strtoull(in_str, &end, 10);
+    if (in_str[0] == ' ' || end == in_str)
+    {
+        return passed && (result == CSHSSC_BAD_INPUT_STR);
+    }
+    return passed && used == (size_t)(end - in_str) && unsignedValue == unsignedReference && ((errno != 0) == (result == CSHSSC_BAD_INPUT_ARG));
+}
+
+// Hard cases (halfway points, subnormals, overflow, long mantissas), malformed input and the integer limits.
+static void CSH_test_parse_edges(void)
+{
+    CSHConstCharPtr_t doubles[] =
+    {
+        "0", "-0", "1", "1.5", "1e", "1e+", "1.e5", ".5", "-.5e-3", ".", "-", "+", "e5", "", "inf", "-Infinity", "INFx", "nan", "NaN(123)", "infinit",
+        "4.9e-324", "2.4703282292062327e-324", "2.4703282292062328e-324", "1.7976931348623157e308", "1.7976931348623159e308", "1e400", "1e-400",
+        "9007199254740993", "9007199254740992.5", "0.000000000000000000000000000000000000000001", "123456789012345678901234567890",
+        "2.2250738585072011e-308", "2.2250738585072014e-308", "7.2057594037927933e16", "100000000000000000000000",
+        "0.1000000000000000055511151231257827021181583404541015625", "0.1000000000000000055511151231257827021181583404541015624",
+        "0.1000000000000000055511151231257827021181583404541015626", "1e99999999999", "0e99999999999", "00000000000000000000000000000001.5",
+        "1.00000000000000011102230246251565404236316680908203125", "1.00000000000000011102230246251565404236316680908203124",
+        "1.00000000000000011102230246251565404236316680908203126", "3.4e38x", "12345678.12345678"
+    };
+    for (size_t i = 0; i < (sizeof(doubles) / sizeof(doubles[0])); i++)
+    {
+        CSH_TEST_CHECK_MF(CSH_test_check_double(doubles[i]));
+    }
+
+    CSHConstCharPtr_t integers[] =
+    {
+        "0", "-0", "+5", "18446744073709551615", "18446744073709551616", "99999999999999999999", "000000000000000000000000123",
+        "9223372036854775807", "9223372036854775808", "-9223372036854775808", "-9223372036854775809", "12345678901234567", "x", "-", " 1", "123abc", ""
+    };
+    for (size_t i = 0; i < (sizeof(integers) / sizeof(integers[0])); i++)
+    {
+        CSH_TEST_CHECK_MF(CSH_test_check_integer(integers[i]));
+    }
+
+    int64_t value = 0;
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_i64(CSH_STRING_VIEW_DEFAULT_M, &value, NULL) == CSHSSC_BAD_INPUT_STR);
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_i64(CSH_string_view_buffer("-9223372036854775809", 20), &value, NULL) == CSHSSC_BAD_INPUT_ARG && value == INT64_MIN);
+}
+
+// Random doubles in various precisions, random digit strings and random integers agree with strtod and strtoll.
+static void CSH_test_parse_random(void)
+{
+    char buffer[512];
+    size_t failures = 0;
+    for (size_t i = 0; i < 200000; i++)
+    {
+        uint64_t bits = CSH_test_random();
+        double value;
+        memcpy(&value, &bits, sizeof(double));
+        if (value == value)
+        {
+            snprintf(buffer, sizeof(buffer), "%.*e", (int)(1 + (CSH_test_random() % 20)), value);
+            failures += CSH_test_check_double(buffer) ? 0 : 1;
+        }
+        snprintf(buffer, sizeof(buffer), "%.17g", (double)(CSH_test_random() % 1000000) / (double)(1 + (CSH_test_random() % 1000)));
+        failures += CSH_test_check_double(buffer) ? 0 : 1;
+
+        size_t digitCount = 1 + (CSH_test_random() % 40);
+        size_t pos = 0;
+        if ((CSH_test_random() & 1) != 0)
+        {
+            buffer[pos++] = '-';
+        }
+        for (size_t k = 0; k < digitCount; k++)
+        {
+            buffer[pos++] = (char)('0' + (CSH_test_random() % 10));
+            if (k == (CSH_test_random() % digitCount))
+            {
+                buffer[pos++] = '.';
+            }
+        }
+        if ((CSH_test_random() & 1) != 0)
+        {
+            pos += (size_t)sprintf(buffer + pos, "e%d", (int)(CSH_test_random() % 700) - 350);
+        }
+        buffer[pos] = '\0';
+        failures += CSH_test_check_double(buffer) ? 0 : 1;
+
+        snprintf(buffer, sizeof(buffer), "%" PRId64, (int64_t)CSH_test_random() >> (CSH_test_random() % 64));
+        failures += CSH_test_check_integer(buffer) ? 0 : 1;
+        digitCount = 1 + (CSH_test_random() % 22);
+        for (size_t k = 0; k < digitCount; k++)
+        {
+            buffer[k] = (char)('0' + (CSH_test_random() % 10));
+        }
+        buffer[digitCount] = '\0';
+        failures += CSH_test_check_integer(buffer) ? 0 : 1;
+    }
+    CSH_TEST_CHECK_MF(failures == 0);
+}
+
+// Parsing never reads past the view, so a string's range is parsed in place.
+static void CSH_test_parse_bounded(void)
+{
+    int64_t value;
+    size_t used;
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_i64(CSH_string_view_buffer("12345678901234567890", 9), &value, &used) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(value == 123456789 && used == 9);
+    double doubleValue;
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_double(CSH_string_view_buffer("1.25e10", 5), &doubleValue, &used) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(doubleValue == 1.25 && used == 4);
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_double(CSH_string_view_buffer("infinity", 3), &doubleValue, &used) == CSHSSC_NONE && used == 3);
+
+    // Exactly the view's characters, in a heap buffer so reading past it is caught by the address sanitizer.
+    char* digits = (char*)malloc(8);
+    memcpy(digits, "98765432", 8);
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_i64(CSH_string_view_buffer(digits, 8), &value, &used) == CSHSSC_NONE && value == 98765432);
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_double(CSH_string_view_buffer(digits, 8), &doubleValue, &used) == CSHSSC_NONE && doubleValue == 98765432.0);
+    free(digits);
+
+    S_CSHString str = CSH_string_create_cstr("x=42;", 64);
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_i64(CSH_string_substr_view(&str, 2, 2), &value, &used) == CSHSSC_NONE && value == 42);
+    CSH_string_free(&str);
+}
+
+// Whole delimited columns, stopping at the first field which isn't exactly one number.
+static void CSH_test_parse_lists(void)
+{
+    int64_t values[8];
+    size_t pos;
+    CSHConstCharPtr_t column = "1,-2,30,400";
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_i64_list(CSH_string_view_cstr(column, 100), ',', values, 8, &pos) == 4);
+    CSH_TEST_CHECK_MF(pos == strlen(column) && values[1] == -2 && values[3] == 400);
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_i64_list(CSH_string_view_cstr("1,2,x,4", 100), ',', values, 8, &pos) == 2 && pos == 4);
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_i64_list(CSH_string_view_cstr("1,2,3", 100), ',', values, 2, &pos) == 2 && pos == 4);
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_i64_list(CSH_string_view_cstr("1,2,", 100), ',', values, 8, &pos) == 2 && pos == 4);
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_i64_list(CSH_string_view_cstr("1,99999999999999999999", 100), ',', values, 8, &pos) == 1 && pos == 2);
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_i64_list(CSH_string_view_buffer("", 0), ',', values, 8, &pos) == 0 && pos == 0);
+
+    double doubleValues[4];
+    column = "1.5|2e3|-inf";
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_double_list(CSH_string_view_cstr(column, 100), '|', doubleValues, 4, &pos) == 3);
+    CSH_TEST_CHECK_MF(pos == strlen(column) && doubleValues[1] == 2000.0 && doubleValues[2] < 0 && isinf(doubleValues[2]));
+}
+
+// A locale with a decimal comma doesn't change what's parsed, including the rare values which fall back to strtod.
+static void CSH_test_parse_locale(void)
+{
+    // Just above the halfway point between 0 and the smallest subnormal, and exactly halfway between 1 and the next double.
+    CSHConstCharPtr_t hardValues[] =
+    {
+        "2.4703282292062327208828439643411068618252990130716238221279284125033775364e-324",
+        "1.00000000000000011102230246251565404236316680908203125"
+    };
+    double expected[2];
+    for (size_t i = 0; i < 2; i++)
+    {
+        expected[i] = strtod(hardValues[i], NULL);
+    }
+    CSH_TEST_CHECK_MF(expected[0] == 4.9406564584124654e-324 && expected[1] == 1.0);
+
+    CSHConstCharPtr_t locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8"};
+    bool localeSet = false;
+    for (size_t i = 0; i < (sizeof(locales) / sizeof(locales[0])) && !localeSet; i++)
+    {
+        localeSet = (setlocale(LC_NUMERIC, locales[i]) != NULL);
+    }
+
+    double value = 0.0;
+    size_t used = 0;
+    for (size_t i = 0; i < 2; i++)
+    {
+        CSH_TEST_CHECK_MF(CSH_string_view_parse_double(CSH_string_view_cstr(hardValues[i], 200), &value, &used) == CSHSSC_NONE);
+        CSH_TEST_CHECK_MF(value == expected[i] && used == strlen(hardValues[i]));
+    }
+    CSH_TEST_CHECK_MF(CSH_string_view_parse_double(CSH_string_view_cstr("1,5", 10), &value, &used) == CSHSSC_NONE && value == 1.0 && used == 1);
+
+    setlocale(LC_NUMERIC, "C");
+}
+
+int main(void)
+{
+    CSH_test_parse_edges();
+    CSH_test_parse_random();
+    CSH_test_parse_bounded();
+    CSH_test_parse_lists();
+    CSH_test_parse_locale();
+
+    return CSH_test_result(__FILE__);
+}
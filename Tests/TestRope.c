@@ -0,0 +1,252 @@
+#include "CSHTest.h"
+#include "CSHRope.h"
+
+static uint32_t CSH_test_seed = 1;
+
+static uint32_t CSH_test_random(void)
+{
+    CSH_test_seed ^= CSH_test_seed << 13;
+    CSH_test_seed ^= CSH_test_seed >> 17;
+    CSH_test_seed ^= CSH_test_seed << 5;
+    return CSH_test_seed;
+}
+
+// Random inserts, erases and replaces agree with a plain buffer, including inserting a view of one of the rope's own pieces.
+static void CSH_test_rope_edits(void)
+{
+    static char model[20000];
+    size_t modelSize = 5;
+    memcpy(model, "hello", 5);
+
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHRope rope;
+    CSH_TEST_CHECK_MF(CSH_rope_init(&rope, CSH_string_view_buffer("hello", 5), &allocator) == CSHSSC_NONE);
+
+    for (size_t round = 0; round < 50000; round++)
+    {
+        char text[8];
+        size_t textSize = CSH_test_random() % 8;
+        for (size_t i = 0; i < textSize; i++)
+        {
+            text[i] = (char)('a' + (CSH_test_random() % 3));
+        }
+
+        uint32_t op = CSH_test_random() % 7;
+        if (op < 3 && (modelSize + textSize) < sizeof(model))
+        {
+            size_t pos = CSH_test_random() % (modelSize + 1);
+            CSH_TEST_CHECK_MF(CSH_rope_insert(&rope, pos, CSH_string_view_buffer(text, textSize)) == CSHSSC_NONE);
+            memmove(model + pos + textSize, model + pos, modelSize - pos);
+            memcpy(model + pos, text, textSize);
+            modelSize += textSize;
+        }
+        else if (op < 5 && modelSize != 0)
+        {
+            size_t pos = CSH_test_random() % modelSize;
+            size_t len = CSH_test_random() % 10;
+            CSH_TEST_CHECK_MF(CSH_rope_erase(&rope, pos, len) == CSHSSC_NONE);
+            len = (len > (modelSize - pos)) ? (modelSize - pos) : len;
+            memmove(model + pos, model + pos + len, modelSize - pos - len);
+            modelSize -= len;
+        }
+        else if (op == 5 && (modelSize + textSize) < sizeof(model))
+        {
+            size_t pos = CSH_test_random() % (modelSize + 1);
+            size_t len = CSH_test_random() % 6;
+            CSH_TEST_CHECK_MF(CSH_rope_replace(&rope, pos, len, CSH_string_view_buffer(text, textSize)) == CSHSSC_NONE);
+            len = (len > (modelSize - pos)) ? (modelSize - pos) : len;
+            memmove(model + pos + textSize, model + pos + len, modelSize - pos - len);
+            memcpy(model + pos, text, textSize);
+            modelSize = modelSize - len + textSize;
+        }
+        else if (op == 6 && modelSize != 0)
+        {
+            // Replace a range with a piece of the rope itself, which the replace's own erase may remove.
+            size_t piecePos = CSH_test_random() % modelSize;
+            S_CSHStringView piece = CSH_rope_next_piece(&rope, &piecePos);
+            if ((modelSize + piece.m_size) >= sizeof(model))
+            {
+                continue;
+            }
+            char* copy = malloc(piece.m_size + 1);
+            memcpy(copy, piece.m_strPtr, piece.m_size);
+            size_t pos = CSH_test_random() % (modelSize + 1);
+            size_t len = CSH_test_random() % 4;
+            CSH_TEST_CHECK_MF(CSH_rope_replace(&rope, pos, len, piece) == CSHSSC_NONE);
+            len = (len > (modelSize - pos)) ? (modelSize - pos) : len;
+            memmove(model + pos + piece.m_size, model + pos + len, modelSize - pos - len);
+            memcpy(model + pos, copy, piece.m_size);
+            modelSize = modelSize - len + piece.m_size;
+            free(copy);
+        }
+
+        CSH_TEST_CHECK_MF(CSH_rope_size(&rope) == modelSize);
+        if (modelSize != 0)
+        {
+            size_t pos = CSH_test_random() % modelSize;
+            CSH_TEST_CHECK_MF(CSH_rope_char_at(&rope, pos) == model[pos]);
+        }
+        if ((round % 97) == 0)
+        {
+            S_CSHStringView flat = CSH_rope_flatten(&rope);
+            CSH_TEST_CHECK_MF(flat.m_size == modelSize && memcmp(flat.m_strPtr, model, modelSize) == 0 && flat.m_strPtr[modelSize] == '\0');
+            CSH_TEST_CHECK_MF(CSH_rope_compare(&rope, CSH_string_view_buffer(model, modelSize)) == CSHSSC_NONE);
+            CSH_TEST_CHECK_MF(CSH_rope_cmp(&rope, CSH_string_view_buffer(model, modelSize)) == 0);
+        }
+        if ((round % 1000) == 0)
+        {
+            CSH_TEST_CHECK_MF(CSH_rope_compact(&rope) == CSHSSC_NONE && rope.m_bufferSize == modelSize);
+        }
+    }
+
+    S_CSHString str = CSH_rope_to_string(&rope);
+    CSH_TEST_CHECK_MF(str.m_size == modelSize && memcmp(CSH_string_data(&str), model, modelSize) == 0);
+    CSH_string_free(&str);
+    CSH_rope_free(&rope);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+// Searching piece by piece finds the same matches as searching the flattened text, including matches which cross pieces.
+static void CSH_test_rope_find(void)
+{
+    srand(7);
+    for (size_t round = 0; round < 300; round++)
+    {
+        S_CSHRope rope;
+        CSH_rope_init(&rope, CSH_STRING_VIEW_DEFAULT_M, NULL);
+        size_t edits = (size_t)(rand() % 40);
+        for (size_t edit = 0; edit < edits; edit++)
+        {
+            char text[64];
+            size_t textSize = (size_t)(1 + (rand() % 60));
+            for (size_t i = 0; i < textSize; i++)
+            {
+                text[i] = "ab"[rand() % 2];
+            }
+            size_t size = CSH_rope_size(&rope);
+            int op = rand() % 4;
+            if (op < 2 || size == 0)
+            {
+                CSH_rope_insert(&rope, (size != 0) ? (size_t)(rand() % (size + 1)) : 0, CSH_string_view_buffer(text, textSize));
+            }
+            else if (op == 2)
+            {
+                CSH_rope_erase(&rope, (size_t)(rand() % size), (size_t)(rand() % 3));
+            }
+            else
+            {
+                CSH_rope_replace(&rope, (size_t)(rand() % (size + 1)), (size_t)(rand() % 3), CSH_string_view_buffer(text, textSize));
+            }
+        }
+
+        S_CSHStringView flat = CSH_rope_flatten(&rope);
+        char* copy = malloc(flat.m_size + 1);
+        memcpy(copy, flat.m_strPtr, flat.m_size);
+        S_CSHStringView copyView = CSH_string_view_buffer(copy, flat.m_size);
+        for (size_t query = 0; query < 30; query++)
+        {
+            char needle[64];
+            size_t needleSize = (size_t)(rand() % 40);
+            if (copyView.m_size > needleSize && (rand() % 2) == 0)
+            {
+                memcpy(needle, copy + (rand() % (copyView.m_size - needleSize)), needleSize);
+            }
+            else
+            {
+                for (size_t i = 0; i < needleSize; i++)
+                {
+                    needle[i] = "ab"[rand() % 2];
+                }
+            }
+            S_CSHStringView needleView = CSH_string_view_buffer(needle, needleSize);
+            size_t pos = (size_t)(rand() % (copyView.m_size + 2));
+            CSH_TEST_CHECK_MF(CSH_rope_find(&rope, pos, needleView) == CSH_string_view_find(copyView, pos, needleView));
+            CSH_TEST_CHECK_MF(CSH_rope_rfind(&rope, pos, needleView) == CSH_string_view_rfind(copyView, pos, needleView));
+        }
+        free(copy);
+        CSH_rope_free(&rope);
+    }
+}
+
+// Empty ropes and views, positions past the end, and cstrs longer than m_maxCstrSize.
+static void CSH_test_rope_edges(void)
+{
+    S_CSHRope rope;
+    CSH_TEST_CHECK_MF(CSH_rope_init(&rope, CSH_STRING_VIEW_DEFAULT_M, NULL) == CSHSSC_NONE);
+    S_CSHStringView flat = CSH_rope_flatten(&rope);
+    CSH_TEST_CHECK_MF(flat.m_strPtr != NULL && flat.m_size == 0 && flat.m_strPtr[0] == '\0');
+    size_t pos = 0;
+    CSH_TEST_CHECK_MF(CSH_rope_next_piece(&rope, &pos).m_strPtr == NULL);
+    CSH_TEST_CHECK_MF(CSH_rope_char_at(&rope, 0) == '\0');
+    CSH_TEST_CHECK_MF(CSH_rope_find(&rope, 0, CSH_string_view_buffer("", 0)) == CSH_STRING_NPOS);
+
+    CSH_TEST_CHECK_MF(CSH_rope_replace_cstr(&rope, 0, 5, "abc") == CSHSSC_NONE);
+    CSH_rope_flatten(&rope);
+    CSH_TEST_CHECK_MF(CSH_rope_replace_cstr(&rope, 3, 0, "de") == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_rope_replace_cstr(&rope, 6, 0, "x") == CSHSSC_BAD_INPUT_ARG);
+    CSH_TEST_CHECK_MF(CSH_rope_insert(&rope, 2, CSH_string_view_buffer("", 0)) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_rope_insert(&rope, 2, CSH_STRING_VIEW_DEFAULT_M) == CSHSSC_BAD_INPUT_STR);
+    flat = CSH_rope_flatten(&rope);
+    CSH_TEST_CHECK_MF(flat.m_size == 5 && memcmp(flat.m_strPtr, "abcde", 6) == 0);
+
+    rope.m_maxCstrSize = 3;
+    CSH_TEST_CHECK_MF(CSH_rope_insert_cstr(&rope, 0, "xyz") == CSHSSC_CSTR_DOESNT_FIT);
+    CSH_TEST_CHECK_MF(CSH_rope_insert_cstr(&rope, 0, "xy") == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_rope_compare(&rope, CSH_string_view_cstr("xyabcde", 10)) == CSHSSC_NONE);
+
+    CSH_TEST_CHECK_MF(CSH_rope_erase(&rope, 0, 100) == CSHSSC_NONE && CSH_rope_size(&rope) == 0);
+    flat = CSH_rope_flatten(&rope);
+    CSH_TEST_CHECK_MF(flat.m_strPtr != NULL && flat.m_size == 0 && flat.m_strPtr[0] == '\0');
+    CSH_rope_free(&rope);
+}
+
+// A replace which fails to allocate at any point leaves the text as it was.
+static void CSH_test_rope_alloc_failure(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHRope rope;
+    CSH_rope_init(&rope, CSH_string_view_cstr("the quick brown fox", 100), &allocator);
+
+    char expected[4096];
+    size_t expectedSize = 19;
+    memcpy(expected, "the quick brown fox", 19);
+    static const char replacement[] = "a much longer replacement which has to grow the buffer";
+    size_t failures = 0;
+    for (size_t round = 0; round < 60; round++)
+    {
+        size_t pos = (round * 7) % (expectedSize + 1);
+        size_t len = round % 5;
+        state.m_failAfter = ((round % 3) == 0) ? SIZE_MAX : 0;
+        int8_t status = CSH_rope_replace_cstr(&rope, pos, len, replacement);
+        if (status == CSHSSC_NONE)
+        {
+            len = (len > (expectedSize - pos)) ? (expectedSize - pos) : len;
+            memmove(expected + pos + (sizeof(replacement) - 1), expected + pos + len, expectedSize - pos - len);
+            memcpy(expected + pos, replacement, sizeof(replacement) - 1);
+            expectedSize = expectedSize - len + (sizeof(replacement) - 1);
+        }
+        else
+        {
+            CSH_TEST_CHECK_MF(status == CSHSSC_ALLOC_FAILED);
+            failures += 1;
+        }
+        state.m_failAfter = SIZE_MAX;
+        CSH_TEST_CHECK_MF(CSH_rope_compare(&rope, CSH_string_view_buffer(expected, expectedSize)) == CSHSSC_NONE);
+    }
+    CSH_TEST_CHECK_MF(failures != 0);
+
+    CSH_rope_free(&rope);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_rope_edits();
+    CSH_test_rope_find();
+    CSH_test_rope_edges();
+    CSH_test_rope_alloc_failure();
+
+    return CSH_test_result(__FILE__);
+}
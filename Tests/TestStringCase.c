@@ -0,0 +1,117 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+#include "CSHStringKernels.h"
+
+static int CSH_test_fold(int in_char)
+{
+    return (in_char >= 'A' && in_char <= 'Z') ? (in_char + 32) : in_char;
+}
+
+static size_t CSH_test_naive_find_icase(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize)
+{
+    if (in_needleSize > in_haystackSize)
+    {
+        return CSH_STRING_NPOS;
+    }
+    for (size_t i = 0; (i + in_needleSize) <= in_haystackSize; i++)
+    {
+        size_t j = 0;
+        while (j < in_needleSize && CSH_test_fold((unsigned char)in_haystack[i + j]) == CSH_test_fold((unsigned char)in_needle[j]))
+        {
+            j++;
+        }
+        if (j == in_needleSize)
+        {
+            return i;
+        }
+    }
+    return CSH_STRING_NPOS;
+}
+
+// Only ASCII letters are folded, the bytes either side of each letter range and non ASCII bytes are left alone.
+static void CSH_test_kernel_case(void)
+{
+    static const char alphabet[] = "aAbB@[`{zZ\x80\xc1 ";
+    srand(5);
+    for (size_t round = 0; round < 50000; round++)
+    {
+        size_t haystackSize = (size_t)(rand() % 150);
+        size_t needleSize = (size_t)(rand() % 5);
+        char haystack[160];
+        char needle[8];
+        char lower[160];
+        char upper[160];
+        for (size_t i = 0; i < haystackSize; i++)
+        {
+            haystack[i] = alphabet[rand() % 14];
+        }
+        for (size_t i = 0; i < needleSize; i++)
+        {
+            needle[i] = alphabet[rand() % 14];
+        }
+        CSH_TEST_CHECK_MF(CSH_kernel_find_icase(haystack, haystackSize, needle, needleSize) == CSH_test_naive_find_icase(haystack, haystackSize, needle, needleSize));
+
+        memcpy(lower, haystack, haystackSize);
+        memcpy(upper, haystack, haystackSize);
+        CSH_kernel_to_lower(lower, haystackSize);
+        CSH_kernel_to_upper(upper, haystackSize);
+        for (size_t i = 0; i < haystackSize; i++)
+        {
+            int original = (unsigned char)haystack[i];
+            CSH_TEST_CHECK_MF((unsigned char)lower[i] == CSH_test_fold(original));
+            CSH_TEST_CHECK_MF((unsigned char)upper[i] == ((original >= 'a' && original <= 'z') ? (original - 32) : original));
+        }
+
+        CSH_TEST_CHECK_MF(CSH_kernel_equal_icase(lower, upper, haystackSize) && CSH_kernel_equal_icase(haystack, upper, haystackSize));
+        CSH_TEST_CHECK_MF(CSH_kernel_hash_icase(haystack, haystackSize, 0) == CSH_kernel_hash_icase(upper, haystackSize, 0));
+        CSH_TEST_CHECK_MF(CSH_kernel_hash_icase(haystack, haystackSize, 0) == CSH_kernel_hash(lower, haystackSize, 0));
+    }
+
+    // '@' and '`' differ by the case bit, but aren't letters.
+    CSH_TEST_CHECK_MF(!CSH_kernel_equal_icase("@", "`", 1) && !CSH_kernel_equal_icase("[", "{", 1));
+}
+
+// The string functions compare, find and hash ignoring case, and lowering or raising invalidates the cached hash.
+static void CSH_test_string_case(void)
+{
+    S_CSHString str = CSH_string_create_cstr("Content-Type: text/HTML", 100);
+    CSH_TEST_CHECK_MF(CSH_string_compare_icase_cstr(&str, "content-type: TEXT/html") == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_string_compare_icase_cstr(&str, "content-type: TEXT/htm") == CSHSSC_BAD_INPUT_ARG);
+    CSH_TEST_CHECK_MF(CSH_string_find_icase_cstr(&str, 0, "html") == 19);
+    CSH_TEST_CHECK_MF(CSH_string_find_icase_cstr(&str, 0, "TYPE") == 8);
+    CSH_TEST_CHECK_MF(CSH_string_find_icase_cstr(&str, 20, "html") == CSH_STRING_NPOS);
+
+    // A cstr that reaches m_maxCstrSize doesn't fit.
+    CSH_string_set_max_cstr_size(&str, 4);
+    CSH_TEST_CHECK_MF(CSH_string_compare_icase_cstr(&str, "content-type: TEXT/html") == CSHSSC_CSTR_DOESNT_FIT);
+    CSH_TEST_CHECK_MF(CSH_string_find_icase_cstr(&str, 0, "text/") == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_find_icase_cstr(&str, 0, "TEXT") == 14);
+
+    uint64_t hash = CSH_string_hash_cached(&str);
+    CSH_TEST_CHECK_MF(CSH_string_to_upper(&str) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), "CONTENT-TYPE: TEXT/HTML") == 0 && CSH_string_hash(&str) != hash);
+    CSH_TEST_CHECK_MF(CSH_string_to_lower(&str) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), "content-type: text/html") == 0);
+
+    S_CSHString other = CSH_string_create_cstr("CONTENT-type: Text/Html", 100);
+    CSH_TEST_CHECK_MF(CSH_string_compare_icase(&str, &other) == CSHSSC_NONE && CSH_string_hash_icase(&str) == CSH_string_hash_icase(&other));
+    CSH_TEST_CHECK_MF(CSH_string_find_icase(&other, 0, &str) == 0);
+    CSH_string_free(&other);
+    CSH_string_free(&str);
+
+    // Empty strings are equal ignoring case, whether or not they've allocated.
+    S_CSHString empty = CSH_STRING_DEFAULT_M;
+    S_CSHString created = CSH_string_create_cstr("", 10);
+    CSH_TEST_CHECK_MF(CSH_string_compare_icase(&empty, &created) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_string_hash_icase(&empty) == CSH_string_hash_icase(&created));
+    CSH_TEST_CHECK_MF(CSH_string_to_lower(&empty) == CSHSSC_NONE && CSH_string_to_lower(NULL) == CSHSSC_BAD_INPUT_STR);
+    CSH_string_free(&created);
+}
+
+int main(void)
+{
+    CSH_test_kernel_case();
+    CSH_test_string_case();
+
+    return CSH_test_result(__FILE__);
+}
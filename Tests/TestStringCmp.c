@@ -0,0 +1,91 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+#include "CSHStringKernels.h"
+
+static int CSH_test_sign(int in_value)
+{
+    return (in_value > 0) - (in_value < 0);
+}
+
+// The kernel orders like memcmp, with characters compared as unsigned.
+static void CSH_test_kernel_compare(void)
+{
+    srand(6);
+    for (size_t round = 0; round < 100000; round++)
+    {
+        size_t size = (size_t)(rand() % 100);
+        char one[100];
+        char two[100];
+        for (size_t i = 0; i < size; i++)
+        {
+            one[i] = two[i] = (char)(rand() % 256);
+        }
+        if (size != 0 && (rand() % 2) == 0)
+        {
+            two[rand() % size] = (char)(rand() % 256);
+        }
+        CSH_TEST_CHECK_MF(CSH_test_sign(CSH_kernel_compare(one, two, size)) == CSH_test_sign(memcmp(one, two, size)));
+    }
+}
+
+// Prefixes order first, characters compare as unsigned, and invalid strings order before valid ones.
+static void CSH_test_string_cmp(void)
+{
+    S_CSHString apple = CSH_string_create_cstr("apple", 100);
+    S_CSHString applesauce = CSH_string_create_cstr("applesauce", 100);
+    S_CSHString high = CSH_string_create_cstr("b\xff", 100);
+    S_CSHString error = CSH_STRING_ERROR_M(CSHSSC_ALLOC_FAILED);
+
+    CSH_TEST_CHECK_MF(CSH_string_cmp(&apple, &applesauce) < 0 && CSH_string_cmp(&applesauce, &apple) > 0);
+    CSH_TEST_CHECK_MF(CSH_string_cmp(&apple, &apple) == 0);
+    CSH_TEST_CHECK_MF(CSH_string_cmp_cstr(&high, "b\x01") > 0);
+    CSH_TEST_CHECK_MF(CSH_string_cmp(NULL, &apple) < 0 && CSH_string_cmp(&error, &apple) < 0 && CSH_string_cmp(&apple, NULL) > 0);
+
+    CSH_TEST_CHECK_MF(CSH_string_compare(&apple, &applesauce) == CSHSSC_BAD_INPUT_ARG);
+    CSH_TEST_CHECK_MF(CSH_string_compare_cstr(&apple, "apple") == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_string_compare_cstr(&apple, "apply") == CSHSSC_BAD_INPUT_ARG);
+    CSH_TEST_CHECK_MF(CSH_cstr_compare("ab", 5, "ac") == CSHSSC_BAD_INPUT_ARG);
+
+    // CSH_cstr_cmp only compares the first in_maxSize characters of each.
+    CSH_TEST_CHECK_MF(CSH_cstr_cmp("abcX", 3, "abcY") == 0);
+    CSH_TEST_CHECK_MF(CSH_cstr_cmp("abcX", 4, "abcY") < 0);
+
+    CSH_string_free(&apple);
+    CSH_string_free(&applesauce);
+    CSH_string_free(&high);
+}
+
+// A cstr longer than m_maxCstrSize orders after the string unless the characters which fit already differ, and is never equal to it.
+static void CSH_test_cmp_overlong_cstr(void)
+{
+    char* big = malloc(3001);
+    memset(big, 'a', 3000);
+    big[3000] = '\0';
+
+    S_CSHString str = CSH_string_create_cstr("", 10);
+    CSH_string_set_max_cstr_size(&str, 2048);
+    CSH_string_resize(&str, 2048, 'a');
+
+    CSH_TEST_CHECK_MF(CSH_string_cmp_cstr(&str, big) < 0);
+    CSH_TEST_CHECK_MF(CSH_string_compare_cstr(&str, big) == CSHSSC_CSTR_DOESNT_FIT);
+    big[10] = 'b';
+    CSH_TEST_CHECK_MF(CSH_string_cmp_cstr(&str, big) < 0);
+    big[10] = '0';
+    CSH_TEST_CHECK_MF(CSH_string_cmp_cstr(&str, big) > 0);
+
+    big[10] = 'a';
+    big[2048] = '\0';
+    CSH_TEST_CHECK_MF(CSH_string_cmp_cstr(&str, big) == 0 && CSH_string_compare_cstr(&str, big) == CSHSSC_NONE);
+
+    CSH_string_free(&str);
+    free(big);
+}
+
+int main(void)
+{
+    CSH_test_kernel_compare();
+    CSH_test_string_cmp();
+    CSH_test_cmp_overlong_cstr();
+
+    return CSH_test_result(__FILE__);
+}
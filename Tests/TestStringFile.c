@@ -0,0 +1,146 @@
+#include "CSHTest.h"
+#include "CSHStringFile.h"
+#include "CSHStringNumber.h"
+
+static const char CSH_test_path[] = "TestStringFile.tmp";
+
+static uint64_t CSH_test_seed = 99;
+
+static uint64_t CSH_test_random(void)
+{
+    CSH_test_seed ^= CSH_test_seed << 13;
+    CSH_test_seed ^= CSH_test_seed >> 7;
+    CSH_test_seed ^= CSH_test_seed << 17;
+    return CSH_test_seed;
+}
+
+// The lines of in_data agree with splitting on '\n' with memchr and dropping a "\r" before it, and point into in_data.
+static bool CSH_test_check_lines(CSHConstCharPtr_t in_data, size_t in_size)
+{
+    S_CSHLineIterator lines;
+    if (CSH_lines_init(&lines, CSH_string_view_buffer(in_data, in_size)) != CSHSSC_NONE)
+    {
+        return false;
+    }
+
+    S_CSHStringView line;
+    size_t pos = 0;
+    while (pos < in_size)
+    {
+        const char* newline = (const char*)memchr(in_data + pos, '\n', in_size - pos);
+        size_t end = (newline != NULL) ? (size_t)(newline - in_data) : in_size;
+        size_t size = ((end > pos) && in_data[end - 1] == '\r') ? (end - pos - 1) : (end - pos);
+        if (!CSH_lines_next(&lines, &line) || line.m_strPtr != (in_data + pos) || line.m_size != size)
+        {
+            return false;
+        }
+        pos = end + 1;
+    }
+    return !CSH_lines_next(&lines, &line) && !CSH_lines_next(&lines, &line);
+}
+
+// Files around the page and block sizes map with every flag, read the same as what was written, are null terminated,
+// refuse every change, and are unmapped by CSH_string_free or CSH_string_clear.
+static void CSH_test_map_file(void)
+{
+    static char buffer[20000];
+    size_t sizes[] = {0, 1, 63, 64, 65, 127, 128, 4095, 4096, 4097, 8192, 12345, 16384};
+    for (size_t k = 0; k < (sizeof(sizes) / sizeof(sizes[0])); k++)
+    {
+        size_t size = sizes[k];
+        for (size_t i = 0; i < size; i++)
+        {
+            uint64_t value = CSH_test_random() % 40;
+            buffer[i] = (value == 0) ? '\n' : ((value == 1) ? '\r' : ((value == 2) ? '\0' : (char)('a' + (value % 26))));
+        }
+        FILE* file = fopen(CSH_test_path, "wb");
+        CSH_TEST_CHECK_MF(file != NULL && fwrite(buffer, 1, size, file) == size);
+        fclose(file);
+
+        for (uint32_t flags = 0; flags < 8; flags++)
+        {
+            S_CSHString mapped = CSH_string_map_file(CSH_test_path, flags);
+            CSH_TEST_CHECK_MF(mapped.m_status == ((size != 0) ? CSHSSC_USE_MMAP : CSHSSC_NONE) && mapped.m_size == size);
+            if (size != 0)
+            {
+                CSH_TEST_CHECK_MF(memcmp(CSH_string_data(&mapped), buffer, size) == 0 && CSH_string_data(&mapped)[size] == '\0');
+                CSH_TEST_CHECK_MF(CSH_string_add_char(&mapped, 'x') == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(CSH_string_erase(&mapped, 0, 1) == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(CSH_string_insert_cstr(&mapped, 0, "x") == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(CSH_string_to_upper(&mapped) == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(CSH_string_resize(&mapped, 1, 'a') == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(CSH_string_reserve(&mapped, size * 4) == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(CSH_string_reserve_front(&mapped, 4) == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(CSH_string_shrink_to_fit(&mapped) == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(CSH_string_pop_char(&mapped) == '\0' && CSH_string_extend(&mapped, 3) == NULL);
+                CSH_TEST_CHECK_MF(CSH_string_append_u64(&mapped, 5) == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(CSH_string_append_format(&mapped, "%d", 5) == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(CSH_string_concat_right_cstr(&mapped, "x") == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(CSH_string_assign_cstr(&mapped, "x") == CSHSSC_READ_ONLY);
+                CSH_TEST_CHECK_MF(mapped.m_size == size && memcmp(CSH_string_data(&mapped), buffer, size) == 0);
+
+                // A copy is an ordinary writable heap string, null characters included.
+                S_CSHString copy = CSH_string_create(&mapped);
+                CSH_TEST_CHECK_MF(copy.m_status != CSHSSC_USE_MMAP && copy.m_size == size && memcmp(CSH_string_data(&copy), buffer, size) == 0);
+                CSH_TEST_CHECK_MF(CSH_string_add_char(&copy, 'x') == CSHSSC_NONE);
+                CSH_string_free(&copy);
+                CSH_TEST_CHECK_MF(CSH_string_hash_cached(&mapped) == CSH_string_hash(&mapped));
+            }
+            CSH_TEST_CHECK_MF(CSH_test_check_lines((size != 0) ? CSH_string_data(&mapped) : "", mapped.m_size));
+
+            if ((flags & 1) != 0)
+            {
+                CSH_string_clear(&mapped, false);
+            }
+            else
+            {
+                CSH_string_free(&mapped);
+            }
+            CSH_TEST_CHECK_MF(mapped.m_status == CSHSSC_NONE && mapped.m_size == 0 && mapped.m_strPtr == NULL);
+            CSH_TEST_CHECK_MF(CSH_string_add_char(&mapped, 'y') == CSHSSC_NONE);
+            CSH_string_free(&mapped);
+        }
+    }
+
+    S_CSHString mapped = CSH_string_map_file(CSH_test_path, CSHFMF_SEQUENTIAL);
+    CSH_TEST_CHECK_MF(CSH_string_unmap_file(&mapped) == CSHSSC_NONE && mapped.m_size == 0);
+    CSH_TEST_CHECK_MF(CSH_string_unmap_file(&mapped) == CSHSSC_BAD_INPUT_ARG);
+    remove(CSH_test_path);
+
+    CSH_TEST_CHECK_MF(CSH_string_map_file(CSH_test_path, 0).m_status == CSHSSC_BAD_INPUT_ARG);
+    CSH_TEST_CHECK_MF(CSH_string_map_file("Tests", 0).m_status == CSHSSC_BAD_INPUT_ARG);
+    CSH_TEST_CHECK_MF(CSH_string_map_file(NULL, 0).m_status == CSHSSC_BAD_INPUT_STR);
+}
+
+// Random lines of every length, crossing the 64 byte blocks, with and without "\r\n" endings.
+static void CSH_test_lines_random(void)
+{
+    static char buffer[600];
+    size_t failures = 0;
+    for (size_t round = 0; round < 20000; round++)
+    {
+        size_t size = CSH_test_random() % 600;
+        uint64_t density = 1 + (CSH_test_random() % 50);
+        for (size_t i = 0; i < size; i++)
+        {
+            buffer[i] = ((CSH_test_random() % density) == 0) ? '\n' : (((CSH_test_random() % 9) == 0) ? '\r' : 'x');
+        }
+        failures += CSH_test_check_lines(buffer, size) ? 0 : 1;
+    }
+    CSH_TEST_CHECK_MF(failures == 0);
+
+    S_CSHLineIterator lines;
+    S_CSHStringView line;
+    CSH_TEST_CHECK_MF(CSH_lines_init(&lines, CSH_STRING_VIEW_DEFAULT_M) == CSHSSC_BAD_INPUT_STR);
+    CSH_lines_init(&lines, CSH_string_view_buffer("\n\r\n", 3));
+    CSH_TEST_CHECK_MF(CSH_lines_next(&lines, &line) && line.m_size == 0 && CSH_lines_next(&lines, &line) && line.m_size == 0);
+    CSH_TEST_CHECK_MF(!CSH_lines_next(&lines, &line));
+}
+
+int main(void)
+{
+    CSH_test_map_file();
+    CSH_test_lines_random();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,103 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+#include "CSHStringKernels.h"
+
+static size_t CSH_test_naive_find(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize)
+{
+    if (in_needleSize > in_haystackSize)
+    {
+        return CSH_STRING_NPOS;
+    }
+    for (size_t i = 0; (i + in_needleSize) <= in_haystackSize; i++)
+    {
+        if (memcmp(in_haystack + i, in_needle, in_needleSize) == 0)
+        {
+            return i;
+        }
+    }
+    return CSH_STRING_NPOS;
+}
+
+// The kernel agrees with a naive search, over haystacks which are allocated to their exact size so reading past the end is caught.
+static void CSH_test_kernel_find(void)
+{
+    srand(1);
+    for (size_t round = 0; round < 50000; round++)
+    {
+        size_t haystackSize = (size_t)(rand() % 200);
+        size_t needleSize = (size_t)(rand() % 6);
+        char* haystack = malloc(haystackSize + 1);
+        char* needle = malloc(needleSize + 1);
+        for (size_t i = 0; i < haystackSize; i++)
+        {
+            haystack[i] = (char)('a' + (rand() % 3));
+        }
+        for (size_t i = 0; i < needleSize; i++)
+        {
+            needle[i] = (char)('a' + (rand() % 3));
+        }
+
+        CSH_TEST_CHECK_MF(CSH_kernel_find(haystack, haystackSize, needle, needleSize) == CSH_test_naive_find(haystack, haystackSize, needle, needleSize));
+        free(haystack);
+        free(needle);
+    }
+
+    // An empty needle matches at the start, even of an empty haystack.
+    CSH_TEST_CHECK_MF(CSH_kernel_find("", 0, "", 0) == 0);
+    CSH_TEST_CHECK_MF(CSH_kernel_find("abc", 3, "abcd", 4) == CSH_STRING_NPOS);
+}
+
+// Finding in strings and cstrs, from a position, with needles that can't match.
+static void CSH_test_string_find(void)
+{
+    S_CSHString str = CSH_string_create_cstr("hello world, hello there, hello!", 100);
+    S_CSHString needle = CSH_string_create_cstr("there", 100);
+
+    CSH_TEST_CHECK_MF(CSH_string_find_cstr(&str, 0, "hello") == 0);
+    CSH_TEST_CHECK_MF(CSH_string_find_cstr(&str, 1, "hello") == 13);
+    CSH_TEST_CHECK_MF(CSH_string_find_cstr(&str, 0, "xyz") == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_find_cstr(&str, 0, "hello!!") == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_find_cstr(&str, str.m_size, "h") == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_find_cstr(&str, 0, NULL) == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_find(&str, 0, &needle) == 19);
+    CSH_TEST_CHECK_MF(CSH_string_find(&needle, 0, &str) == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_find(&str, 0, NULL) == CSH_STRING_NPOS);
+
+    // A cstr needle that reaches m_maxCstrSize isn't searched for.
+    CSH_string_set_max_cstr_size(&str, 4);
+    CSH_TEST_CHECK_MF(CSH_string_find_cstr(&str, 0, "hell") == 0);
+    CSH_TEST_CHECK_MF(CSH_string_find_cstr(&str, 0, "hello") == CSH_STRING_NPOS);
+
+    // Only the first in_maxSize characters of the cstr being searched are read.
+    CSH_TEST_CHECK_MF(CSH_cstr_find("abcabc", 10, 1, "abc") == 3);
+    CSH_TEST_CHECK_MF(CSH_cstr_find("abcabc", 5, 1, "abc") == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_cstr_find("abcabc", 5, 0, "cab") == 2);
+    CSH_TEST_CHECK_MF(CSH_cstr_find("abcabc", 10, 4, "abcdefghijklmnop") == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_cstr_find(NULL, 10, 0, "a") == CSH_STRING_NPOS);
+
+    CSH_string_free(&needle);
+    CSH_string_free(&str);
+}
+
+// The search uses the stored size, so embedded null characters don't end it.
+static void CSH_test_find_embedded_null(void)
+{
+    S_CSHString str = CSH_string_create_view(CSH_string_view_buffer("abc\0def\0abc", 11));
+    S_CSHString needle = CSH_string_create_view(CSH_string_view_buffer("\0abc", 4));
+
+    CSH_TEST_CHECK_MF(CSH_string_find_cstr(&str, 1, "abc") == 8);
+    CSH_TEST_CHECK_MF(CSH_string_find_cstr(&str, 0, "def") == 4);
+    CSH_TEST_CHECK_MF(CSH_string_find(&str, 0, &needle) == 7);
+
+    CSH_string_free(&needle);
+    CSH_string_free(&str);
+}
+
+int main(void)
+{
+    CSH_test_kernel_find();
+    CSH_test_string_find();
+    CSH_test_find_embedded_null();
+
+    return CSH_test_result(__FILE__);
+}
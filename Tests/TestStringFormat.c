@@ -0,0 +1,66 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+
+// Formatted appends agree with snprintf, and output which fits in the spare capacity is written without allocating.
+static void CSH_test_append_format(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHString str = CSH_STRING_ALLOCATOR_M(&allocator);
+
+    static char model[200000];
+    size_t modelSize = 0;
+    for (int i = 0; i < 3000; i++)
+    {
+        CSHConstCharPtr_t field = ((i % 7) != 0) ? "ab" : "a much longer field value here";
+        CSH_TEST_CHECK_MF(CSH_string_append_format(&str, "%d:%s|%.3f;", i, field, (i * 0.5)) == CSHSSC_NONE);
+        modelSize += (size_t)snprintf(model + modelSize, sizeof(model) - modelSize, "%d:%s|%.3f;", i, field, (i * 0.5));
+    }
+    CSH_TEST_CHECK_MF(str.m_size == modelSize && memcmp(CSH_string_data(&str), model, modelSize) == 0);
+    CSH_TEST_CHECK_MF(CSH_string_data(&str)[modelSize] == '\0');
+
+    CSH_string_clear(&str, false);
+    size_t allocCount = state.m_allocCount;
+    CSH_TEST_CHECK_MF(CSH_string_append_format(&str, "%s", "") == CSHSSC_NONE && str.m_size == 0);
+    CSH_TEST_CHECK_MF(CSH_string_append_format(&str, "x=%d", 5) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_string_append_format(&str, " %030d", 7) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), "x=5 000000000000000000000000000007") == 0 && state.m_allocCount == allocCount);
+
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+// Output which doesn't fit grows the string once, and a failed grow or a bad argument leaves the string as it was.
+static void CSH_test_append_format_grow(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHString str = CSH_STRING_ALLOCATOR_M(&allocator);
+    CSH_string_assign_cstr(&str, "a string which is stored on the heap");
+    CSH_string_shrink_to_fit(&str);
+
+    size_t allocCount = state.m_allocCount;
+    CSH_TEST_CHECK_MF(CSH_string_append_format(&str, " %0500d", 1) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(state.m_allocCount == (allocCount + 1) && str.m_size == (36 + 501) && CSH_string_data(&str)[536] == '1');
+
+    CSH_string_shrink_to_fit(&str);
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(CSH_string_append_format(&str, "%s and more", "text") == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(str.m_size == 537 && CSH_string_data(&str)[537] == '\0');
+    state.m_failAfter = SIZE_MAX;
+
+    CSH_TEST_CHECK_MF(CSH_string_append_format(&str, NULL) == CSHSSC_BAD_INPUT_STR);
+    CSH_TEST_CHECK_MF(CSH_string_append_format(NULL, "%d", 1) == CSHSSC_BAD_INPUT_STR);
+    CSH_TEST_CHECK_MF(str.m_size == 537);
+
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_append_format();
+    CSH_test_append_format_grow();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,96 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+
+// Appending one character at a time reallocates a logarithmic number of times, not once per character.
+static void CSH_test_geometric_growth(void)
+{
+    S_CSHString str = CSH_STRING_DEFAULT_M;
+    size_t capacityChanges = 0;
+    size_t lastCapacity = 0;
+    for (size_t i = 0; i < 100000; i++)
+    {
+        CSH_TEST_CHECK_MF(CSH_string_add_char(&str, (CSHChar_t)('a' + (i % 26))) == CSHSSC_NONE);
+        if (str.m_status != CSHSSC_USE_SSO && str.m_capacity != lastCapacity)
+        {
+            capacityChanges += 1;
+            lastCapacity = str.m_capacity;
+        }
+    }
+
+    CSH_TEST_CHECK_MF(str.m_size == 100000 && str.m_nullSize == 100001);
+    CSH_TEST_CHECK_MF(strlen(CSH_string_data(&str)) == 100000);
+    CSH_TEST_CHECK_MF(CSH_string_data(&str)[99999] == (CSHChar_t)('a' + (99999 % 26)));
+    CSH_TEST_CHECK_MF(capacityChanges < 40);
+    CSH_string_free(&str);
+}
+
+// A factor of 100 with no minimum step grows by exactly what's needed, and the per string factor overrides the global one.
+static void CSH_test_growth_policy(void)
+{
+    CSH_TEST_CHECK_MF(CSH_string_set_default_growth(99, 0) == CSHSSC_BAD_INPUT_ARG);
+    CSH_TEST_CHECK_MF(CSH_string_set_default_growth(100, 0) == CSHSSC_NONE);
+
+    S_CSHString str = CSH_string_create_cstr("0123456789012345678901234567890123456789", 100);
+    CSH_string_shrink_to_fit(&str);
+    CSH_string_add_char(&str, 'x');
+    CSH_TEST_CHECK_MF(str.m_capacity == str.m_nullSize);
+
+    CSH_TEST_CHECK_MF(CSH_string_set_growth_factor(&str, 50) == CSHSSC_BAD_INPUT_ARG);
+    CSH_TEST_CHECK_MF(CSH_string_set_growth_factor(&str, 200) == CSHSSC_NONE);
+    size_t capacity = str.m_capacity;
+    CSH_string_add_char(&str, 'y');
+    CSH_TEST_CHECK_MF(str.m_capacity == (capacity * 2));
+
+    CSH_TEST_CHECK_MF(CSH_string_set_default_growth(CSH_STRING_GROWTH_FACTOR_PERCENT_DEFAULT_M, CSH_STRING_GROWTH_MIN_STEP_DEFAULT_M) == CSHSSC_NONE);
+    CSH_string_free(&str);
+}
+
+// Appending a string to itself, including as a cstr into its own buffer, while the append makes it reallocate.
+static void CSH_test_self_append(void)
+{
+    S_CSHString str = CSH_string_create_cstr("abcdefghijklmnopqrstuvwxyz0123456789", 100);
+    CSH_string_shrink_to_fit(&str);
+    CSH_TEST_CHECK_MF(CSH_string_concat_right(&str, &str) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(str.m_size == 72 && strcmp(CSH_string_data(&str) + 36, "abcdefghijklmnopqrstuvwxyz0123456789") == 0);
+
+    CSH_string_shrink_to_fit(&str);
+    CSH_TEST_CHECK_MF(CSH_string_concat_right_cstr(&str, CSH_string_data(&str) + 62) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(str.m_size == 82 && strcmp(CSH_string_data(&str) + 62, "01234567890123456789") == 0);
+    CSH_string_free(&str);
+}
+
+// A cstr longer than m_maxCstrSize, or an allocation failure, leaves the string as it was.
+static void CSH_test_failed_appends(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHString str = CSH_STRING_ALLOCATOR_M(&allocator);
+    CSH_TEST_CHECK_MF(CSH_string_assign_cstr(&str, "0123456789012345678901234567890123456789") == CSHSSC_NONE);
+    CSH_string_shrink_to_fit(&str);
+
+    CSH_string_set_max_cstr_size(&str, 4);
+    CSH_TEST_CHECK_MF(CSH_string_concat_right_cstr(&str, "abcde") == CSHSSC_CSTR_DOESNT_FIT);
+    CSH_TEST_CHECK_MF(CSH_string_concat_right_cstr(&str, "abcd") == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(str.m_size == 44);
+
+    CSH_string_shrink_to_fit(&str);
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(CSH_string_add_char(&str, 'x') == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(CSH_string_concat_right_cstr(&str, "ab") == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(CSH_string_extend(&str, 10) == NULL);
+    CSH_TEST_CHECK_MF(str.m_size == 44 && strcmp(CSH_string_data(&str) + 40, "abcd") == 0);
+
+    state.m_failAfter = SIZE_MAX;
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_geometric_growth();
+    CSH_test_growth_policy();
+    CSH_test_self_append();
+    CSH_test_failed_appends();
+
+    return CSH_test_result(__FILE__);
+}
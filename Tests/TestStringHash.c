@@ -0,0 +1,100 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+#include "CSHStringKernels.h"
+
+// The hash depends only on the bytes and the seed, not on where they are in memory, and short keys don't collide.
+static void CSH_test_kernel_hash(void)
+{
+    static char buffer[5000];
+    static char shifted[5008];
+    srand(7);
+    for (size_t i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = (char)rand();
+    }
+
+    for (size_t size = 0; size < sizeof(buffer); size += 7)
+    {
+        size_t offset = (size % 8);
+        memcpy(shifted + offset, buffer, size);
+        CSH_TEST_CHECK_MF(CSH_kernel_hash(buffer, size, size) == CSH_kernel_hash(shifted + offset, size, size));
+        CSH_TEST_CHECK_MF(CSH_kernel_hash(buffer, size, 0) != CSH_kernel_hash(buffer, size, 1));
+        if (size != 0)
+        {
+            CSH_TEST_CHECK_MF(CSH_kernel_hash(buffer, size, 0) != CSH_kernel_hash(buffer, (size - 1), 0));
+        }
+    }
+
+    static uint64_t hashes[2000];
+    size_t collisions = 0;
+    for (size_t i = 0; i < 2000; i++)
+    {
+        char key[16];
+        int size = snprintf(key, sizeof(key), "key%zu", i);
+        hashes[i] = CSH_kernel_hash(key, (size_t)size, 0);
+        for (size_t j = 0; j < i; j++)
+        {
+            collisions += (hashes[j] == hashes[i]);
+        }
+    }
+    CSH_TEST_CHECK_MF(collisions == 0);
+}
+
+// Every function which changes the characters invalidates the cached hash.
+static void CSH_test_cached_hash(void)
+{
+    S_CSHString str = CSH_string_create_cstr("hello world", 100);
+    S_CSHString other = CSH_string_create_cstr("abc", 100);
+
+    uint64_t hash = CSH_string_hash_cached(&str);
+    CSH_TEST_CHECK_MF(str.m_hashValid && hash == CSH_string_view_hash(CSH_string_view_cstr("hello world", 100)));
+    CSH_TEST_CHECK_MF(str.m_hashValid && CSH_string_hash(&str) == hash);
+
+    // CSH_string_hash doesn't store what it computes.
+    CSH_string_add_char(&str, '!');
+    CSH_TEST_CHECK_MF(!str.m_hashValid);
+    CSH_TEST_CHECK_MF(CSH_string_hash(&str) != hash && !str.m_hashValid);
+
+    #define CSH_TEST_CHANGES_HASH_MF(in_change) \
+    { \
+        CSH_string_hash_cached(&str); \
+        in_change; \
+        CSH_TEST_CHECK_MF(!str.m_hashValid); \
+        CSH_TEST_CHECK_MF(CSH_string_hash_cached(&str) == CSH_string_view_hash(CSH_string_view(&str))); \
+    }
+
+    CSH_TEST_CHANGES_HASH_MF(CSH_string_concat_right(&str, &other));
+    CSH_TEST_CHANGES_HASH_MF(CSH_string_concat_right_cstr(&str, "def"));
+    CSH_TEST_CHANGES_HASH_MF(CSH_string_concat_left_cstr("front", &str));
+    CSH_TEST_CHANGES_HASH_MF(CSH_string_insert_cstr(&str, 3, "ins"));
+    CSH_TEST_CHANGES_HASH_MF(CSH_string_erase(&str, 0, 2));
+    CSH_TEST_CHANGES_HASH_MF(CSH_string_replace_cstr(&str, 1, 2, "xyz"));
+    CSH_TEST_CHANGES_HASH_MF(CSH_string_resize(&str, 40, 'q'));
+    CSH_TEST_CHANGES_HASH_MF(CSH_string_to_upper(&str));
+    CSH_TEST_CHANGES_HASH_MF(memset(CSH_string_extend(&str, 3), 'e', 3));
+    CSH_TEST_CHANGES_HASH_MF(CSH_string_assign(&str, &other));
+    CSH_TEST_CHANGES_HASH_MF(CSH_string_assign_cstr(&str, "assigned"));
+    CSH_TEST_CHANGES_HASH_MF(CSH_string_clear(&str, false));
+
+    #undef CSH_TEST_CHANGES_HASH_MF
+
+    // A failed change leaves the characters, and so the hash, as they were.
+    CSH_string_assign_cstr(&str, "hello");
+    hash = CSH_string_hash_cached(&str);
+    CSH_string_set_max_cstr_size(&str, 2);
+    CSH_TEST_CHECK_MF(CSH_string_concat_right_cstr(&str, "abc") == CSHSSC_CSTR_DOESNT_FIT);
+    CSH_TEST_CHECK_MF(CSH_string_hash(&str) == hash);
+
+    CSH_TEST_CHECK_MF(CSH_string_hash(NULL) == 0);
+
+    CSH_string_free(&other);
+    CSH_string_free(&str);
+}
+
+int main(void)
+{
+    CSH_test_kernel_hash();
+    CSH_test_cached_hash();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,131 @@
+#include "CSHTest.h"
+#include "CSHStringIntern.h"
+
+// Equal strings get the same handle however they're passed in, and the interned characters never move.
+static void CSH_test_intern_dedup(void)
+{
+    S_CSHInternPool pool;
+    CSH_TEST_CHECK_MF(CSH_intern_init(&pool, NULL) == CSHSSC_NONE);
+
+    static CSHInternHandle_t handles[20000];
+    char key[64];
+    for (size_t round = 0; round < 3; round++)
+    {
+        for (size_t i = 0; i < 20000; i++)
+        {
+            snprintf(key, sizeof(key), "host-%zu.example.com", i);
+            CSHInternHandle_t handle = CSH_intern_cstr(&pool, key);
+            if (round == 0)
+            {
+                CSH_TEST_CHECK_MF(handle == (CSHInternHandle_t)(i + 1));
+                handles[i] = handle;
+            }
+            else
+            {
+                CSH_TEST_CHECK_MF(handle == handles[i]);
+            }
+        }
+    }
+    CSH_TEST_CHECK_MF(pool.m_count == 20000);
+
+    S_CSHStringView view = CSH_intern_get(&pool, handles[1234]);
+    CSH_TEST_CHECK_MF(CSH_string_view_compare(view, CSH_string_view_cstr("host-1234.example.com", 100)) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(view.m_strPtr[view.m_size] == '\0');
+    CSH_TEST_CHECK_MF(CSH_intern_get(&pool, CSH_INTERN_INVALID_HANDLE_M).m_strPtr == NULL);
+    CSH_TEST_CHECK_MF(CSH_intern_get(&pool, 20001).m_strPtr == NULL);
+
+    S_CSHString str = CSH_string_create_cstr("host-7.example.com", 100);
+    CSH_TEST_CHECK_MF(CSH_intern_string(&pool, &str) == handles[7]);
+    CSH_string_free(&str);
+
+    // Interning the pool's own characters, or part of them, while the pool grows.
+    CSH_TEST_CHECK_MF(CSH_intern_view(&pool, view) == handles[1234]);
+    CSHInternHandle_t prefix = CSH_intern_view(&pool, CSH_string_view_substr(view, 0, 9));
+    CSH_TEST_CHECK_MF(prefix == 20001 && CSH_intern_find(&pool, CSH_string_view_cstr("host-1234", 100)) == prefix);
+    CSH_TEST_CHECK_MF(CSH_intern_get(&pool, handles[1234]).m_strPtr == view.m_strPtr);
+
+    CSH_intern_release(&pool);
+}
+
+// Empty strings, embedded null characters, and strings bigger than a chunk.
+static void CSH_test_intern_edges(void)
+{
+    S_CSHInternPool pool;
+    CSH_intern_init(&pool, NULL);
+
+    CSHInternHandle_t empty = CSH_intern_view(&pool, CSH_string_view_buffer("", 0));
+    CSH_TEST_CHECK_MF(empty != CSH_INTERN_INVALID_HANDLE_M && CSH_intern_cstr(&pool, "") == empty);
+    CSH_TEST_CHECK_MF(CSH_intern_get(&pool, empty).m_size == 0);
+    CSH_TEST_CHECK_MF(CSH_intern_view(&pool, CSH_STRING_VIEW_DEFAULT_M) == CSH_INTERN_INVALID_HANDLE_M);
+    CSH_TEST_CHECK_MF(CSH_intern_cstr(&pool, NULL) == CSH_INTERN_INVALID_HANDLE_M);
+
+    CSHInternHandle_t one = CSH_intern_view(&pool, CSH_string_view_buffer("a\0b", 3));
+    CSHInternHandle_t two = CSH_intern_view(&pool, CSH_string_view_buffer("a\0c", 3));
+    CSH_TEST_CHECK_MF(one != two && CSH_intern_cstr(&pool, "a") != one);
+    CSH_TEST_CHECK_MF(CSH_intern_find(&pool, CSH_string_view_buffer("a\0b", 3)) == one);
+
+    static char big[100000];
+    memset(big, 'x', sizeof(big));
+    CSHInternHandle_t bigHandle = CSH_intern_view(&pool, CSH_string_view_buffer(big, sizeof(big)));
+    CSH_TEST_CHECK_MF(CSH_intern_get(&pool, bigHandle).m_size == sizeof(big));
+    CSH_TEST_CHECK_MF(CSH_intern_view(&pool, CSH_string_view_buffer(big, sizeof(big))) == bigHandle);
+
+    // Finding never adds, and a cstr reaching m_maxCstrSize isn't interned.
+    size_t count = pool.m_count;
+    CSH_TEST_CHECK_MF(CSH_intern_find(&pool, CSH_string_view_cstr("missing", 10)) == CSH_INTERN_INVALID_HANDLE_M && pool.m_count == count);
+    pool.m_maxCstrSize = 4;
+    CSH_TEST_CHECK_MF(CSH_intern_cstr(&pool, "abcd") == CSH_INTERN_INVALID_HANDLE_M && pool.m_count == count);
+    CSH_TEST_CHECK_MF(CSH_intern_cstr(&pool, "abc") != CSH_INTERN_INVALID_HANDLE_M);
+
+    CSH_intern_release(&pool);
+}
+
+// A failed allocation returns the invalid handle, and leaves the pool as it was.
+static void CSH_test_intern_alloc_failure(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHInternPool pool;
+    CSH_intern_init(&pool, &allocator);
+
+    char key[32];
+    size_t failures = 0;
+    for (size_t i = 0; i < 2000; i++)
+    {
+        snprintf(key, sizeof(key), "key%zu", i);
+        state.m_failAfter = ((i % 7) == 0) ? 0 : SIZE_MAX;
+        size_t count = pool.m_count;
+        CSHInternHandle_t handle = CSH_intern_cstr(&pool, key);
+        if (handle == CSH_INTERN_INVALID_HANDLE_M)
+        {
+            failures += 1;
+            CSH_TEST_CHECK_MF(pool.m_count == count && CSH_intern_find(&pool, CSH_string_view_cstr(key, 32)) == CSH_INTERN_INVALID_HANDLE_M);
+        }
+        else
+        {
+            CSH_TEST_CHECK_MF(CSH_string_view_compare(CSH_intern_get(&pool, handle), CSH_string_view_cstr(key, 32)) == CSHSSC_NONE);
+        }
+    }
+    CSH_TEST_CHECK_MF(failures != 0);
+    state.m_failAfter = SIZE_MAX;
+
+    for (size_t i = 0; i < 2000; i++)
+    {
+        snprintf(key, sizeof(key), "key%zu", i);
+        CSHInternHandle_t handle = CSH_intern_cstr(&pool, key);
+        CSH_TEST_CHECK_MF(handle != CSH_INTERN_INVALID_HANDLE_M && CSH_intern_find(&pool, CSH_string_view_cstr(key, 32)) == handle);
+    }
+    CSH_TEST_CHECK_MF(pool.m_count == 2000);
+
+    CSH_intern_release(&pool);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_intern_dedup();
+    CSH_test_intern_edges();
+    CSH_test_intern_alloc_failure();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,176 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+#include "CSHStringBuilder.h"
+
+static const char CSH_test_long[] = "hello world, this is long";
+
+// Joining views, strings and cstrs, with and without a separator, allocates the result once.
+static void CSH_test_join(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    CSH_allocator_set_default(&allocator);
+
+    S_CSHStringView comma = CSH_string_view_buffer(",", 1);
+    S_CSHStringView views[3] = {CSH_string_view_buffer("a", 1), CSH_string_view_buffer("", 0), CSH_string_view_cstr(CSH_test_long, 100)};
+    S_CSHString joined = CSH_string_join(views, 3, comma);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&joined), "a,,hello world, this is long") == 0);
+    CSH_TEST_CHECK_MF(state.m_allocCount == 1 && joined.m_capacity == (joined.m_size + 1));
+    CSH_string_free(&joined);
+
+    S_CSHString strs[3] = {CSH_string_create_cstr("x", 10), CSH_STRING_DEFAULT_M, CSH_string_create_cstr(CSH_test_long, 100)};
+    joined = CSH_string_join_strings(strs, 3, CSH_string_view_buffer(" | ", 3));
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&joined), "x |  | hello world, this is long") == 0);
+    CSH_string_free(&joined);
+
+    CSHConstCharPtr_t cstrs[3] = {"one", "two", "three"};
+    joined = CSH_string_join_cstrs(cstrs, 3, 10, CSH_STRING_VIEW_DEFAULT_M);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&joined), "onetwothree") == 0);
+    CSH_string_free(&joined);
+
+    // More cstrs than fit on the stack are each measured once into a scratch array.
+    CSHConstCharPtr_t manyCstrs[20];
+    for (size_t i = 0; i < 20; i++)
+    {
+        manyCstrs[i] = cstrs[i % 3];
+    }
+    joined = CSH_string_join_cstrs(manyCstrs, 20, 10, comma);
+    CSH_TEST_CHECK_MF(joined.m_size == (7 * 3 + 7 * 3 + 6 * 5 + 19) && strncmp(CSH_string_data(&joined), "one,two,three,one", 17) == 0);
+    CSH_string_free(&joined);
+
+    // An empty join is an empty string, and an invalid or overlong piece fails the whole join.
+    joined = CSH_string_join(NULL, 0, comma);
+    CSH_TEST_CHECK_MF(joined.m_status >= CSHSSC_NONE && joined.m_size == 0 && CSH_string_view(&joined).m_strPtr != NULL);
+    CSH_string_free(&joined);
+    joined = CSH_string_join_cstrs(cstrs, 3, 4, comma);
+    CSH_TEST_CHECK_MF(joined.m_status == CSHSSC_BAD_INPUT_STR);
+    views[1] = CSH_STRING_VIEW_DEFAULT_M;
+    joined = CSH_string_join(views, 3, comma);
+    CSH_TEST_CHECK_MF(joined.m_status == CSHSSC_BAD_INPUT_STR);
+
+    state.m_failAfter = 0;
+    joined = CSH_string_join_cstrs(cstrs, 3, 10, CSH_string_view_cstr(CSH_test_long, 100));
+    CSH_TEST_CHECK_MF(joined.m_status == CSHSSC_ALLOC_FAILED);
+    state.m_failAfter = SIZE_MAX;
+
+    CSH_allocator_set_default(NULL);
+    CSH_string_free(&strs[0]);
+    CSH_string_free(&strs[2]);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+// Appending grows the string at most once, pieces and separators may view the string itself, and a failed append leaves it as it was.
+static void CSH_test_append_join(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHString str = CSH_STRING_ALLOCATOR_M(&allocator);
+    CSH_string_assign_cstr(&str, "hello");
+
+    S_CSHStringView separator = CSH_string_view_buffer(", ", 2);
+    CSH_TEST_CHECK_MF(CSH_string_append_join(&str, (S_CSHStringView[]){CSH_string_view(&str), CSH_string_view(&str)}, 2, separator) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), "hellohello, hello") == 0);
+
+    // Pieces past the stack array which view the string need one scratch allocation, which is freed again.
+    for (size_t round = 0; round < 5; round++)
+    {
+        CSH_string_shrink_to_fit(&str);
+        S_CSHStringView pieces[20];
+        for (size_t i = 0; i < 20; i++)
+        {
+            pieces[i] = CSH_string_view_substr(CSH_string_view(&str), (i % 3), 2);
+        }
+        S_CSHStringView selfSeparator = CSH_string_view_substr(CSH_string_view(&str), 0, 1);
+        size_t size = str.m_size;
+        size_t allocCount = state.m_allocCount;
+        CSH_TEST_CHECK_MF(CSH_string_append_join(&str, pieces, 20, selfSeparator) == CSHSSC_NONE);
+        CSH_TEST_CHECK_MF(str.m_size == (size + 40 + 19) && state.m_allocCount <= (allocCount + 2));
+        CSH_TEST_CHECK_MF(strncmp(CSH_string_data(&str) + size, "hehelhllhhe", 11) == 0);
+        CSH_TEST_CHECK_MF(state.m_liveBytes == str.m_capacity);
+    }
+
+    // Unaliased pieces past the stack array are fetched again rather than kept, so only the string grows.
+    S_CSHStringView others[40];
+    for (size_t i = 0; i < 40; i++)
+    {
+        others[i] = CSH_string_view_buffer(CSH_test_long + (i % 5), 1);
+    }
+    size_t size = str.m_size;
+    CSH_string_reserve(&str, size + 200);
+    size_t allocCount = state.m_allocCount;
+    CSH_TEST_CHECK_MF(CSH_string_append_join(&str, others, 40, separator) == CSHSSC_NONE && state.m_allocCount == allocCount);
+    CSH_TEST_CHECK_MF(strncmp(CSH_string_data(&str) + str.m_size - 13, "h, e, l, l, o", 13) == 0);
+    CSH_string_erase(&str, size, SIZE_MAX);
+
+    CSH_string_shrink_to_fit(&str);
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(CSH_string_append_join(&str, &separator, 1, separator) == CSHSSC_ALLOC_FAILED);
+    state.m_failAfter = SIZE_MAX;
+    CSH_TEST_CHECK_MF(CSH_string_append_join(&str, (S_CSHStringView[]){separator, CSH_STRING_VIEW_DEFAULT_M}, 2, separator) == CSHSSC_BAD_INPUT_STR);
+    CSH_TEST_CHECK_MF(str.m_size == size && strncmp(CSH_string_data(&str), "hellohello, hello", 17) == 0);
+
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+// A builder collects a mix of pieces, and a reused builder and line stop allocating once they're big enough.
+static void CSH_test_builder(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHStringBuilder builder;
+    CSH_TEST_CHECK_MF(CSH_builder_init(&builder, 0, &allocator) == CSHSSC_NONE);
+    S_CSHString line = CSH_STRING_ALLOCATOR_M(&allocator);
+    S_CSHString field = CSH_string_create_cstr("x", 10);
+    S_CSHStringView comma = CSH_string_view_buffer(",", 1);
+
+    size_t allocCount = 0;
+    for (size_t round = 0; round < 3; round++)
+    {
+        CSH_builder_clear(&builder);
+        CSH_string_clear(&line, false);
+        for (size_t i = 0; i < 40; i++)
+        {
+            if ((i % 3) == 0)
+            {
+                CSH_builder_add_cstr(&builder, "f");
+            }
+            else if ((i % 3) == 1)
+            {
+                CSH_builder_add_string(&builder, &field);
+            }
+            else
+            {
+                CSH_builder_add(&builder, CSH_string_view_cstr(CSH_test_long, 100));
+            }
+        }
+        CSH_TEST_CHECK_MF(CSH_builder_append_to(&builder, &line, comma) == CSHSSC_NONE);
+        CSH_TEST_CHECK_MF(line.m_size == CSH_builder_size(&builder, comma) && line.m_size == (14 + 13 + (13 * 25) + 39));
+        if (round == 1)
+        {
+            allocCount = state.m_allocCount;
+        }
+    }
+    CSH_TEST_CHECK_MF(state.m_allocCount == allocCount);
+
+    S_CSHString built = CSH_builder_build(&builder, comma);
+    CSH_TEST_CHECK_MF(CSH_string_view_compare(CSH_string_view(&built), CSH_string_view(&line)) == CSHSSC_NONE);
+    CSH_string_free(&built);
+
+    builder.m_maxCstrSize = 2;
+    CSH_TEST_CHECK_MF(CSH_builder_add_cstr(&builder, "ab") == CSHSSC_CSTR_DOESNT_FIT);
+
+    CSH_string_free(&field);
+    CSH_string_free(&line);
+    CSH_builder_free(&builder);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_join();
+    CSH_test_append_join();
+    CSH_test_builder();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,153 @@
+#include "CSHTest.h"
+#include "CSHStringMatcher.h"
+
+typedef struct
+{
+    size_t m_patternId;
+    size_t m_pos;
+} S_CSHTestMatch;
+
+typedef struct
+{
+    S_CSHTestMatch m_matches[4096];
+    size_t m_count;
+    size_t m_stopAfter;
+} S_CSHTestMatches;
+
+static bool CSH_test_record_match(void* in_context, size_t in_patternId, size_t in_pos)
+{
+    S_CSHTestMatches* matches = (S_CSHTestMatches*)in_context;
+    matches->m_matches[matches->m_count] = (S_CSHTestMatch){in_patternId, in_pos};
+    matches->m_count += 1;
+    return (matches->m_count < matches->m_stopAfter);
+}
+
+static int CSH_test_match_order(const void* in_one, const void* in_two)
+{
+    const S_CSHTestMatch* one = (const S_CSHTestMatch*)in_one;
+    const S_CSHTestMatch* two = (const S_CSHTestMatch*)in_two;
+    if (one->m_pos != two->m_pos)
+    {
+        return (one->m_pos < two->m_pos) ? -1 : 1;
+    }
+    return (one->m_patternId < two->m_patternId) ? -1 : (one->m_patternId > two->m_patternId);
+}
+
+// Both the failure link and the DFA matchers report every overlapping match a naive search finds, including duplicate patterns.
+static void CSH_test_matcher_random(void)
+{
+    static S_CSHTestMatches found;
+    static S_CSHTestMatch expected[4096];
+    srand(4);
+    for (size_t round = 0; round < 10000; round++)
+    {
+        size_t alphabetSize = (size_t)(2 + (rand() % 3));
+        size_t patternCount = (size_t)(1 + (rand() % 8));
+        char patterns[8][8];
+        S_CSHStringView views[8];
+        for (size_t p = 0; p < patternCount; p++)
+        {
+            size_t size = (size_t)(1 + (rand() % 5));
+            for (size_t i = 0; i < size; i++)
+            {
+                patterns[p][i] = "abc"[rand() % alphabetSize];
+            }
+            views[p] = CSH_string_view_buffer(patterns[p], size);
+        }
+
+        size_t textSize = (size_t)(rand() % 100);
+        char* text = malloc(textSize + 1);
+        for (size_t i = 0; i < textSize; i++)
+        {
+            text[i] = "abcz"[rand() % (alphabetSize + 1)];
+        }
+
+        size_t expectedCount = 0;
+        for (size_t i = 0; i < textSize; i++)
+        {
+            for (size_t p = 0; p < patternCount; p++)
+            {
+                if ((i + views[p].m_size) <= textSize && memcmp(text + i, patterns[p], views[p].m_size) == 0)
+                {
+                    expected[expectedCount] = (S_CSHTestMatch){p, i};
+                    expectedCount += 1;
+                }
+            }
+        }
+
+        for (uint32_t flags = CSHMF_NONE; flags <= CSHMF_DFA; flags++)
+        {
+            S_CSHMatcher matcher;
+            CSH_TEST_CHECK_MF(CSH_matcher_init(&matcher, views, patternCount, flags, NULL) == CSHSSC_NONE);
+            found.m_count = 0;
+            found.m_stopAfter = SIZE_MAX;
+            size_t count = CSH_matcher_scan(&matcher, CSH_string_view_buffer(text, textSize), CSH_test_record_match, &found);
+            qsort(found.m_matches, found.m_count, sizeof(S_CSHTestMatch), CSH_test_match_order);
+            CSH_TEST_CHECK_MF(count == expectedCount && found.m_count == expectedCount);
+            CSH_TEST_CHECK_MF(memcmp(found.m_matches, expected, (expectedCount * sizeof(S_CSHTestMatch))) == 0);
+            CSH_matcher_free(&matcher);
+        }
+        free(text);
+    }
+}
+
+// Matches are reported in order of where they end, longest first, and the callback can stop the scan.
+static void CSH_test_matcher_order(void)
+{
+    S_CSHStringView patterns[] = {CSH_string_view_cstr("he", 10), CSH_string_view_cstr("she", 10), CSH_string_view_cstr("hers", 10)};
+    S_CSHStringView text = CSH_string_view_cstr("ushers", 10);
+    static S_CSHTestMatches found;
+
+    for (uint32_t flags = CSHMF_NONE; flags <= CSHMF_DFA; flags++)
+    {
+        S_CSHMatcher matcher;
+        CSH_TEST_CHECK_MF(CSH_matcher_init(&matcher, patterns, 3, flags, NULL) == CSHSSC_NONE);
+        found.m_count = 0;
+        found.m_stopAfter = SIZE_MAX;
+        CSH_TEST_CHECK_MF(CSH_matcher_scan(&matcher, text, CSH_test_record_match, &found) == 3);
+        CSH_TEST_CHECK_MF(found.m_matches[0].m_patternId == 1 && found.m_matches[0].m_pos == 1);
+        CSH_TEST_CHECK_MF(found.m_matches[1].m_patternId == 0 && found.m_matches[1].m_pos == 2);
+        CSH_TEST_CHECK_MF(found.m_matches[2].m_patternId == 2 && found.m_matches[2].m_pos == 2);
+
+        found.m_count = 0;
+        found.m_stopAfter = 1;
+        CSH_TEST_CHECK_MF(CSH_matcher_scan(&matcher, text, CSH_test_record_match, &found) == 1);
+        CSH_TEST_CHECK_MF(CSH_matcher_scan(&matcher, CSH_string_view_buffer("", 0), CSH_test_record_match, &found) == 0);
+        CSH_matcher_free(&matcher);
+    }
+}
+
+// Empty and invalid patterns are rejected, and a failed allocation at any point frees what was allocated before it.
+static void CSH_test_matcher_failures(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHStringView patterns[] = {CSH_string_view_cstr("one", 10), CSH_string_view_cstr("two", 10), CSH_string_view_buffer("", 0)};
+    S_CSHMatcher matcher;
+
+    CSH_TEST_CHECK_MF(CSH_matcher_init(&matcher, patterns, 3, CSHMF_NONE, &allocator) == CSHSSC_BAD_INPUT_STR);
+    patterns[2] = CSH_STRING_VIEW_DEFAULT_M;
+    CSH_TEST_CHECK_MF(CSH_matcher_init(&matcher, patterns, 3, CSHMF_NONE, &allocator) == CSHSSC_BAD_INPUT_STR);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+
+    for (size_t failAfter = 0; failAfter < 8; failAfter++)
+    {
+        state.m_failAfter = failAfter;
+        int8_t status = CSH_matcher_init(&matcher, patterns, 2, CSHMF_DFA, &allocator);
+        CSH_TEST_CHECK_MF(status == CSHSSC_NONE || status == CSHSSC_ALLOC_FAILED);
+        if (status == CSHSSC_NONE)
+        {
+            CSH_matcher_free(&matcher);
+        }
+        CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+    }
+}
+
+int main(void)
+{
+    CSH_test_matcher_random();
+    CSH_test_matcher_order();
+    CSH_test_matcher_failures();
+
+    return CSH_test_result(__FILE__);
+}
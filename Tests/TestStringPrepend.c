@@ -0,0 +1,98 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+
+// Prepending one character at a time reallocates a logarithmic number of times, and reserved front slack is used without allocating.
+static void CSH_test_amortized_prepend(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHString str = CSH_STRING_ALLOCATOR_M(&allocator);
+
+    char character[2] = {0, 0};
+    for (size_t i = 0; i < 100000; i++)
+    {
+        character[0] = (char)('a' + (i % 26));
+        CSH_TEST_CHECK_MF(CSH_string_concat_left_cstr(character, &str) == CSHSSC_NONE);
+    }
+    CSH_TEST_CHECK_MF(str.m_size == 100000 && state.m_allocCount < 60);
+    CSH_TEST_CHECK_MF(CSH_string_data(&str)[0] == (char)('a' + (99999 % 26)) && CSH_string_data(&str)[99999] == 'a');
+    CSH_TEST_CHECK_MF(CSH_string_data(&str)[100000] == '\0');
+    CSH_TEST_CHECK_MF(state.m_liveBytes == (str.m_frontSlack + str.m_capacity));
+
+    CSH_string_assign_cstr(&str, "body");
+    CSH_string_shrink_to_fit(&str);
+    CSH_TEST_CHECK_MF(str.m_frontSlack == 0);
+    CSH_TEST_CHECK_MF(CSH_string_reserve_front(&str, 100) == CSHSSC_NONE && str.m_frontSlack >= 100);
+    size_t allocCount = state.m_allocCount;
+    for (size_t i = 0; i < 10; i++)
+    {
+        CSH_string_concat_left_cstr("0123456789", &str);
+    }
+    CSH_TEST_CHECK_MF(state.m_allocCount == allocCount && str.m_size == 104);
+    CSH_TEST_CHECK_MF(strncmp(CSH_string_data(&str), "0123456789", 10) == 0 && strcmp(CSH_string_data(&str) + 100, "body") == 0);
+
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+// Prepending a string to itself, or part of itself as a cstr, while the prepend makes it reallocate.
+static void CSH_test_self_prepend(void)
+{
+    S_CSHString str = CSH_STRING_DEFAULT_M;
+    for (size_t i = 0; i < 10; i++)
+    {
+        CSH_string_concat_left_cstr("xyz0123456789", &str);
+    }
+    CSH_string_shrink_to_fit(&str);
+    CSH_TEST_CHECK_MF(CSH_string_concat_left(&str, &str) == CSHSSC_NONE && str.m_size == 260);
+    bool matches = true;
+    for (size_t i = 0; i < 260; i++)
+    {
+        matches = matches && (CSH_string_data(&str)[i] == "xyz0123456789"[i % 13]);
+    }
+    CSH_TEST_CHECK_MF(matches);
+
+    CSH_string_shrink_to_fit(&str);
+    CSH_TEST_CHECK_MF(CSH_string_concat_left_cstr(CSH_string_data(&str) + 250, &str) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(str.m_size == 270 && strncmp(CSH_string_data(&str), "0123456789xyz", 13) == 0);
+
+    // Shrinking drops the front slack.
+    CSH_string_reserve_front(&str, 1000);
+    CSH_string_shrink_to_fit(&str);
+    CSH_TEST_CHECK_MF(str.m_frontSlack == 0 && str.m_capacity == 271 && strncmp(CSH_string_data(&str), "0123456789xyz", 13) == 0);
+    CSH_string_free(&str);
+}
+
+// A prepend which can't allocate, or whose cstr doesn't fit, leaves the string as it was.
+static void CSH_test_failed_prepends(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHString str = CSH_STRING_ALLOCATOR_M(&allocator);
+    CSH_string_assign_cstr(&str, "a string which is stored on the heap");
+    CSH_string_shrink_to_fit(&str);
+
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(CSH_string_concat_left_cstr("front ", &str) == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(CSH_string_concat_left(&str, &str) == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(CSH_string_reserve_front(&str, 10) == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(str.m_frontSlack == 0 && strcmp(CSH_string_data(&str), "a string which is stored on the heap") == 0);
+    state.m_failAfter = SIZE_MAX;
+
+    CSH_string_set_max_cstr_size(&str, 3);
+    CSH_TEST_CHECK_MF(CSH_string_concat_left_cstr("abcd", &str) == CSHSSC_CSTR_DOESNT_FIT);
+    CSH_TEST_CHECK_MF(CSH_string_concat_left_cstr(NULL, &str) == CSHSSC_BAD_INPUT_STR);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), "a string which is stored on the heap") == 0);
+
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_amortized_prepend();
+    CSH_test_self_prepend();
+    CSH_test_failed_prepends();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,97 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+#include "CSHStringKernels.h"
+
+static size_t CSH_test_naive_rfind(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize)
+{
+    if (in_needleSize > in_haystackSize)
+    {
+        return CSH_STRING_NPOS;
+    }
+    for (size_t i = (in_haystackSize - in_needleSize + 1); i > 0; i--)
+    {
+        if (memcmp(in_haystack + i - 1, in_needle, in_needleSize) == 0)
+        {
+            return (i - 1);
+        }
+    }
+    return CSH_STRING_NPOS;
+}
+
+// The kernel agrees with a naive backward search, over haystacks allocated to their exact size.
+// Haystacks run past several blocks, and single byte needles are sometimes left without a match so every block is walked.
+static void CSH_test_kernel_rfind(void)
+{
+    srand(2);
+    for (size_t round = 0; round < 50000; round++)
+    {
+        size_t haystackSize = (size_t)(rand() % 300);
+        size_t needleSize = (size_t)(rand() % 6);
+        char* haystack = malloc(haystackSize + 1);
+        char* needle = malloc(needleSize + 1);
+        for (size_t i = 0; i < haystackSize; i++)
+        {
+            haystack[i] = (char)('a' + (rand() % 3));
+        }
+        for (size_t i = 0; i < needleSize; i++)
+        {
+            needle[i] = (char)('a' + (rand() % 4));
+        }
+
+        CSH_TEST_CHECK_MF(CSH_kernel_rfind(haystack, haystackSize, needle, needleSize) == CSH_test_naive_rfind(haystack, haystackSize, needle, needleSize));
+        free(haystack);
+        free(needle);
+    }
+
+    // An empty needle matches at the end.
+    CSH_TEST_CHECK_MF(CSH_kernel_rfind("abc", 3, "", 0) == 3);
+    CSH_TEST_CHECK_MF(CSH_kernel_rfind("abc", 3, "abcd", 4) == CSH_STRING_NPOS);
+}
+
+// Finding the last match in strings and cstrs, at or after a position.
+static void CSH_test_string_rfind(void)
+{
+    S_CSHString str = CSH_string_create_cstr("/usr/local/share/file.tar.gz", 100);
+    S_CSHString needle = CSH_string_create_cstr("/", 100);
+
+    CSH_TEST_CHECK_MF(CSH_string_rfind_cstr(&str, 0, "/") == 16);
+    CSH_TEST_CHECK_MF(CSH_string_rfind_cstr(&str, 0, ".") == 25);
+    CSH_TEST_CHECK_MF(CSH_string_rfind_cstr(&str, 17, "/") == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_rfind_cstr(&str, 0, "/usr/local/share/file.tar.gz/") == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_rfind_cstr(&str, str.m_size, "z") == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_rfind_cstr(&str, 0, NULL) == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_rfind(&str, 0, &needle) == 16);
+    CSH_TEST_CHECK_MF(CSH_string_rfind(&needle, 0, &str) == CSH_STRING_NPOS);
+
+    // A cstr needle that reaches m_maxCstrSize isn't searched for.
+    CSH_string_set_max_cstr_size(&str, 4);
+    CSH_TEST_CHECK_MF(CSH_string_rfind_cstr(&str, 0, ".gz") == 25);
+    CSH_TEST_CHECK_MF(CSH_string_rfind_cstr(&str, 0, "file.") == CSH_STRING_NPOS);
+
+    // Only the first in_maxSize characters of the cstr being searched are read.
+    CSH_TEST_CHECK_MF(CSH_cstr_rfind("abcabc", 10, 1, "abc") == 3);
+    CSH_TEST_CHECK_MF(CSH_cstr_rfind("abcabc", 5, 0, "abc") == 0);
+    CSH_TEST_CHECK_MF(CSH_cstr_rfind("abcabc", 5, 0, "bc") == 1);
+    CSH_TEST_CHECK_MF(CSH_cstr_rfind(NULL, 10, 0, "a") == CSH_STRING_NPOS);
+
+    CSH_string_free(&needle);
+    CSH_string_free(&str);
+}
+
+// Embedded null characters don't end the backward search.
+static void CSH_test_rfind_embedded_null(void)
+{
+    S_CSHString str = CSH_string_create_view(CSH_string_view_buffer("abc\0def\0abc\0", 12));
+    CSH_TEST_CHECK_MF(CSH_string_rfind_cstr(&str, 0, "abc") == 8);
+    CSH_TEST_CHECK_MF(CSH_string_rfind_cstr(&str, 0, "def") == 4);
+    CSH_string_free(&str);
+}
+
+int main(void)
+{
+    CSH_test_kernel_rfind();
+    CSH_test_string_rfind();
+    CSH_test_rfind_embedded_null();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,134 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+
+static const char CSH_test_long[] = "0123456789012345678901234567890123456789";
+
+// Strings up to CSH_STRING_SSO_CAPACITY_M characters (with the null terminator) stay inline, and move to the heap once they outgrow it.
+static void CSH_test_inline_storage(void)
+{
+    CSH_TEST_CHECK_MF(sizeof(S_CSHString) <= 72);
+
+    S_CSHString str = CSH_string_create_cstr("abc", 100);
+    CSH_TEST_CHECK_MF(str.m_status == CSHSSC_USE_SSO && strcmp(CSH_string_data(&str), "abc") == 0);
+    CSH_TEST_CHECK_MF(CSH_string_data(&str) == str.m_ssoBuffer && CSH_STRING_CAPACITY_MF(&str) == CSH_STRING_SSO_CAPACITY_M);
+
+    for (size_t i = 0; i < 20; i++)
+    {
+        CSH_string_add_char(&str, 'x');
+    }
+    CSH_TEST_CHECK_MF(str.m_status == CSHSSC_USE_SSO && str.m_size == 23);
+
+    CSH_string_add_char(&str, 'y');
+    CSH_TEST_CHECK_MF(str.m_status == CSHSSC_NONE && str.m_size == 24 && str.m_frontSlack == 0);
+    CSH_TEST_CHECK_MF(strlen(CSH_string_data(&str)) == 24 && CSH_string_data(&str)[23] == 'y');
+
+    // Shrinking a heap string back within the inline buffer frees the heap memory.
+    CSH_string_resize(&str, 5, '\0');
+    CSH_string_shrink_to_fit(&str);
+    CSH_TEST_CHECK_MF(str.m_status == CSHSSC_USE_SSO && strcmp(CSH_string_data(&str), "abcxx") == 0);
+
+    S_CSHString copy = CSH_string_create(&str);
+    S_CSHString sub = CSH_string_substr(&str, 1, 100);
+    CSH_TEST_CHECK_MF(copy.m_status == CSHSSC_USE_SSO && strcmp(CSH_string_data(&copy), "abcxx") == 0);
+    CSH_TEST_CHECK_MF(sub.m_status == CSHSSC_USE_SSO && strcmp(CSH_string_data(&sub), "bcxx") == 0);
+
+    CSH_string_swap(&copy, &sub);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&copy), "bcxx") == 0 && strcmp(CSH_string_data(&sub), "abcxx") == 0);
+
+    CSH_string_free(&str);
+    CSH_string_free(&copy);
+    CSH_string_free(&sub);
+}
+
+// The heap fields share their storage with the inline buffer, so inline characters must never be read as a pointer or front slack.
+static void CSH_test_inline_overlay(void)
+{
+    S_CSHString str = CSH_string_create_cstr("\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff", 100);
+    CSH_TEST_CHECK_MF(str.m_status == CSHSSC_USE_SSO);
+
+    CSH_TEST_CHECK_MF(CSH_string_concat_left_cstr("ab", &str) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(str.m_status == CSHSSC_USE_SSO && str.m_size == 22 && memcmp(CSH_string_data(&str), "ab\xff", 3) == 0);
+
+    CSH_TEST_CHECK_MF(CSH_string_concat_left_cstr("0123456789", &str) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(str.m_status == CSHSSC_NONE && str.m_size == 32 && memcmp(CSH_string_data(&str), "0123456789ab\xff", 13) == 0);
+    CSH_string_free(&str);
+
+    // Freeing an inline string leaves an empty string which can be reused.
+    str = CSH_string_create_cstr("\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff", 100);
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(str.m_status == CSHSSC_NONE && str.m_strPtr == NULL && str.m_capacity == 0 && str.m_size == 0);
+    CSH_TEST_CHECK_MF(CSH_string_free(&str) == CSHSSC_NONE);
+    CSH_string_add_char(&str, 'x');
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), "x") == 0);
+
+    CSH_TEST_CHECK_MF(CSH_string_reserve(&str, 10) == CSHSSC_ALREADY_RESERVED && str.m_status == CSHSSC_USE_SSO);
+    CSH_TEST_CHECK_MF(CSH_string_reserve(&str, 100) == CSHSSC_NONE && str.m_status == CSHSSC_NONE && str.m_capacity == 101);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), "x") == 0);
+    CSH_string_free(&str);
+}
+
+// Concatenating inline and heap strings, including each with itself.
+static void CSH_test_concat(void)
+{
+    S_CSHString one = CSH_string_create_cstr("abc", 100);
+    S_CSHString two = CSH_string_create_cstr(CSH_test_long, 100);
+
+    S_CSHString joined = CSH_string_create_concat(&one, &two);
+    CSH_TEST_CHECK_MF(joined.m_size == 43 && strcmp(CSH_string_data(&joined) + 3, CSH_test_long) == 0);
+    CSH_string_free(&joined);
+
+    joined = CSH_string_create_concat(&one, &one);
+    CSH_TEST_CHECK_MF(joined.m_status == CSHSSC_USE_SSO && strcmp(CSH_string_data(&joined), "abcabc") == 0);
+    CSH_string_free(&joined);
+
+    joined = CSH_string_create_concat_cstr("ab", "cd", 10, 10);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&joined), "abcd") == 0);
+    CSH_string_free(&joined);
+
+    joined = CSH_string_create_concat_cstr("abc", "cd", 2, 10);
+    CSH_TEST_CHECK_MF(joined.m_status < 0);
+
+    CSH_string_free(&one);
+    CSH_string_free(&two);
+}
+
+// Constructors report a failed allocation, rather than returning a string without memory.
+static void CSH_test_create_alloc_failure(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    state.m_failAfter = 0;
+    CSH_allocator_set_default(&allocator);
+
+    S_CSHString str = CSH_string_create_cstr(CSH_test_long, 100);
+    CSH_TEST_CHECK_MF(str.m_status == CSHSSC_ALLOC_FAILED);
+    str = CSH_string_create_concat_cstr(CSH_test_long, CSH_test_long, 100, 100);
+    CSH_TEST_CHECK_MF(str.m_status == CSHSSC_ALLOC_FAILED);
+
+    // Inline strings don't allocate, so they're still created.
+    str = CSH_string_create_cstr("hi", 100);
+    CSH_TEST_CHECK_MF(str.m_status == CSHSSC_USE_SSO && strcmp(CSH_string_data(&str), "hi") == 0);
+    CSH_allocator_set_default(NULL);
+
+    // The concatenation uses the first string's allocator.
+    S_CSHString one = CSH_string_create_cstr(CSH_test_long, 100);
+    const S_CSHAllocator* oneAllocator = one.m_allocator;
+    one.m_allocator = &allocator;
+    S_CSHString joined = CSH_string_create_concat(&one, &str);
+    CSH_TEST_CHECK_MF(joined.m_status == CSHSSC_ALLOC_FAILED);
+    one.m_allocator = oneAllocator;
+
+    CSH_string_free(&one);
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_inline_storage();
+    CSH_test_inline_overlay();
+    CSH_test_concat();
+    CSH_test_create_alloc_failure();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,140 @@
+#include "CSHTest.h"
+#include "CSHStringSearcher.h"
+
+static size_t CSH_test_naive_find(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize)
+{
+    if (in_needleSize > in_haystackSize)
+    {
+        return CSH_STRING_NPOS;
+    }
+    for (size_t i = 0; (i + in_needleSize) <= in_haystackSize; i++)
+    {
+        if (memcmp(in_haystack + i, in_needle, in_needleSize) == 0)
+        {
+            return i;
+        }
+    }
+    return CSH_STRING_NPOS;
+}
+
+static size_t CSH_test_naive_rfind(const char* in_haystack, size_t in_haystackSize, const char* in_needle, size_t in_needleSize)
+{
+    if (in_needleSize > in_haystackSize)
+    {
+        return CSH_STRING_NPOS;
+    }
+    for (size_t i = (in_haystackSize - in_needleSize + 1); i > 0; i--)
+    {
+        if (memcmp(in_haystack + i - 1, in_needle, in_needleSize) == 0)
+        {
+            return (i - 1);
+        }
+    }
+    return CSH_STRING_NPOS;
+}
+
+// Searchers agree with a naive search, for needles on both sides of CSH_SEARCHER_HORSPOOL_MIN_SIZE_M.
+static void CSH_test_searcher_random(void)
+{
+    static const char alphabet[] = "aXb /";
+    srand(3);
+    for (size_t round = 0; round < 20000; round++)
+    {
+        size_t haystackSize = (size_t)(rand() % 400);
+        size_t alphabetSize = (size_t)(2 + (rand() % 4));
+        char* haystack = malloc(haystackSize + 1);
+        for (size_t i = 0; i < haystackSize; i++)
+        {
+            haystack[i] = alphabet[rand() % alphabetSize];
+        }
+
+        // Half of the needles are taken from the haystack, so long needles match too.
+        size_t needleSize = (size_t)(rand() % 100);
+        char* needle = malloc(needleSize + 1);
+        if (haystackSize > needleSize && (rand() % 2) == 0)
+        {
+            memcpy(needle, haystack + (rand() % (haystackSize - needleSize)), needleSize);
+        }
+        else
+        {
+            for (size_t i = 0; i < needleSize; i++)
+            {
+                needle[i] = alphabet[rand() % alphabetSize];
+            }
+        }
+
+        S_CSHStringSearcher searcher;
+        CSH_TEST_CHECK_MF(CSH_searcher_init(&searcher, CSH_string_view_buffer(needle, needleSize), NULL) == CSHSSC_NONE);
+        S_CSHStringView view = CSH_string_view_buffer(haystack, haystackSize);
+        size_t pos = (haystackSize != 0) ? (size_t)(rand() % haystackSize) : 0;
+
+        size_t expectFind = CSH_STRING_NPOS;
+        size_t expectRfind = CSH_STRING_NPOS;
+        if (pos < haystackSize)
+        {
+            expectFind = CSH_test_naive_find(haystack + pos, haystackSize - pos, needle, needleSize);
+            expectFind = (expectFind != CSH_STRING_NPOS) ? (expectFind + pos) : CSH_STRING_NPOS;
+            expectRfind = CSH_test_naive_rfind(haystack + pos, haystackSize - pos, needle, needleSize);
+            expectRfind = (expectRfind != CSH_STRING_NPOS) ? (expectRfind + pos) : CSH_STRING_NPOS;
+        }
+        CSH_TEST_CHECK_MF(CSH_searcher_find(&searcher, view, pos) == expectFind);
+        CSH_TEST_CHECK_MF(CSH_searcher_rfind(&searcher, view, pos) == expectRfind);
+
+        size_t expectCount = 0;
+        for (size_t offset = 0; needleSize != 0 && offset < haystackSize; expectCount++)
+        {
+            size_t found = CSH_test_naive_find(haystack + offset, haystackSize - offset, needle, needleSize);
+            if (found == CSH_STRING_NPOS)
+            {
+                break;
+            }
+            offset += (found + needleSize);
+        }
+        CSH_TEST_CHECK_MF(CSH_searcher_count(&searcher, view) == expectCount);
+
+        CSH_searcher_free(&searcher);
+        free(haystack);
+        free(needle);
+    }
+}
+
+// The searcher keeps its own copy of the needle, allocated with its allocator.
+static void CSH_test_searcher_needle(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+
+    char needle[] = "needle";
+    S_CSHStringSearcher searcher;
+    CSH_TEST_CHECK_MF(CSH_searcher_init(&searcher, CSH_string_view_cstr(needle, 100), &allocator) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(state.m_liveBytes != 0);
+    memset(needle, 'x', 6);
+
+    S_CSHStringView text = CSH_string_view_cstr("a needle in a haystack, another needle", 100);
+    CSH_TEST_CHECK_MF(CSH_searcher_find(&searcher, text, 0) == 2);
+    CSH_TEST_CHECK_MF(CSH_searcher_rfind(&searcher, text, 0) == 32);
+    CSH_TEST_CHECK_MF(CSH_searcher_count(&searcher, text) == 2);
+    CSH_TEST_CHECK_MF(CSH_searcher_find(&searcher, CSH_STRING_VIEW_DEFAULT_M, 0) == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_searcher_count(&searcher, CSH_STRING_VIEW_DEFAULT_M) == 0);
+    CSH_searcher_free(&searcher);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+
+    // An empty needle matches everywhere, but is never counted.
+    CSH_TEST_CHECK_MF(CSH_searcher_init(&searcher, CSH_string_view_buffer("", 0), &allocator) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_searcher_find(&searcher, text, 3) == 3);
+    CSH_TEST_CHECK_MF(CSH_searcher_count(&searcher, text) == 0);
+    CSH_searcher_free(&searcher);
+
+    CSH_TEST_CHECK_MF(CSH_searcher_init(&searcher, CSH_STRING_VIEW_DEFAULT_M, &allocator) == CSHSSC_BAD_INPUT_STR);
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(CSH_searcher_init(&searcher, CSH_string_view_cstr("needle", 100), &allocator) == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_searcher_random();
+    CSH_test_searcher_needle();
+
+    return CSH_test_result(__FILE__);
+}
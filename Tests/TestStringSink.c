@@ -0,0 +1,137 @@
+#define _POSIX_C_SOURCE 200809L
+#include "CSHTest.h"
+#include "CSHStringSink.h"
+
+static const char CSH_test_path[] = "TestStringSink.tmp";
+
+static uint64_t CSH_test_seed = 7;
+
+static uint64_t CSH_test_random(void)
+{
+    CSH_test_seed ^= CSH_test_seed << 13;
+    CSH_test_seed ^= CSH_test_seed >> 7;
+    CSH_test_seed ^= CSH_test_seed << 17;
+    return CSH_test_seed;
+}
+
+// Random small and large writes of every kind, with the memory of copied writes overwritten straight after,
+// and referenced writes kept until an explicit flush, write the same bytes to the file in order.
+static void CSH_test_sink_random(void)
+{
+    static char expected[8 * 1024 * 1024];
+    static char written[8 * 1024 * 1024 + 1];
+    static char* references[4096];
+    size_t bufferSizes[] = {0, 16, 1000, 4096};
+    for (size_t b = 0; b < (sizeof(bufferSizes) / sizeof(bufferSizes[0])); b++)
+    {
+        S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+        S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+        FILE* file = fopen(CSH_test_path, "wb");
+        S_CSHStringSink sink;
+        CSH_TEST_CHECK_MF(file != NULL && CSH_sink_init(&sink, fileno(file), bufferSizes[b], &allocator) == CSHSSC_NONE);
+
+        size_t expectedSize = 0;
+        size_t referenceCount = 0;
+        size_t failures = 0;
+        for (size_t i = 0; i < 1000; i++)
+        {
+            size_t size = ((CSH_test_random() % 8) == 0) ? (CSH_test_random() % 40000) : (CSH_test_random() % 200);
+            uint64_t kind = CSH_test_random() % 5;
+            // Cstrs must fit within m_maxCstrSize.
+            size = (kind == 2) ? (size % 2000) : size;
+            char* data = (char*)malloc(size + 1);
+            for (size_t k = 0; k < size; k++)
+            {
+                data[k] = (char)('a' + (CSH_test_random() % 26));
+            }
+            data[size] = '\0';
+            memcpy(expected + expectedSize, data, size);
+            expectedSize += size;
+
+            int8_t result = CSHSSC_NONE;
+            if (kind == 0)
+            {
+                result = CSH_sink_write(&sink, CSH_string_view_buffer(data, size));
+            }
+            else if (kind == 1)
+            {
+                S_CSHString str = CSH_STRING_DEFAULT_M;
+                CSH_string_splice(&str, 0, 0, data, size);
+                result = CSH_sink_write_string(&sink, &str);
+                CSH_string_free(&str);
+            }
+            else if (kind == 2)
+            {
+                result = CSH_sink_write_cstr(&sink, data);
+            }
+            else
+            {
+                result = CSH_sink_write_ref(&sink, CSH_string_view_buffer(data, size));
+                references[referenceCount++] = data;
+                data = NULL;
+            }
+            failures += (result == CSHSSC_NONE) ? 0 : 1;
+
+            if (data != NULL)
+            {
+                memset(data, '#', size);
+                free(data);
+            }
+            if (referenceCount == 4096 || (CSH_test_random() % 50) == 0)
+            {
+                failures += (CSH_sink_flush(&sink) == CSHSSC_NONE) ? 0 : 1;
+                for (size_t k = 0; k < referenceCount; k++)
+                {
+                    free(references[k]);
+                }
+                referenceCount = 0;
+            }
+        }
+        CSH_TEST_CHECK_MF(failures == 0);
+        CSH_TEST_CHECK_MF(CSH_sink_free(&sink) == CSHSSC_NONE && state.m_liveBytes == 0);
+        for (size_t k = 0; k < referenceCount; k++)
+        {
+            free(references[k]);
+        }
+        fclose(file);
+
+        file = fopen(CSH_test_path, "rb");
+        size_t writtenSize = fread(written, 1, sizeof(written), file);
+        fclose(file);
+        CSH_TEST_CHECK_MF(writtenSize == expectedSize && memcmp(written, expected, expectedSize) == 0);
+    }
+    remove(CSH_test_path);
+}
+
+// Empty and invalid writes, a cstr which doesn't fit, a failed buffer allocation and a failed flush.
+static void CSH_test_sink_edges(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHStringSink sink;
+
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(CSH_sink_init(&sink, -1, 0, &allocator) == CSHSSC_ALLOC_FAILED);
+    state.m_failAfter = SIZE_MAX;
+
+    CSH_TEST_CHECK_MF(CSH_sink_init(&sink, -1, 64, &allocator) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_sink_write(&sink, CSH_string_view_buffer("", 0)) == CSHSSC_NONE && sink.m_queuedSize == 0);
+    CSH_TEST_CHECK_MF(CSH_sink_write(&sink, CSH_STRING_VIEW_DEFAULT_M) == CSHSSC_BAD_INPUT_STR);
+    CSH_TEST_CHECK_MF(CSH_sink_write_cstr(&sink, NULL) == CSHSSC_BAD_INPUT_STR);
+    sink.m_maxCstrSize = 4;
+    CSH_TEST_CHECK_MF(CSH_sink_write_cstr(&sink, "abcd") == CSHSSC_CSTR_DOESNT_FIT && sink.m_queuedSize == 0);
+
+    // Nothing is written until the flush, which fails on the invalid descriptor and drops the output.
+    CSH_TEST_CHECK_MF(CSH_sink_write_cstr(&sink, "abc") == CSHSSC_NONE && sink.m_queuedSize == 3);
+    CSH_TEST_CHECK_MF(CSH_sink_flush(&sink) == CSHSSC_IO_FAILED && sink.m_queuedSize == 0);
+    CSH_TEST_CHECK_MF(CSH_sink_flush(&sink) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_sink_free(&sink) == CSHSSC_NONE && state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_sink_random();
+    CSH_test_sink_edges();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,139 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+
+static uint32_t CSH_test_seed = 7;
+
+static uint32_t CSH_test_random(void)
+{
+    CSH_test_seed ^= CSH_test_seed << 13;
+    CSH_test_seed ^= CSH_test_seed >> 17;
+    CSH_test_seed ^= CSH_test_seed << 5;
+    return CSH_test_seed;
+}
+
+// Random splices and erases agree with a plain buffer, with the inserted characters often taken from the string itself.
+// Each splice reallocates at most once.
+static void CSH_test_splice_random(void)
+{
+    static char model[8000];
+    static char source[8000];
+    size_t modelSize = 0;
+
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHString str = CSH_STRING_ALLOCATOR_M(&allocator);
+
+    for (size_t round = 0; round < 100000; round++)
+    {
+        if (modelSize > 3000)
+        {
+            CSH_string_erase(&str, 0, (modelSize / 2));
+            memmove(model, model + (modelSize / 2), modelSize - (modelSize / 2));
+            modelSize -= (modelSize / 2);
+        }
+
+        size_t pos = CSH_test_random() % (modelSize + 1);
+        size_t len = CSH_test_random() % 12;
+        uint32_t op = CSH_test_random() % 5;
+        char text[32];
+        size_t size = 0;
+        const char* from = text;
+        if (op < 2)
+        {
+            size = CSH_test_random() % 20;
+            for (size_t i = 0; i < size; i++)
+            {
+                text[i] = (char)('a' + (CSH_test_random() % 26));
+            }
+        }
+        else if (modelSize != 0)
+        {
+            size_t offset = CSH_test_random() % modelSize;
+            size = CSH_test_random() % (modelSize - offset + 1);
+            from = CSH_string_data(&str) + offset;
+        }
+        memcpy(source, from, size);
+
+        size_t allocCount = state.m_allocCount;
+        if (op == 4)
+        {
+            CSH_TEST_CHECK_MF(CSH_string_erase(&str, pos, len) == CSHSSC_NONE);
+            size = 0;
+        }
+        else
+        {
+            CSH_TEST_CHECK_MF(CSH_string_splice(&str, pos, len, from, size) == CSHSSC_NONE);
+        }
+        CSH_TEST_CHECK_MF(state.m_allocCount <= (allocCount + 1));
+
+        len = (len > (modelSize - pos)) ? (modelSize - pos) : len;
+        memmove(model + pos + size, model + pos + len, modelSize - pos - len);
+        memcpy(model + pos, source, size);
+        modelSize = modelSize - len + size;
+        CSH_TEST_CHECK_MF(str.m_size == modelSize && memcmp(CSH_string_data(&str), model, modelSize) == 0);
+        CSH_TEST_CHECK_MF(CSH_string_data(&str)[modelSize] == '\0');
+    }
+
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+// Insert, replace and erase, including a string inserted into itself, and positions past the end.
+static void CSH_test_insert_replace(void)
+{
+    S_CSHString str = CSH_STRING_DEFAULT_M;
+    CSH_TEST_CHECK_MF(CSH_string_replace_cstr(&str, 0, 0, "hello world") == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_string_replace_cstr(&str, 6, 5, "there, friend") == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_string_insert_cstr(&str, 0, ">> ") == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), ">> hello there, friend") == 0);
+
+    CSH_TEST_CHECK_MF(CSH_string_insert(&str, 3, &str) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), ">> >> hello there, friendhello there, friend") == 0);
+    CSH_TEST_CHECK_MF(CSH_string_replace(&str, 0, 100, &str) == CSHSSC_NONE && str.m_size == 44);
+
+    CSH_TEST_CHECK_MF(CSH_string_erase(&str, 2, 1000) == CSHSSC_NONE && strcmp(CSH_string_data(&str), ">>") == 0);
+    CSH_TEST_CHECK_MF(CSH_string_insert_cstr(&str, 3, "x") == CSHSSC_BAD_INPUT_ARG);
+    CSH_TEST_CHECK_MF(CSH_string_splice(&str, 0, 0, NULL, 1) == CSHSSC_BAD_INPUT_STR);
+    CSH_TEST_CHECK_MF(CSH_string_splice(&str, 2, 0, NULL, 0) == CSHSSC_NONE);
+
+    CSH_string_set_max_cstr_size(&str, 3);
+    CSH_TEST_CHECK_MF(CSH_string_insert_cstr(&str, 0, "abcd") == CSHSSC_CSTR_DOESNT_FIT);
+    CSH_TEST_CHECK_MF(CSH_string_replace_cstr(&str, 0, 1, "abcd") == CSHSSC_CSTR_DOESNT_FIT);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), ">>") == 0);
+
+    char array[8];
+    CSH_TEST_CHECK_MF(CSH_string_copy_arr(&str, array, sizeof(array), 1, 10) == CSHSSC_NONE && strcmp(array, ">") == 0);
+    CSH_string_free(&str);
+}
+
+// A splice which fails to grow leaves the string as it was.
+static void CSH_test_splice_alloc_failure(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_CSHString str = CSH_STRING_ALLOCATOR_M(&allocator);
+    CSH_string_assign_cstr(&str, "0123456789012345678901234567890123456789");
+    CSH_string_shrink_to_fit(&str);
+
+    state.m_failAfter = 0;
+    CSH_TEST_CHECK_MF(CSH_string_insert_cstr(&str, 5, "abc") == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(CSH_string_splice(&str, 0, 1, CSH_string_data(&str), 40) == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(strcmp(CSH_string_data(&str), "0123456789012345678901234567890123456789") == 0);
+
+    // Shrinking or same size splices never allocate.
+    CSH_TEST_CHECK_MF(CSH_string_replace_cstr(&str, 0, 3, "abc") == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_string_erase(&str, 3, 30) == CSHSSC_NONE && strcmp(CSH_string_data(&str), "abc3456789") == 0);
+
+    state.m_failAfter = SIZE_MAX;
+    CSH_string_free(&str);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_splice_random();
+    CSH_test_insert_replace();
+    CSH_test_splice_alloc_failure();
+
+    return CSH_test_result(__FILE__);
+}
@@ -0,0 +1,202 @@
+#include "CSHTest.h"
+#include "CSHStringTokenizer.h"
+#include "CSHStringKernels.h"
+
+static uint64_t CSH_test_seed = 1234567;
+
+static uint64_t CSH_test_random(void)
+{
+    CSH_test_seed ^= CSH_test_seed << 13;
+    CSH_test_seed ^= CSH_test_seed >> 7;
+    CSH_test_seed ^= CSH_test_seed << 17;
+    return CSH_test_seed;
+}
+
+// Splits the plain way, checking every position for a delimiter (or the separator when in_mode is CSHTM_SEPARATOR).
+static size_t CSH_test_naive_split(CSHConstCharPtr_t in_str, size_t in_size, CSHConstCharPtr_t in_delimiters, size_t in_delimitersSize, int8_t in_mode, bool in_skipEmpty, S_CSHStringSlice* out_slices)
+{
+    size_t count = 0;
+    size_t start = 0;
+    while (true)
+    {
+        size_t found = SIZE_MAX;
+        for (size_t i = start; i < in_size && found == SIZE_MAX; i++)
+        {
+            bool matches = (in_mode == CSHTM_SEPARATOR) ? ((i + in_delimitersSize) <= in_size && memcmp(in_str + i, in_delimiters, in_delimitersSize) == 0) : (memchr(in_delimiters, in_str[i], in_delimitersSize) != NULL);
+            found = matches ? i : SIZE_MAX;
+        }
+        size_t end = (found == SIZE_MAX) ? in_size : found;
+        if (!in_skipEmpty || end != start)
+        {
+            out_slices[count].m_offset = start;
+            out_slices[count].m_size = end - start;
+            count++;
+        }
+        if (found == SIZE_MAX)
+        {
+            return count;
+        }
+        start = found + ((in_mode == CSHTM_SEPARATOR) ? in_delimitersSize : 1);
+    }
+}
+
+// Random text split on a character, a set and a separator, with and without skipping empty tokens,
+// one token at a time and in bulk into a vector, agrees with the naive split.
+static void CSH_test_tokenizer_random(void)
+{
+    static S_CSHStringSlice expected[3000];
+    static S_CSHStringSlice slices[3000];
+    static char buffer[3000];
+    static const char alphabet[] = "ab,;: \t\n";
+
+    size_t failures = 0;
+    for (size_t round = 0; round < 10000; round++)
+    {
+        size_t size = CSH_test_random() % ((round < 1000) ? 40 : 2500);
+        for (size_t i = 0; i < size; i++)
+        {
+            buffer[i] = alphabet[CSH_test_random() % (2 + (CSH_test_random() % 7))];
+        }
+
+        char delimiters[20];
+        size_t delimitersSize = 1;
+        int8_t mode = (int8_t)(CSH_test_random() % 3);
+        if (mode == CSHTM_CHAR)
+        {
+            delimiters[0] = alphabet[2 + (CSH_test_random() % 6)];
+        }
+        else if (mode == CSHTM_SET)
+        {
+            delimitersSize = 1 + (CSH_test_random() % 12);
+            for (size_t i = 0; i < delimitersSize; i++)
+            {
+                delimiters[i] = (i < 6) ? alphabet[2 + (CSH_test_random() % 6)] : (char)('c' + i);
+            }
+        }
+        else
+        {
+            delimitersSize = 1 + (CSH_test_random() % 3);
+            for (size_t i = 0; i < delimitersSize; i++)
+            {
+                delimiters[i] = alphabet[CSH_test_random() % 8];
+            }
+        }
+        bool skipEmpty = ((CSH_test_random() & 1) != 0);
+        size_t expectedCount = CSH_test_naive_split(buffer, size, delimiters, delimitersSize, mode, skipEmpty, expected);
+
+        S_CSHTokenizer tokenizer;
+        S_CSHStringView view = CSH_string_view_buffer(buffer, size);
+        S_CSHStringView delimitersView = CSH_string_view_buffer(delimiters, delimitersSize);
+        int8_t result = (mode == CSHTM_CHAR) ? CSH_tokenizer_init_char(&tokenizer, view, delimiters[0]) :
+            ((mode == CSHTM_SET) ? CSH_tokenizer_init_set(&tokenizer, view, delimitersView) : CSH_tokenizer_init_separator(&tokenizer, view, delimitersView));
+        tokenizer.m_skipEmpty = skipEmpty;
+        S_CSHTokenizer copy = tokenizer;
+
+        size_t count = 0;
+        while (count < 3000 && CSH_tokenizer_next(&copy, &slices[count]))
+        {
+            count++;
+        }
+        bool passed = (result == CSHSSC_NONE && count == expectedCount && memcmp(slices, expected, count * sizeof(S_CSHStringSlice)) == 0);
+
+        S_VecData_CSHStringSlice vec = G_VEC_DATA_DEFAULT_M(CSHStringSlice);
+        passed = passed && (CSH_tokenizer_fill_vec(&tokenizer, &vec) == CSHSSC_NONE && vec.m_size == expectedCount);
+        passed = passed && (expectedCount == 0 || memcmp(vec.m_data, expected, expectedCount * sizeof(S_CSHStringSlice)) == 0);
+        vec_clear_CSHStringSlice(&vec);
+        failures += passed ? 0 : 1;
+    }
+    CSH_TEST_CHECK_MF(failures == 0);
+}
+
+// CSH_kernel_find_any agrees with a naive search, including characters above 127 and sets too big for the SIMD path.
+static void CSH_test_find_any(void)
+{
+    char buffer[100];
+    char delimiters[40];
+    size_t failures = 0;
+    for (size_t round = 0; round < 200000; round++)
+    {
+        size_t size = CSH_test_random() % 100;
+        for (size_t i = 0; i < size; i++)
+        {
+            buffer[i] = (char)(CSH_test_random() % 256);
+        }
+        size_t delimitersSize = CSH_test_random() % 40;
+        for (size_t i = 0; i < delimitersSize; i++)
+        {
+            delimiters[i] = (char)(CSH_test_random() % 256);
+        }
+        size_t expected = SIZE_MAX;
+        for (size_t i = 0; i < size && expected == SIZE_MAX; i++)
+        {
+            expected = (delimitersSize != 0 && memchr(delimiters, buffer[i], delimitersSize) != NULL) ? i : SIZE_MAX;
+        }
+        failures += (CSH_kernel_find_any(buffer, size, delimiters, delimitersSize) == expected) ? 0 : 1;
+    }
+    CSH_TEST_CHECK_MF(failures == 0);
+}
+
+// Empty views and tokens, bad delimiters, the fixed size fill, and tokenizing a string's own characters.
+static void CSH_test_tokenizer_edges(void)
+{
+    S_CSHTokenizer tokenizer;
+    S_CSHStringSlice slices[4];
+    CSH_TEST_CHECK_MF(CSH_tokenizer_init_char(&tokenizer, CSH_string_view_buffer("", 0), ',') == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_tokenizer_fill(&tokenizer, slices, 4) == 1 && slices[0].m_size == 0);
+    CSH_TEST_CHECK_MF(!CSH_tokenizer_next(&tokenizer, &slices[0]));
+    CSH_tokenizer_init_char(&tokenizer, CSH_string_view_buffer("", 0), ',');
+    tokenizer.m_skipEmpty = true;
+    CSH_TEST_CHECK_MF(!CSH_tokenizer_next(&tokenizer, &slices[0]));
+
+    CSH_TEST_CHECK_MF(CSH_tokenizer_init_char(&tokenizer, CSH_STRING_VIEW_DEFAULT_M, ',') == CSHSSC_BAD_INPUT_STR);
+    CSH_TEST_CHECK_MF(CSH_tokenizer_init_set(&tokenizer, CSH_string_view_buffer("a", 1), CSH_string_view_buffer("", 0)) == CSHSSC_BAD_INPUT_ARG);
+    CSH_TEST_CHECK_MF(CSH_tokenizer_init_separator(&tokenizer, CSH_string_view_buffer("a", 1), CSH_STRING_VIEW_DEFAULT_M) == CSHSSC_BAD_INPUT_ARG);
+
+    // A fill which stops at in_maxCount carries on from there.
+    CSH_tokenizer_init_separator(&tokenizer, CSH_string_view_cstr("a, b, , c, d, e", 100), CSH_string_view_buffer(", ", 2));
+    CSH_TEST_CHECK_MF(CSH_tokenizer_fill(&tokenizer, slices, 4) == 4 && slices[2].m_size == 0 && slices[3].m_offset == 8);
+    CSH_TEST_CHECK_MF(CSH_tokenizer_fill(&tokenizer, slices, 4) == 2 && tokenizer.m_done);
+
+    S_CSHString str = CSH_string_create_cstr("key=value=more", 100);
+    CSH_tokenizer_init_char(&tokenizer, CSH_string_view(&str), '=');
+    CSH_TEST_CHECK_MF(CSH_tokenizer_next(&tokenizer, &slices[0]) && CSH_tokenizer_next(&tokenizer, &slices[1]));
+    S_CSHStringView token = CSH_tokenizer_view(&tokenizer, slices[1]);
+    CSH_TEST_CHECK_MF(token.m_strPtr == (CSH_string_data(&str) + 4) && token.m_size == 5);
+    CSH_string_free(&str);
+}
+
+// A vector which can't grow keeps the tokens which fit, and the rest can still be read once it can.
+static void CSH_test_fill_vec_alloc_failure(void)
+{
+    S_CSHTestAllocator state = CSH_TEST_ALLOCATOR_DEFAULT_M;
+    S_CSHAllocator allocator = CSH_TEST_ALLOCATOR_M(&state);
+    S_VecData_CSHStringSlice vec = G_VEC_DATA_ALLOCATOR_M(CSHStringSlice, &allocator);
+
+    static char buffer[2000];
+    for (size_t i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = ((i % 4) == 3) ? ',' : 'x';
+    }
+    S_CSHTokenizer tokenizer;
+    CSH_tokenizer_init_char(&tokenizer, CSH_string_view_buffer(buffer, sizeof(buffer)), ',');
+
+    state.m_failAfter = 2;
+    CSH_TEST_CHECK_MF(CSH_tokenizer_fill_vec(&tokenizer, &vec) == CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(vec.m_size > 0 && vec.m_size == vec.m_capacity && !tokenizer.m_done);
+    state.m_failAfter = SIZE_MAX;
+    CSH_TEST_CHECK_MF(CSH_tokenizer_fill_vec(&tokenizer, &vec) == CSHSSC_NONE && vec.m_size == 501);
+    CSH_TEST_CHECK_MF(vec.m_data[500].m_offset == 2000 && vec.m_data[500].m_size == 0 && vec.m_data[250].m_offset == 1000);
+
+    vec_clear_CSHStringSlice(&vec);
+    CSH_TEST_CHECK_MF(state.m_liveBytes == 0);
+}
+
+int main(void)
+{
+    CSH_test_tokenizer_random();
+    CSH_test_find_any();
+    CSH_test_tokenizer_edges();
+    CSH_test_fill_vec_alloc_failure();
+
+    return CSH_test_result(__FILE__);
+}
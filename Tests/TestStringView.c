@@ -0,0 +1,97 @@
+#include "CSHTest.h"
+#include "CSHString.h"
+
+// Views point into what they view, without copying it.
+static void CSH_test_view_creation(void)
+{
+    S_CSHString str = CSH_string_create_cstr("hello, world", 100);
+    S_CSHStringView view = CSH_string_view(&str);
+    CSH_TEST_CHECK_MF(view.m_strPtr == CSH_string_data(&str) && view.m_size == 12);
+
+    // A string which has never allocated has an empty view, an error string has an invalid one.
+    S_CSHString empty = CSH_STRING_DEFAULT_M;
+    view = CSH_string_view(&empty);
+    CSH_TEST_CHECK_MF(view.m_strPtr != NULL && view.m_size == 0);
+    S_CSHString error = CSH_STRING_ERROR_M(CSHSSC_ALLOC_FAILED);
+    CSH_TEST_CHECK_MF(CSH_string_view(&error).m_strPtr == NULL);
+    CSH_TEST_CHECK_MF(CSH_string_view(NULL).m_strPtr == NULL);
+
+    view = CSH_string_view_cstr("abcdef", 6);
+    CSH_TEST_CHECK_MF(view.m_strPtr != NULL && view.m_size == 6);
+    CSH_TEST_CHECK_MF(CSH_string_view_cstr("abcdef", 5).m_strPtr == NULL);
+    CSH_TEST_CHECK_MF(CSH_string_view_cstr(NULL, 5).m_strPtr == NULL);
+
+    // Buffers can hold null characters.
+    view = CSH_string_view_buffer("a\0b", 3);
+    CSH_TEST_CHECK_MF(view.m_size == 3 && CSH_string_view_find(view, 0, CSH_string_view_buffer("b", 1)) == 2);
+    CSH_TEST_CHECK_MF(CSH_string_view_buffer(NULL, 3).m_strPtr == NULL);
+
+    S_CSHString copy = CSH_string_create_view(view);
+    CSH_TEST_CHECK_MF(copy.m_size == 3 && memcmp(CSH_string_data(&copy), "a\0b", 4) == 0);
+    CSH_string_free(&copy);
+
+    CSH_string_free(&str);
+}
+
+// Substrings are clamped to the end, and out of range positions give an invalid view.
+static void CSH_test_view_substr(void)
+{
+    S_CSHString str = CSH_string_create_cstr("hello, world", 100);
+
+    S_CSHStringView sub = CSH_string_substr_view(&str, 7, 100);
+    CSH_TEST_CHECK_MF(sub.m_strPtr == (CSH_string_data(&str) + 7) && sub.m_size == 5);
+    sub = CSH_string_view_substr(sub, 1, 3);
+    CSH_TEST_CHECK_MF(CSH_string_view_compare(sub, CSH_string_view_cstr("orl", 10)) == CSHSSC_NONE);
+
+    sub = CSH_string_substr_view(&str, 12, 5);
+    CSH_TEST_CHECK_MF(sub.m_strPtr != NULL && sub.m_size == 0);
+    CSH_TEST_CHECK_MF(CSH_string_substr_view(&str, 13, 1).m_strPtr == NULL);
+    CSH_TEST_CHECK_MF(CSH_string_view_substr(CSH_STRING_VIEW_DEFAULT_M, 0, 1).m_strPtr == NULL);
+
+    CSH_string_free(&str);
+}
+
+// Searching and comparing use the views' sizes, and handle empty and invalid views.
+static void CSH_test_view_search_compare(void)
+{
+    S_CSHStringView text = CSH_string_view_cstr("abcabcabc", 100);
+    S_CSHStringView needle = CSH_string_view_cstr("bca", 100);
+    S_CSHStringView empty = CSH_string_view_buffer("", 0);
+
+    CSH_TEST_CHECK_MF(CSH_string_view_find(text, 0, needle) == 1);
+    CSH_TEST_CHECK_MF(CSH_string_view_find(text, 2, needle) == 4);
+    CSH_TEST_CHECK_MF(CSH_string_view_find(text, 5, needle) == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_view_rfind(text, 0, needle) == 4);
+    CSH_TEST_CHECK_MF(CSH_string_view_find(text, 0, empty) == 0);
+    CSH_TEST_CHECK_MF(CSH_string_view_find(empty, 0, needle) == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_view_find(text, 0, CSH_STRING_VIEW_DEFAULT_M) == CSH_STRING_NPOS);
+    CSH_TEST_CHECK_MF(CSH_string_view_rfind(CSH_STRING_VIEW_DEFAULT_M, 0, needle) == CSH_STRING_NPOS);
+
+    // The needle is only matched within the view, not past its end.
+    S_CSHStringView prefix = CSH_string_view_substr(text, 0, 3);
+    CSH_TEST_CHECK_MF(CSH_string_view_find(prefix, 0, needle) == CSH_STRING_NPOS);
+
+    CSH_TEST_CHECK_MF(CSH_string_view_compare(prefix, CSH_string_view_cstr("abc", 10)) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_string_view_compare(prefix, text) == CSHSSC_BAD_INPUT_ARG);
+    CSH_TEST_CHECK_MF(CSH_string_view_compare(empty, CSH_string_view_buffer("x", 0)) == CSHSSC_NONE);
+    CSH_TEST_CHECK_MF(CSH_string_view_compare(empty, CSH_STRING_VIEW_DEFAULT_M) == CSHSSC_BAD_INPUT_STR);
+
+    CSH_TEST_CHECK_MF(CSH_string_view_cmp(prefix, text) < 0 && CSH_string_view_cmp(text, prefix) > 0);
+    CSH_TEST_CHECK_MF(CSH_string_view_cmp(needle, text) > 0 && CSH_string_view_cmp(prefix, prefix) == 0);
+    CSH_TEST_CHECK_MF(CSH_string_view_cmp(empty, prefix) < 0);
+    CSH_TEST_CHECK_MF(CSH_string_view_cmp(CSH_STRING_VIEW_DEFAULT_M, empty) < 0);
+
+    S_CSHString str = CSH_string_create_cstr("abc", 100);
+    CSH_TEST_CHECK_MF(CSH_string_view_hash(prefix) == CSH_string_hash(&str));
+    CSH_TEST_CHECK_MF(CSH_string_view_hash(prefix) != CSH_string_view_hash(needle));
+    CSH_string_free(&str);
+}
+
+int main(void)
+{
+    CSH_test_view_creation();
+    CSH_test_view_substr();
+    CSH_test_view_search_compare();
+
+    return CSH_test_result(__FILE__);
+}